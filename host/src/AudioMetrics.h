@@ -0,0 +1,185 @@
+// Offline measurements for host renders of the shared DSP.
+//
+//   Peak              largest absolute sample
+//   Rt60              reverb time from the Schroeder energy decay curve
+//   SpectralCentroid  power-weighted mean frequency over the whole render
+//   SnrDb             reference-to-difference energy of a render vs a reference
+//   LogSpectralDistance  mean per-frame RMS dB difference between two spectra
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <complex>
+#include <vector>
+
+namespace daisybed
+{
+inline float Peak(const float *x, size_t n)
+{
+    float peak = 0.f;
+    for(size_t i = 0; i < n; i++)
+        peak = fabsf(x[i]) > peak ? fabsf(x[i]) : peak;
+    return peak;
+}
+
+// RT60 of an impulse response in seconds. Integrates the energy backwards
+// (Schroeder) and times the -5 dB to -35 dB span (T30, doubled). When the
+// render is too short to fall 35 dB it falls back to T20 (-5..-25 dB,
+// tripled). Returns a negative value if even that isn't reached.
+inline float Rt60(const float *ir, size_t n, float sample_rate)
+{
+    std::vector<double> edc(n + 1, 0.0);
+    for(size_t i = n; i-- > 0;)
+        edc[i] = edc[i + 1] + (double)ir[i] * ir[i];
+    if(edc[0] <= 0.0)
+        return -1.f;
+
+    auto crossing = [&](double db) -> double {
+        double threshold = edc[0] * pow(10.0, db / 10.0);
+        for(size_t i = 0; i < n; i++)
+            if(edc[i] <= threshold)
+                return (double)i / sample_rate;
+        return -1.0;
+    };
+    double t5 = crossing(-5.0);
+    double t35 = crossing(-35.0);
+    if(t5 >= 0.0 && t35 > t5)
+        return (float)(2.0 * (t35 - t5));
+    double t25 = crossing(-25.0);
+    if(t5 >= 0.0 && t25 > t5)
+        return (float)(3.0 * (t25 - t5));
+    return -1.f;
+}
+
+// In-place radix-2 FFT; `x.size()` must be a power of two.
+inline void Fft(std::vector<std::complex<float>> &x)
+{
+    const size_t n = x.size();
+    for(size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for(; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if(i < j)
+            std::swap(x[i], x[j]);
+    }
+    for(size_t len = 2; len <= n; len <<= 1)
+    {
+        const float               angle = -2.f * (float)M_PI / (float)len;
+        const std::complex<float> step(cosf(angle), sinf(angle));
+        for(size_t start = 0; start < n; start += len)
+        {
+            std::complex<float> w(1.f, 0.f);
+            for(size_t k = 0; k < len / 2; k++)
+            {
+                std::complex<float> even = x[start + k];
+                std::complex<float> odd  = x[start + k + len / 2] * w;
+                x[start + k]             = even + odd;
+                x[start + k + len / 2]   = even - odd;
+                w *= step;
+            }
+        }
+    }
+}
+
+// Centroid in Hz of the power spectrum summed over Hann-windowed frames of
+// `frame` samples (a power of two) with 50% overlap. 0 for silence.
+inline float SpectralCentroid(const float *x,
+                              size_t       n,
+                              float        sample_rate,
+                              size_t       frame = 4096)
+{
+    std::vector<double>              power(frame / 2 + 1, 0.0);
+    std::vector<std::complex<float>> bins(frame);
+    for(size_t start = 0; start + frame <= n; start += frame / 2)
+    {
+        for(size_t i = 0; i < frame; i++)
+        {
+            float hann = 0.5f - 0.5f * cosf(2.f * (float)M_PI * i / (frame - 1));
+            bins[i]    = std::complex<float>(x[start + i] * hann, 0.f);
+        }
+        Fft(bins);
+        for(size_t k = 0; k <= frame / 2; k++)
+            power[k] += std::norm(bins[k]);
+    }
+    double weighted = 0.0, total = 0.0;
+    for(size_t k = 0; k <= frame / 2; k++)
+    {
+        weighted += power[k] * k * sample_rate / frame;
+        total += power[k];
+    }
+    return total > 0.0 ? (float)(weighted / total) : 0.f;
+}
+
+// Signal-to-noise ratio of `x` against `reference`, taking their difference
+// as the noise. Infinite when they're identical.
+inline double SnrDb(const float *reference, const float *x, size_t n)
+{
+    double signal = 0.0, noise = 0.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        double d = (double)x[i] - reference[i];
+        signal += (double)reference[i] * reference[i];
+        noise += d * d;
+    }
+    if(noise == 0.0)
+        return INFINITY;
+    return 10.0 * log10(signal / noise);
+}
+
+// Log-spectral distance in dB: per Hann-windowed frame (50% overlap), the RMS
+// over bins of the dB difference between the two power spectra, averaged
+// over frames. Bins more than 90 dB below the reference's loudest bin are
+// floored there, so near-silent tails and noise-floor hash don't dominate.
+inline double LogSpectralDistance(const float *reference,
+                                  const float *x,
+                                  size_t       n,
+                                  size_t       frame = 1024)
+{
+    const size_t                     bins = frame / 2 + 1;
+    std::vector<std::complex<float>> a(frame), b(frame);
+    std::vector<float>               hann(frame);
+    for(size_t i = 0; i < frame; i++)
+        hann[i] = 0.5f - 0.5f * cosf(2.f * (float)M_PI * i / (frame - 1));
+
+    // Two passes: the floor needs the loudest reference bin first.
+    std::vector<double> power_a, power_b;
+    double              loudest = 0.0;
+    for(size_t start = 0; start + frame <= n; start += frame / 2)
+    {
+        for(size_t i = 0; i < frame; i++)
+        {
+            a[i] = std::complex<float>(reference[start + i] * hann[i], 0.f);
+            b[i] = std::complex<float>(x[start + i] * hann[i], 0.f);
+        }
+        Fft(a);
+        Fft(b);
+        for(size_t k = 0; k < bins; k++)
+        {
+            power_a.push_back(std::norm(a[k]));
+            power_b.push_back(std::norm(b[k]));
+            loudest = power_a.back() > loudest ? power_a.back() : loudest;
+        }
+    }
+    const size_t frames = power_a.size() / bins;
+    if(frames == 0)
+        return 0.0;
+
+    const double floor = loudest > 0.0 ? loudest * 1e-9 : 1e-30;
+    double       total = 0.0;
+    for(size_t f = 0; f < frames; f++)
+    {
+        double sum = 0.0;
+        for(size_t k = 0; k < bins; k++)
+        {
+            double pa = power_a[f * bins + k], pb = power_b[f * bins + k];
+            double d  = 10.0 * log10((pa > floor ? pa : floor) / (pb > floor ? pb : floor));
+            sum += d * d;
+        }
+        total += sqrt(sum / bins);
+    }
+    return total / frames;
+}
+
+} // namespace daisybed
@@ -0,0 +1,132 @@
+// Breakpoint automation for the host renderers, loaded from a text file:
+//
+//   # seconds  control  value
+//   0          size     0.3
+//   120        size     0.9     <- ramps linearly from 0.3 over two minutes
+//   60         mix      0.5
+//
+// Controls are named by the tool (e.g. "size", "cv5"). A control holds its
+// first value before its first point and its last value after the last one;
+// a control without points keeps its default. Points may come in any order.
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace daisybed
+{
+class ControlCurves
+{
+  public:
+    // `names[i]` is the name of control i; `defaults[i]` its value when the
+    // file never mentions it.
+    void Init(const char *const *names, const float *defaults, size_t count)
+    {
+        names_.assign(names, names + count);
+        curves_.assign(count, Curve());
+        for(size_t i = 0; i < count; i++)
+            curves_[i].fallback = defaults[i];
+    }
+
+    // False (with a message on stderr) on a missing file or a bad line.
+    bool Load(const char *path)
+    {
+        FILE *file = fopen(path, "r");
+        if(!file)
+        {
+            fprintf(stderr, "%s: can't open\n", path);
+            return false;
+        }
+        char line[256];
+        int  line_number = 0;
+        bool ok          = true;
+        while(ok && fgets(line, sizeof(line), file))
+        {
+            line_number++;
+            char *comment = strchr(line, '#');
+            if(comment)
+                *comment = '\0';
+            char  name[64];
+            float seconds, value;
+            int   fields = sscanf(line, "%f %63s %f", &seconds, name, &value);
+            if(fields <= 0)
+                continue; // blank or comment-only
+            int index = Find(name);
+            if(fields != 3 || index < 0 || seconds < 0.f)
+            {
+                fprintf(stderr, "%s:%d: expected '<seconds> <control> <value>'", path, line_number);
+                if(fields == 3 && index < 0)
+                    fprintf(stderr, ", unknown control '%s'", name);
+                fprintf(stderr, "\n");
+                ok = false;
+                break;
+            }
+            curves_[index].points.push_back({seconds, value});
+        }
+        fclose(file);
+        for(Curve &curve : curves_)
+        {
+            std::stable_sort(curve.points.begin(),
+                             curve.points.end(),
+                             [](const Point &a, const Point &b) {
+                                 return a.seconds < b.seconds;
+                             });
+            curve.cursor = 0;
+        }
+        return ok;
+    }
+
+    // Value of control `index` at `seconds`. Meant for a render that walks
+    // forward in time: each curve keeps a cursor, so a call is O(1)
+    // amortised. Going backwards restarts the search.
+    float Value(size_t index, float seconds)
+    {
+        Curve &curve = curves_[index];
+        const std::vector<Point> &p = curve.points;
+        if(p.empty())
+            return curve.fallback;
+        if(seconds <= p.front().seconds)
+            return p.front().value;
+        if(seconds >= p.back().seconds)
+            return p.back().value;
+        if(p[curve.cursor].seconds > seconds)
+            curve.cursor = 0;
+        while(p[curve.cursor + 1].seconds < seconds)
+            curve.cursor++;
+        const Point &a = p[curve.cursor];
+        const Point &b = p[curve.cursor + 1];
+        float span = b.seconds - a.seconds;
+        if(span <= 0.f)
+            return b.value;
+        return a.value + (b.value - a.value) * (seconds - a.seconds) / span;
+    }
+
+  private:
+    struct Point
+    {
+        float seconds;
+        float value;
+    };
+    struct Curve
+    {
+        std::vector<Point> points;
+        size_t             cursor   = 0;
+        float              fallback = 0.f;
+    };
+
+    int Find(const char *name) const
+    {
+        for(size_t i = 0; i < names_.size(); i++)
+            if(names_[i] == name)
+                return (int)i;
+        return -1;
+    }
+
+    std::vector<std::string> names_;
+    std::vector<Curve>       curves_;
+};
+
+} // namespace daisybed
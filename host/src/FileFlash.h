@@ -0,0 +1,181 @@
+// PresetStore flash backed by a file, for the host tools: NOR semantics (an
+// erase sets a sector to 0xFF, a program can only clear bits), a simulated
+// duration for every operation, per-sector erase counts, and power cuts.
+//
+// An erase runs in the background as on the chip: StartErase() takes a
+// command's time and leaves the chip busy for kEraseUs more, which only
+// passes in Wait() (the caller's time between polls). IsBusy() is one
+// status read. A program or read while the chip is busy fails, and counts
+// as an error (BusyErrors()), since the real chip would ignore it.
+//
+// The whole image is held in memory and written through to the file after
+// every operation, so closing and reopening the file is a reboot. CutPower()
+// tears the nth operation from now -- an erase stops halfway through the
+// sector, a program after half the page -- and fails everything after it
+// until the file is opened again.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace daisybed
+{
+class FileFlash
+{
+  public:
+    static constexpr size_t kSectorSize = 4096;
+    static constexpr size_t kPageSize   = 256;
+
+    // Roughly the QSPI chip's typical times.
+    static constexpr uint32_t kEraseUs   = 45000;
+    static constexpr uint32_t kProgramUs = 800;
+    static constexpr uint32_t kReadUs    = 1;
+    static constexpr uint32_t kCommandUs = 5; // an erase command or status read
+
+    ~FileFlash() { Close(); }
+
+    // Opens (or creates, blank) an image of `sectors` sectors.
+    bool Open(const char *path, size_t sectors)
+    {
+        Close();
+        image_.assign(sectors * kSectorSize, 0xFF);
+        if(erases_.size() != sectors) // kept across reboots
+            erases_.assign(sectors, 0);
+        file_ = fopen(path, "r+b");
+        if(file_)
+        {
+            size_t read = fread(image_.data(), 1, image_.size(), file_);
+            (void)read; // a short file reads as blank beyond its end
+        }
+        else
+        {
+            file_ = fopen(path, "w+b");
+            if(!file_)
+                return false;
+        }
+        cut_after_ = 0;
+        powered_   = true;
+        busy_us_   = 0;
+        return Flush(0, image_.size());
+    }
+
+    void Close()
+    {
+        if(file_)
+            fclose(file_);
+        file_ = nullptr;
+    }
+
+    // The sector reads as erased at once; nothing may look before IsBusy()
+    // says it is done.
+    bool StartErase(uint32_t address)
+    {
+        if(address % kSectorSize != 0 || address + kSectorSize > image_.size()
+           || Busy())
+            return false;
+        size_t size = kSectorSize;
+        if(!Operate(kCommandUs, size))
+            return false;
+        memset(&image_[address], 0xFF, size);
+        erases_[address / kSectorSize]++;
+        busy_us_ = kEraseUs;
+        return Flush(address, kSectorSize) && size == kSectorSize;
+    }
+
+    bool IsBusy()
+    {
+        elapsed_us_ += kCommandUs;
+        last_us_ = kCommandUs;
+        return busy_us_ > 0;
+    }
+
+    // Time passing outside the flash calls, e.g. a scheduler period.
+    inline void Wait(uint32_t us) { busy_us_ = us < busy_us_ ? busy_us_ - us : 0; }
+
+    bool Program(uint32_t address, const uint8_t *data, size_t size)
+    {
+        if(size > kPageSize || address + size > image_.size() || Busy())
+            return false;
+        size_t whole = size;
+        if(!Operate(kProgramUs, size))
+            return false;
+        for(size_t i = 0; i < size; i++)
+            image_[address + i] &= data[i];
+        return Flush(address, whole) && size == whole;
+    }
+
+    void Read(uint32_t address, uint8_t *data, size_t size)
+    {
+        elapsed_us_ += kReadUs;
+        if(address + size > image_.size() || Busy())
+        {
+            memset(data, 0xFF, size);
+            return;
+        }
+        memcpy(data, &image_[address], size);
+    }
+
+    // Tears the `operations`th erase or program from now (1 = the next one).
+    inline void CutPower(uint32_t operations) { cut_after_ = operations; }
+    inline bool IsPowered() const { return powered_; }
+
+    // Flips one bit, as a worn or disturbed cell would.
+    void FlipBit(uint32_t address, int bit)
+    {
+        image_[address] ^= (uint8_t)(1u << bit);
+        Flush(address, 1);
+    }
+
+    inline uint64_t ElapsedUs() const { return elapsed_us_; }
+    inline uint32_t LastOperationUs() const { return last_us_; }
+    inline const std::vector<uint32_t> &SectorErases() const { return erases_; }
+    inline uint32_t                     BusyErrors() const { return busy_errors_; }
+
+  private:
+    // A program or read sent while an erase runs: counted, and refused.
+    bool Busy()
+    {
+        if(busy_us_ == 0)
+            return false;
+        busy_errors_++;
+        return true;
+    }
+
+    // Accounts for an operation and applies a pending power cut: `size`
+    // comes back halved for the torn operation.
+    bool Operate(uint32_t duration_us, size_t &size)
+    {
+        if(!powered_)
+            return false;
+        last_us_ = duration_us;
+        elapsed_us_ += duration_us;
+        if(cut_after_ > 0 && --cut_after_ == 0)
+        {
+            powered_ = false;
+            size /= 2;
+        }
+        return true;
+    }
+
+    bool Flush(size_t offset, size_t size)
+    {
+        return file_ && fseek(file_, (long)offset, SEEK_SET) == 0
+               && fwrite(&image_[offset], 1, size, file_) == size
+               && fflush(file_) == 0;
+    }
+
+    FILE                 *file_ = nullptr;
+    std::vector<uint8_t>  image_;
+    std::vector<uint32_t> erases_;
+    uint32_t              cut_after_   = 0;
+    bool                  powered_     = true;
+    uint64_t              elapsed_us_  = 0;
+    uint32_t              last_us_     = 0;
+    uint32_t              busy_us_     = 0;
+    uint32_t              busy_errors_ = 0;
+};
+
+} // namespace daisybed
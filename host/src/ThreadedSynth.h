@@ -0,0 +1,243 @@
+// basic-monosynth's voice architecture scaled up for the host: 16 MIDI
+// channels, each a VoiceBank of Voices (Oscillator + AdEnv), summed into the
+// same Svf lowpass and SimpleReverb as SynthEngine.
+//
+// Each block the voices are split across worker threads. Thread t renders
+// one contiguous range of the voices into its own partial bus; the buses are
+// then summed on the calling thread before the shared filter and reverb.
+// The banks are cache-line aligned and the ranges end on cache-line
+// boundaries, so no two threads write to the same line of voice state.
+// The allocator fills each bank's lowest free voices first, so the split is
+// even when the thread count divides the 16 banks and every thread gets
+// whole banks; otherwise a range boundary inside a bank may leave one side
+// with most of its sounding voices.
+//
+// The calling thread is worker 0. The rest park on a spinning generation
+// barrier built from two atomics, so a block never allocates, locks or
+// sleeps in the kernel. MIDI and parameter changes go through the calling
+// thread between blocks, while the workers are parked.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "daisysp.h"
+#include "SimpleReverb.h"
+#include "VoiceBank.h"
+
+namespace daisybed
+{
+template <int VoicesPerChannel>
+class ThreadedSynth
+{
+  public:
+    static constexpr int kChannels    = 16;
+    static constexpr int kTotalVoices = kChannels * VoicesPerChannel;
+
+    ~ThreadedSynth() { StopWorkers(); }
+
+    void Init(float sample_rate, size_t max_block, int threads)
+    {
+        StopWorkers();
+        for(int c = 0; c < kChannels; c++)
+            banks_[c].voices.Init(sample_rate);
+
+        filter_.Init(sample_rate);
+        filter_.SetFreq(2000.f);
+        filter_.SetRes(0.4f);
+        reverb_.Init(sample_rate);
+        reverb_.SetFeedback(0.7f);
+        reverb_.SetMix(0.4f);
+
+        threads_   = threads < 1 ? 1 : threads;
+        max_block_ = max_block;
+        // Whole cache lines per bus plus one line of padding, so threads
+        // never write to a line another thread's bus shares.
+        bus_stride_ = (max_block_ + kFloatsPerLine - 1) / kFloatsPerLine * kFloatsPerLine
+                      + kFloatsPerLine;
+        buses_.assign(bus_stride_ * threads_, 0.f);
+
+        // Thread t gets chunks [t * n / T, (t + 1) * n / T) of the n chunks.
+        const int chunks = kChannels * kChunksPerBank;
+        ranges_.resize(threads_ + 1);
+        for(int t = 0; t <= threads_; t++)
+            ranges_[t] = t * chunks / threads_;
+
+        stop_.store(false);
+        generation_.store(0);
+        for(int t = 1; t < threads_; t++)
+            workers_.emplace_back([this, t] { WorkerLoop(t); });
+    }
+
+    inline int GetThreads() const { return threads_; }
+
+    // Raw MIDI channel message, as SynthEngine::HandleMidi but routed to the
+    // bank of the message's channel.
+    void HandleMidi(uint8_t status, uint8_t data0, uint8_t data1)
+    {
+        VoiceBank<VoicesPerChannel> &bank = banks_[status & 0x0F].voices;
+        switch(status & 0xF0)
+        {
+            case 0x90:
+                if(data1 == 0)
+                {
+                    bank.NoteOff(data0);
+                    return;
+                }
+                bank.NoteOn(data0, data1 / 127.0f);
+                break;
+            case 0x80: bank.NoteOff(data0); break;
+            default: break;
+        }
+    }
+
+    void SetDecay(float seconds)
+    {
+        for(int c = 0; c < kChannels; c++)
+            banks_[c].voices.SetDecay(seconds);
+    }
+
+    int GetActiveCount() const
+    {
+        int count = 0;
+        for(int c = 0; c < kChannels; c++)
+            count += banks_[c].voices.GetActiveCount();
+        return count;
+    }
+
+    // Renders `size` (<= max_block) mono samples into `out`.
+    void ProcessBlock(float *out, size_t size)
+    {
+        if(size > max_block_)
+            size = max_block_;
+
+        // Release: the voice state and block size written since the last
+        // block become visible to the workers that see the new generation.
+        block_size_ = size;
+        pending_.store(threads_ - 1, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+
+        RenderPartial(0);
+
+        // Acquire: every worker's bus and voice updates are visible once the
+        // count reaches zero.
+        for(int spins = 0; pending_.load(std::memory_order_acquire) != 0; spins++)
+            Relax(spins);
+
+        const float scale = 0.7f / kTotalVoices;
+        for(size_t i = 0; i < size; i++)
+        {
+            float signal = 0.f;
+            for(int t = 0; t < threads_; t++)
+                signal += buses_[t * bus_stride_ + i];
+
+            filter_.Process(signal * scale);
+            float filtered = daisysp::fclamp(filter_.Low(), -1.0f, 1.0f);
+            out[i]         = reverb_.Process(filtered);
+        }
+    }
+
+  private:
+    static constexpr size_t kLineBytes     = 64;
+    static constexpr size_t kFloatsPerLine = kLineBytes / sizeof(float);
+
+    // Fewest voices that fill whole cache lines: the unit the voices are
+    // handed out in, so a range boundary never splits a line.
+    static constexpr int ChunkVoices()
+    {
+        int n = 1;
+        while(n * sizeof(Voice) % kLineBytes != 0)
+            n++;
+        return n;
+    }
+    static constexpr int kChunkVoices   = ChunkVoices();
+    static constexpr int kChunksPerBank = (VoicesPerChannel + kChunkVoices - 1) / kChunkVoices;
+
+    struct alignas(kLineBytes) AlignedBank
+    {
+        VoiceBank<VoicesPerChannel> voices;
+    };
+
+    void RenderPartial(int thread)
+    {
+        float *bus = &buses_[thread * bus_stride_];
+        for(size_t i = 0; i < block_size_; i++)
+            bus[i] = 0.f;
+        const int begin = ranges_[thread], end = ranges_[thread + 1];
+        for(int c = begin / kChunksPerBank; c < kChannels && c * kChunksPerBank < end; c++)
+        {
+            int first = std::max(begin - c * kChunksPerBank, 0) * kChunkVoices;
+            int last  = std::min((end - c * kChunksPerBank) * kChunkVoices, VoicesPerChannel);
+            banks_[c].voices.ProcessVoices(first, last, bus, block_size_);
+        }
+    }
+
+    void WorkerLoop(int thread)
+    {
+        uint32_t seen = 0;
+        while(true)
+        {
+            uint32_t generation;
+            for(int spins = 0;
+                (generation = generation_.load(std::memory_order_acquire)) == seen;
+                spins++)
+                Relax(spins);
+            seen = generation;
+            if(stop_.load(std::memory_order_relaxed))
+                return;
+            RenderPartial(thread);
+            pending_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // Spin briefly, then give the core away; the host may well have more
+    // workers than free cores.
+    static inline void Relax(int spins)
+    {
+        if(spins < 1024)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void StopWorkers()
+    {
+        if(workers_.empty())
+            return;
+        stop_.store(true, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        for(std::thread &worker : workers_)
+            worker.join();
+        workers_.clear();
+    }
+
+    AlignedBank  banks_[kChannels];
+    daisysp::Svf filter_;
+    SimpleReverb reverb_;
+
+    int                      threads_    = 1;
+    size_t                   max_block_  = 0;
+    size_t                   block_size_ = 0;
+    size_t                   bus_stride_ = 0;
+    std::vector<float>       buses_;  // one partial mix bus per thread
+    std::vector<int>         ranges_; // thread t: chunks [ranges_[t], ranges_[t + 1])
+    std::vector<std::thread> workers_;
+    std::atomic<uint32_t>    generation_{0};
+    std::atomic<int>         pending_{0};
+    std::atomic<bool>        stop_{false};
+};
+
+} // namespace daisybed
@@ -0,0 +1,377 @@
+// WAV I/O for the host tools.
+//
+//   WavWriter        interleaved 32-bit float, written in one pass with the
+//                    sizes patched into the header on Close()
+//   WavStreamWriter  the same file format, fed through two small buffers so
+//                    the disk write of one overlaps the render of the other
+//   MappedWav        memory-mapped input (16/24/32-bit PCM or 32-bit float),
+//                    converted to float a chunk at a time
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace daisybed
+{
+class WavWriter
+{
+  public:
+    ~WavWriter() { Close(); }
+
+    bool Open(const char *path, uint32_t sample_rate, uint16_t channels)
+    {
+        file_     = fopen(path, "wb");
+        channels_ = channels;
+        frames_   = 0;
+        if(!file_)
+            return false;
+        uint8_t header[kHeaderBytes];
+        FillHeader(header, sample_rate);
+        return fwrite(header, 1, sizeof(header), file_) == sizeof(header);
+    }
+
+    // `frames` interleaved frames of `channels` floats each.
+    bool Write(const float *interleaved, size_t frames)
+    {
+        frames_ += frames;
+        return fwrite(interleaved, sizeof(float) * channels_, frames, file_)
+               == frames;
+    }
+
+    void Close()
+    {
+        if(!file_)
+            return;
+        // RIFF sizes are 32-bit; past 4 GiB the header says "unknown", which
+        // most readers treat as "until end of file".
+        uint64_t data_bytes = (uint64_t)frames_ * channels_ * sizeof(float);
+        uint32_t data_size  = data_bytes > 0xFFFFFFFFu - kHeaderBytes
+                                  ? 0xFFFFFFFFu
+                                  : (uint32_t)data_bytes;
+        uint32_t riff_size  = data_size == 0xFFFFFFFFu
+                                  ? 0xFFFFFFFFu
+                                  : data_size + kHeaderBytes - 8;
+        fseek(file_, 4, SEEK_SET);
+        fwrite(&riff_size, 4, 1, file_);
+        fseek(file_, kHeaderBytes - 4, SEEK_SET);
+        fwrite(&data_size, 4, 1, file_);
+        fclose(file_);
+        file_ = nullptr;
+    }
+
+  private:
+    static constexpr size_t kHeaderBytes = 44;
+
+    void FillHeader(uint8_t *h, uint32_t sample_rate) const
+    {
+        uint16_t format      = 3; // WAVE_FORMAT_IEEE_FLOAT
+        uint16_t bits        = 32;
+        uint16_t block_align = (uint16_t)(channels_ * sizeof(float));
+        uint32_t byte_rate   = sample_rate * block_align;
+        uint32_t fmt_bytes   = 16;
+        uint32_t zero        = 0;
+        memcpy(h + 0, "RIFF", 4);
+        memcpy(h + 4, &zero, 4);
+        memcpy(h + 8, "WAVEfmt ", 8);
+        memcpy(h + 16, &fmt_bytes, 4);
+        memcpy(h + 20, &format, 2);
+        memcpy(h + 22, &channels_, 2);
+        memcpy(h + 24, &sample_rate, 4);
+        memcpy(h + 28, &byte_rate, 4);
+        memcpy(h + 32, &block_align, 2);
+        memcpy(h + 34, &bits, 2);
+        memcpy(h + 36, "data", 4);
+        memcpy(h + 40, &zero, 4);
+    }
+
+    FILE    *file_     = nullptr;
+    uint16_t channels_ = 2;
+    uint64_t frames_   = 0;
+};
+
+// Double-buffered WavWriter. The caller fills one buffer while a writer
+// thread flushes the other, so memory stays at two buffers however long the
+// render runs, and the render only waits if the disk falls a whole buffer
+// behind.
+class WavStreamWriter
+{
+  public:
+    ~WavStreamWriter() { Close(); }
+
+    bool Open(const char *path,
+              uint32_t    sample_rate,
+              uint16_t    channels,
+              size_t      frames_per_buffer = 16384)
+    {
+        if(!wav_.Open(path, sample_rate, channels))
+            return false;
+        channels_       = channels;
+        buffer_frames_  = frames_per_buffer;
+        fill_           = 0;
+        fill_frames_    = 0;
+        pending_frames_ = 0;
+        ok_             = true;
+        stop_           = false;
+        for(int i = 0; i < 2; i++)
+            buffers_[i].assign(buffer_frames_ * channels_, 0.f);
+        thread_ = std::thread([this] { WriterLoop(); });
+        return true;
+    }
+
+    // `frames` interleaved frames of `channels` floats each.
+    void Write(const float *interleaved, size_t frames)
+    {
+        while(frames > 0)
+        {
+            size_t n = buffer_frames_ - fill_frames_;
+            if(n > frames)
+                n = frames;
+            memcpy(buffers_[fill_].data() + fill_frames_ * channels_,
+                   interleaved,
+                   n * channels_ * sizeof(float));
+            fill_frames_ += n;
+            interleaved += n * channels_;
+            frames -= n;
+            if(fill_frames_ == buffer_frames_)
+                Submit();
+        }
+    }
+
+    // Flushes what's left and finalises the header. False if any write failed.
+    bool Close()
+    {
+        if(!thread_.joinable())
+            return ok_;
+        if(fill_frames_ > 0)
+            Submit();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+        wav_.Close();
+        return ok_;
+    }
+
+  private:
+    // Hands the fill buffer to the writer thread and swaps to the other one,
+    // waiting first if that one is still being written.
+    void Submit()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_frames_ == 0; });
+        pending_        = fill_;
+        pending_frames_ = fill_frames_;
+        fill_           = 1 - fill_;
+        fill_frames_    = 0;
+        lock.unlock();
+        cv_.notify_all();
+    }
+
+    void WriterLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while(true)
+        {
+            cv_.wait(lock, [this] { return pending_frames_ != 0 || stop_; });
+            if(pending_frames_ == 0)
+                return;
+            int    index  = pending_;
+            size_t frames = pending_frames_;
+            lock.unlock();
+            bool ok = wav_.Write(buffers_[index].data(), frames);
+            lock.lock();
+            ok_ = ok_ && ok;
+            pending_frames_ = 0;
+            cv_.notify_all();
+        }
+    }
+
+    WavWriter               wav_;
+    std::vector<float>      buffers_[2];
+    uint16_t                channels_      = 2;
+    size_t                  buffer_frames_ = 0;
+    int                     fill_          = 0; // owned by the caller
+    size_t                  fill_frames_   = 0;
+    int                     pending_       = 0; // guarded by mutex_
+    size_t                  pending_frames_ = 0;
+    bool                    ok_            = true;
+    bool                    stop_          = false;
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    std::thread             thread_;
+};
+
+// Read-only memory map of a WAV file. Nothing is copied up front; the pages
+// of the data chunk are faulted in as Read() walks through them.
+class MappedWav
+{
+  public:
+    ~MappedWav() { Close(); }
+
+    // False (with `error` set) if the file can't be mapped or isn't a PCM or
+    // float WAV we understand.
+    bool Open(const char *path, const char **error)
+    {
+        int fd = open(path, O_RDONLY);
+        if(fd < 0)
+            return Fail(error, "can't open file");
+        struct stat st;
+        if(fstat(fd, &st) != 0 || st.st_size < 12)
+        {
+            close(fd);
+            return Fail(error, "file too short");
+        }
+        size_ = (size_t)st.st_size;
+        void *map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(map == MAP_FAILED)
+            return Fail(error, "mmap failed");
+        base_ = static_cast<const uint8_t *>(map);
+        // One pass front to back: let the kernel read ahead and drop behind.
+        madvise(map, size_, MADV_SEQUENTIAL);
+        return ParseChunks(error);
+    }
+
+    void Close()
+    {
+        if(base_)
+            munmap(const_cast<uint8_t *>(base_), size_);
+        base_ = nullptr;
+    }
+
+    inline uint16_t GetChannels() const { return channels_; }
+    inline uint32_t GetSampleRate() const { return sample_rate_; }
+    inline uint64_t GetFrames() const { return frames_; }
+
+    // Converts `count` frames of one channel, starting at frame `start`, to
+    // float in -1..1.
+    void Read(uint64_t start, size_t count, uint16_t channel, float *out) const
+    {
+        const size_t   stride = (size_t)channels_ * bytes_per_sample_;
+        const uint8_t *p      = data_ + start * stride + channel * bytes_per_sample_;
+        switch(encoding_)
+        {
+            case Encoding::kPcm16:
+                for(size_t i = 0; i < count; i++, p += stride)
+                {
+                    int16_t s;
+                    memcpy(&s, p, 2);
+                    out[i] = s * (1.f / 32768.f);
+                }
+                break;
+            case Encoding::kPcm24:
+                for(size_t i = 0; i < count; i++, p += stride)
+                {
+                    int32_t s = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16
+                                          | (uint32_t)p[2] << 24);
+                    out[i] = (s >> 8) * (1.f / 8388608.f);
+                }
+                break;
+            case Encoding::kPcm32:
+                for(size_t i = 0; i < count; i++, p += stride)
+                {
+                    int32_t s;
+                    memcpy(&s, p, 4);
+                    out[i] = s * (1.f / 2147483648.f);
+                }
+                break;
+            case Encoding::kFloat32:
+                for(size_t i = 0; i < count; i++, p += stride)
+                    memcpy(&out[i], p, 4);
+                break;
+        }
+    }
+
+  private:
+    enum class Encoding
+    {
+        kPcm16,
+        kPcm24,
+        kPcm32,
+        kFloat32,
+    };
+
+    static bool Fail(const char **error, const char *what)
+    {
+        if(error)
+            *error = what;
+        return false;
+    }
+
+    bool ParseChunks(const char **error)
+    {
+        if(memcmp(base_, "RIFF", 4) != 0 || memcmp(base_ + 8, "WAVE", 4) != 0)
+            return Fail(error, "not a RIFF/WAVE file");
+        bool   have_fmt = false;
+        size_t pos      = 12;
+        while(pos + 8 <= size_)
+        {
+            uint32_t chunk_size;
+            memcpy(&chunk_size, base_ + pos + 4, 4);
+            const uint8_t *chunk = base_ + pos + 8;
+            if(memcmp(base_ + pos, "fmt ", 4) == 0 && chunk_size >= 16)
+            {
+                uint16_t format, bits;
+                memcpy(&format, chunk, 2);
+                memcpy(&channels_, chunk + 2, 2);
+                memcpy(&sample_rate_, chunk + 4, 4);
+                memcpy(&bits, chunk + 14, 2);
+                if(format == 0xFFFE && chunk_size >= 26) // WAVE_FORMAT_EXTENSIBLE
+                    memcpy(&format, chunk + 24, 2);
+                if(format == 1 && bits == 16)
+                    encoding_ = Encoding::kPcm16;
+                else if(format == 1 && bits == 24)
+                    encoding_ = Encoding::kPcm24;
+                else if(format == 1 && bits == 32)
+                    encoding_ = Encoding::kPcm32;
+                else if(format == 3 && bits == 32)
+                    encoding_ = Encoding::kFloat32;
+                else
+                    return Fail(error, "unsupported sample format");
+                if(channels_ == 0)
+                    return Fail(error, "no channels");
+                bytes_per_sample_ = bits / 8;
+                have_fmt          = true;
+            }
+            else if(memcmp(base_ + pos, "data", 4) == 0)
+            {
+                if(!have_fmt)
+                    return Fail(error, "data chunk before fmt chunk");
+                data_ = chunk;
+                // A streamed or >4 GiB file may carry a bogus size; trust the
+                // file length instead.
+                uint64_t available = size_ - (pos + 8);
+                uint64_t bytes     = chunk_size < available ? chunk_size : available;
+                if(chunk_size == 0 || chunk_size == 0xFFFFFFFFu)
+                    bytes = available;
+                frames_ = bytes / ((uint64_t)channels_ * bytes_per_sample_);
+                return true;
+            }
+            pos += 8 + chunk_size + (chunk_size & 1);
+        }
+        return Fail(error, "no data chunk");
+    }
+
+    const uint8_t *base_             = nullptr;
+    size_t         size_             = 0;
+    const uint8_t *data_             = nullptr;
+    uint64_t       frames_           = 0;
+    uint16_t       channels_         = 0;
+    uint32_t       sample_rate_      = 0;
+    size_t         bytes_per_sample_ = 0;
+    Encoding       encoding_         = Encoding::kPcm16;
+};
+
+} // namespace daisybed
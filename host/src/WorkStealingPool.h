@@ -0,0 +1,97 @@
+// Work-stealing ParallelFor for the host batch tools.
+//
+// Task indices are dealt round-robin into one deque per worker. A worker
+// takes from the back of its own deque (the most recently dealt, so a worker
+// walks its share in reverse) and, once that's empty, steals from the front
+// of another's. Renders vary a lot in cost (a long decay, a heavy engine),
+// so the workers that draw cheap tasks end up helping the rest instead of
+// idling at the end.
+//
+// Each deque has its own lock; tasks are whole renders, so lock traffic is
+// negligible and nothing allocates once the run has started.
+#pragma once
+
+#include <stddef.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace daisybed
+{
+class WorkStealingPool
+{
+  public:
+    explicit WorkStealingPool(size_t workers)
+    : queues_(workers > 0 ? workers : 1)
+    {
+    }
+
+    inline size_t GetWorkers() const { return queues_.size(); }
+
+    // Calls task(index, worker) once for every index in [0, count) and
+    // returns when all of them have finished. `task` runs concurrently on
+    // all workers, so it must only touch state owned by its index.
+    template <typename Task>
+    void ParallelFor(size_t count, Task &&task)
+    {
+        const size_t workers = queues_.size();
+        for(size_t i = 0; i < count; i++)
+            queues_[i % workers].items.push_back(i);
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for(size_t w = 1; w < workers; w++)
+            threads.emplace_back([this, w, &task] { Work(w, task); });
+        Work(0, task);
+        for(std::thread &t : threads)
+            t.join();
+    }
+
+  private:
+    struct Queue
+    {
+        std::mutex         mutex;
+        std::deque<size_t> items;
+    };
+
+    template <typename Task>
+    void Work(size_t worker, Task &task)
+    {
+        size_t index;
+        while(PopOwn(worker, index) || Steal(worker, index))
+            task(index, worker);
+    }
+
+    bool PopOwn(size_t worker, size_t &index)
+    {
+        Queue                      &q = queues_[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(q.items.empty())
+            return false;
+        index = q.items.back();
+        q.items.pop_back();
+        return true;
+    }
+
+    // Nothing is ever pushed after the run starts, so one empty sweep over
+    // every other deque means the work is done.
+    bool Steal(size_t thief, size_t &index)
+    {
+        for(size_t offset = 1; offset < queues_.size(); offset++)
+        {
+            Queue                      &q = queues_[(thief + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if(q.items.empty())
+                continue;
+            index = q.items.front();
+            q.items.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues_;
+};
+
+} // namespace daisybed
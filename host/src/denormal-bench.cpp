@@ -0,0 +1,153 @@
+// Renders a short noise burst followed by 60 s of silence through the shared
+// reverbs and reports CPU cost per second of audio. With denormal protection
+// the cost stays flat as the tail decays; without it the cost climbs once the
+// tail reaches the subnormal range.
+//
+//   denormal-bench [seconds_of_silence]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "DattorroPlate.h"
+#include "SimpleReverb.h"
+#include "Denormals.h"
+
+namespace
+{
+constexpr float  kSampleRate    = 48000.f;
+constexpr size_t kBlockSize     = 48;
+constexpr float  kBurstSeconds  = 0.5f;
+constexpr int    kReportEvery   = 5;
+
+enum class Protection
+{
+    kNone,
+    kFlushToZero,
+    kDcOffset,
+};
+
+const char *ProtectionName(Protection p)
+{
+    switch(p)
+    {
+        case Protection::kFlushToZero: return "ftz/daz";
+        case Protection::kDcOffset: return "dc-offset";
+        case Protection::kNone:
+        default: return "none";
+    }
+}
+
+struct PlateEngine
+{
+    daisybed::DattorroPlate plate;
+
+    static const char *Name() { return "DattorroPlate"; }
+    void Init(bool dc)
+    {
+        plate.Init(kSampleRate);
+        plate.SetDecay(0.9f);
+        plate.SetDenormalOffset(dc);
+    }
+    float Process(float in)
+    {
+        float l, r;
+        plate.Process(in, in, l, r);
+        return l + r;
+    }
+};
+
+struct SchroederEngine
+{
+    daisybed::SimpleReverb reverb;
+
+    static const char *Name() { return "SimpleReverb"; }
+    void Init(bool dc)
+    {
+        reverb.Init(kSampleRate);
+        reverb.SetFeedback(0.95f);
+        reverb.SetMix(1.f);
+        reverb.SetDenormalOffset(dc);
+    }
+    float Process(float in) { return reverb.Process(in); }
+};
+
+// Cheap deterministic noise so every run renders the same burst.
+struct Lcg
+{
+    uint32_t state = 0x12345678u;
+    float    Next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return (float)(int32_t)state * (1.f / 2147483648.f);
+    }
+};
+
+template <typename Engine>
+void Run(Protection protection, int silence_seconds)
+{
+    // Engines hold hundreds of KB of delay lines; keep them off the stack.
+    std::unique_ptr<Engine> engine(new Engine());
+    engine->Init(protection == Protection::kDcOffset);
+
+    std::unique_ptr<daisybed::ScopedFlushDenormals> ftz;
+    if(protection == Protection::kFlushToZero)
+        ftz.reset(new daisybed::ScopedFlushDenormals());
+
+    Lcg   noise;
+    float sink = 0.f;
+
+    size_t burst = (size_t)(kBurstSeconds * kSampleRate);
+    for(size_t i = 0; i < burst; i++)
+        sink += engine->Process(0.5f * noise.Next());
+
+    const size_t        blocks_per_second = (size_t)kSampleRate / kBlockSize;
+    std::vector<double> ns_per_sample(silence_seconds);
+    for(int second = 0; second < silence_seconds; second++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for(size_t block = 0; block < blocks_per_second; block++)
+            for(size_t i = 0; i < kBlockSize; i++)
+                sink += engine->Process(0.f);
+        auto end = std::chrono::steady_clock::now();
+        ns_per_sample[second]
+            = std::chrono::duration<double, std::nano>(end - start).count()
+              / kSampleRate;
+    }
+
+    double first = ns_per_sample[0], worst = first;
+    printf("%-14s %-10s", Engine::Name(), ProtectionName(protection));
+    for(int second = 0; second < silence_seconds; second++)
+    {
+        if(ns_per_sample[second] > worst)
+            worst = ns_per_sample[second];
+        if(second == 0 || (second + 1) % kReportEvery == 0)
+            printf(" %7.1f", ns_per_sample[second]);
+    }
+    printf("   worst/first %.2fx  (sink %g)\n", worst / first, (double)sink);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int silence_seconds = argc > 1 ? atoi(argv[1]) : 60;
+    if(silence_seconds < 1)
+        silence_seconds = 1;
+
+    printf("ns/sample over %d s of silence after a %.1f s burst "
+           "(columns: s1, then every %d s)\n",
+           silence_seconds,
+           kBurstSeconds,
+           kReportEvery);
+
+    const Protection modes[]
+        = {Protection::kNone, Protection::kFlushToZero, Protection::kDcOffset};
+    for(Protection p : modes)
+        Run<PlateEngine>(p, silence_seconds);
+    for(Protection p : modes)
+        Run<SchroederEngine>(p, silence_seconds);
+    return 0;
+}
@@ -0,0 +1,572 @@
+// Microbenchmarks for the shared DSP code, with JSON output and a regression
+// check against a saved baseline.
+//
+//   dsp-bench [--filter text] [--seconds s] [--json out.json]
+//             [--compare baseline.json] [--threshold 0.1]
+//
+// Components are timed one call at a time: DattorroPlate and SimpleReverb
+// per sample, a Voice's oscillator and envelope per sample, a WavetableOsc
+// saw next to daisysp's PolyBLEP saw per sample, Voice::SetNote and
+// Knob::Update per call, MeterTap and GrainCloud per sample, and a ModMatrix
+// of 16 routes into 32 destinations per sample of 48-sample blocks. Forty
+// early reflections are timed per sample twice: as one MultiTapDelay a block
+// at a time, and as forty daisysp::DelayLines, the cost it replaces. Each
+// firmware's callback body (the engine's control step and ProcessBlock, as
+// the firmware calls them) is timed at block sizes 4, 16, 48 and 128.
+//
+// Every case runs `seconds` of audio (or as many calls) seven times and
+// keeps the median. Results are ns per unit and, on x86, TSC cycles per
+// unit (reference cycles at the TSC's fixed rate, not core cycles).
+//
+// --compare flags every case slower than the baseline by more than the
+// threshold (a fraction, 0.1 = 10%) and exits 1 if there were any.
+// Baselines are only comparable on the machine that wrote them. Write one
+// with `--json host/bench-baseline.json` (or the bench-baseline target) on
+// your reference machine and commit it; the bench target compares against
+// it when it exists.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define DAISYBED_HAVE_TSC 1
+#else
+#define DAISYBED_HAVE_TSC 0
+#endif
+
+#include "AudioSpan.h"
+#include "DattorroPlate.h"
+#include "GrainCloud.h"
+#include "MeterTap.h"
+#include "ModMatrix.h"
+#include "MultiTapDelay.h"
+#include "ParaphonicSynth.h"
+#include "ShimmerVerb.h"
+#include "SimpleReverb.h"
+#include "SynthEngine.h"
+#include "Voice.h"
+#include "WavetableOsc.h"
+#include "knob.h"
+
+namespace
+{
+constexpr float  kSampleRate   = 48000.f;
+constexpr int    kRepeats      = 7;
+constexpr size_t kBlockSizes[] = {4, 16, 48, 128};
+constexpr size_t kMaxBlock     = 128;
+
+struct Options
+{
+    const char *filter    = nullptr;
+    float       seconds   = 1.f;
+    const char *json      = nullptr;
+    const char *compare   = nullptr;
+    float       threshold = 0.1f;
+};
+
+struct Result
+{
+    std::string name;
+    const char *unit;
+    double      ns;
+    double      cycles; // < 0 where there is no TSC
+};
+
+inline uint64_t ReadTsc()
+{
+#if DAISYBED_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Cheap deterministic noise so every run processes the same input.
+struct Lcg
+{
+    uint32_t state = 0x12345678u;
+    float    Next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return (float)(int32_t)state * (1.f / 2147483648.f);
+    }
+};
+
+// Keeps results alive so the optimiser can't drop the work.
+volatile float g_sink;
+
+// Times `run(units)` kRepeats times after one warm-up pass and records the
+// median per unit.
+template <typename Run>
+void Measure(const Options       &options,
+             std::vector<Result> &results,
+             const std::string   &name,
+             const char          *unit,
+             Run                  run)
+{
+    if(options.filter && name.find(options.filter) == std::string::npos)
+        return;
+
+    size_t units = (size_t)(options.seconds * kSampleRate);
+    run(units);
+
+    double ns[kRepeats], cycles[kRepeats];
+    for(int r = 0; r < kRepeats; r++)
+    {
+        auto     start     = std::chrono::steady_clock::now();
+        uint64_t tsc_start = ReadTsc();
+        run(units);
+        uint64_t tsc_end = ReadTsc();
+        auto     end     = std::chrono::steady_clock::now();
+        ns[r]     = std::chrono::duration<double, std::nano>(end - start).count() / units;
+        cycles[r] = (double)(tsc_end - tsc_start) / units;
+    }
+    std::sort(ns, ns + kRepeats);
+    std::sort(cycles, cycles + kRepeats);
+    results.push_back({name,
+                       unit,
+                       ns[kRepeats / 2],
+                       DAISYBED_HAVE_TSC ? cycles[kRepeats / 2] : -1.});
+}
+
+void BenchComponents(const Options &options, std::vector<Result> &results)
+{
+    Lcg noise;
+
+    {
+        std::unique_ptr<daisybed::DattorroPlate> plate(new daisybed::DattorroPlate());
+        plate->Init(kSampleRate);
+        plate->SetDecay(0.9f);
+        Measure(options, results, "plate", "sample", [&](size_t n) {
+            float l, r, sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+            {
+                plate->Process(noise.Next(), noise.Next(), l, r);
+                sum += l + r;
+            }
+            g_sink = sum;
+        });
+    }
+
+    {
+        std::unique_ptr<daisybed::SimpleReverb> reverb(new daisybed::SimpleReverb());
+        reverb->Init(kSampleRate);
+        reverb->SetFeedback(0.85f);
+        reverb->SetMix(0.5f);
+        Measure(options, results, "simple-reverb", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+                sum += reverb->Process(noise.Next());
+            g_sink = sum;
+        });
+    }
+
+    {
+        Voice voice;
+        voice.Init(kSampleRate);
+        voice.env.SetTime(ADENV_SEG_DECAY, 30.f);
+        Measure(options, results, "voice-process", "sample", [&](size_t n) {
+            voice.SetNote(60, 0.8f);
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+                sum += voice.osc.Process() * voice.env.Process();
+            g_sink = sum;
+        });
+
+        Measure(options, results, "voice-trigger", "call", [&](size_t n) {
+            for(size_t i = 0; i < n; i++)
+                voice.SetNote(36 + (int)(i % 48), 0.8f);
+            g_sink = voice.GetLevel();
+        });
+    }
+
+    {
+        daisybed::WavetableOsc wavetable;
+        wavetable.Init(kSampleRate);
+        wavetable.SetFreq(220.f);
+        Measure(options, results, "wavetable-saw", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+                sum += wavetable.Process();
+            g_sink = sum;
+        });
+
+        daisysp::Oscillator polyblep;
+        polyblep.Init(kSampleRate);
+        polyblep.SetWaveform(daisysp::Oscillator::WAVE_POLYBLEP_SAW);
+        polyblep.SetFreq(220.f);
+        Measure(options, results, "polyblep-saw", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+                sum += polyblep.Process();
+            g_sink = sum;
+        });
+    }
+
+    {
+        Knob knob;
+        knob.Init(0.5f, 20.f, 20000.f);
+        Measure(options, results, "knob-update", "call", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+            {
+                // Every 64th call jumps away, so both the caught and the
+                // catching paths run.
+                if((i & 63) == 0)
+                    knob.Reset();
+                knob.Update(0.5f + 0.3f * noise.Next());
+                sum += knob.GetValue();
+            }
+            g_sink = sum;
+        });
+    }
+
+    {
+        daisybed::MeterTap tap;
+        tap.Init(kSampleRate);
+        Measure(options, results, "meter-tap", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+            {
+                sum += tap.Observe(noise.Next());
+                if(i % 48 == 47)
+                    tap.EndBlock();
+            }
+            g_sink = sum + tap.GetRms();
+        });
+    }
+
+    {
+        // Sixteen routes, every source moving, half the destinations idle.
+        using Matrix = daisybed::ModMatrix<16, 32, 16>;
+        std::unique_ptr<Matrix> matrix(new Matrix());
+        matrix->Init();
+        for(int s = 0; s < 16; s++)
+            matrix->AddSource();
+        for(int d = 0; d < 32; d++)
+            matrix->AddDestination(0.5f, 0.f, 1.f, 0.2f);
+        for(int r = 0; r < 16; r++)
+            matrix->AddRoute(r, r, 0.5f);
+        Measure(options, results, "mod-matrix", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t done = 0; done < n; done += 48)
+            {
+                for(int s = 0; s < 16; s++)
+                    matrix->SetSource(s, noise.Next());
+                matrix->Process(48);
+                sum += matrix->GetRamp((int)(done / 48) % 32).At(47);
+            }
+            g_sink = sum;
+        });
+    }
+
+    {
+        using Early = daisybed::MultiTapDelay<2048, 40>;
+        std::unique_ptr<Early> early(new Early());
+        early->Init(kSampleRate);
+        early->SetRoom(1.f);
+        Measure(options, results, "multitap-40", "sample", [&](size_t n) {
+            float in[Early::kMaxBlock], l[Early::kMaxBlock], r[Early::kMaxBlock];
+            float sum = 0.f;
+            for(size_t done = 0; done < n; done += Early::kMaxBlock)
+            {
+                for(size_t i = 0; i < Early::kMaxBlock; i++)
+                    in[i] = noise.Next();
+                early->Process(in, l, r, Early::kMaxBlock);
+                sum += l[0] + r[Early::kMaxBlock - 1];
+            }
+            g_sink = sum;
+        });
+
+        // The same taps, one DelayLine each.
+        using Line = daisysp::DelayLine<float, 2048>;
+        std::unique_ptr<Line[]> lines(new Line[40]);
+        float                   gain_left[40], gain_right[40];
+        for(int t = 0; t < 40; t++)
+        {
+            lines[t].Init();
+            lines[t].SetDelay(48.f * (t + 1));
+            gain_left[t]  = 0.02f * (t % 3);
+            gain_right[t] = 0.02f * (t % 5);
+        }
+        Measure(options, results, "delayline-40", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+            {
+                float in = noise.Next(), l = 0.f, r = 0.f;
+                for(int t = 0; t < 40; t++)
+                {
+                    lines[t].Write(in);
+                    float tap = lines[t].Read();
+                    l += tap * gain_left[t];
+                    r += tap * gain_right[t];
+                }
+                sum += l + r;
+            }
+            g_sink = sum;
+        });
+    }
+
+    {
+        using Cloud = daisybed::GrainCloud<32768, 16>;
+        std::unique_ptr<Cloud> cloud(new Cloud());
+        cloud->Init(kSampleRate);
+        Measure(options, results, "grain-cloud", "sample", [&](size_t n) {
+            float sum = 0.f;
+            for(size_t i = 0; i < n; i++)
+            {
+                if(i % 48 == 0)
+                    cloud->BeginBlock(48);
+                sum += cloud->Process(noise.Next());
+            }
+            g_sink = sum;
+        });
+    }
+}
+
+// Runs `block(size)` back to back for n samples' worth of blocks.
+template <typename Block>
+void RunBlocks(size_t n, size_t size, Block block)
+{
+    for(size_t done = 0; done < n; done += size)
+        block(size);
+}
+
+void BenchCallbacks(const Options &options, std::vector<Result> &results)
+{
+    float  left[kMaxBlock], right[kMaxBlock], input[kMaxBlock];
+    float *out[2] = {left, right};
+    Lcg    noise;
+
+    for(size_t size : kBlockSizes)
+    {
+        std::string suffix = "-" + std::to_string(size);
+
+        // basic-monosynth: every voice held, filter mode, knobs moving.
+        std::unique_ptr<daisybed::SynthEngine> synth(new daisybed::SynthEngine());
+        synth->Init(kSampleRate);
+        synth->voices.SetDecay(30.f);
+        daisybed::SynthControls synth_controls = {0.5f, 0.5f, 0, true, false};
+        synth->ProcessControls(synth_controls);
+        synth_controls.button1Rising = false;
+        Measure(options, results, "monosynth-callback" + suffix, "sample", [&](size_t n) {
+            for(int v = 0; v < daisybed::SynthEngine::NUM_VOICES; v++)
+                synth->HandleMidi(0x90, (uint8_t)(48 + v), 100);
+            RunBlocks(n, size, [&](size_t s) {
+                synth_controls.knob1 = 0.5f + 0.01f * noise.Next();
+                synth->ProcessControls(synth_controls);
+                synth->ProcessBlock(daisybed::ViewStereo(out, s));
+            });
+            g_sink = left[0];
+        });
+        synth.reset();
+
+        // cinematic-verb: noise in, every knob at half way.
+        std::unique_ptr<daisybed::ShimmerVerb> verb(new daisybed::ShimmerVerb());
+        verb->Init(kSampleRate);
+        daisybed::ShimmerVerbControls verb_controls;
+        for(int adc = 0; adc < daisybed::ShimmerVerbControls::kNumAdc; adc++)
+            verb_controls.adc[adc] = adc < 4 ? 0.5f : 0.f;
+        const float *in[2] = {input, input};
+        Measure(options, results, "shimmer-callback" + suffix, "sample", [&](size_t n) {
+            RunBlocks(n, size, [&](size_t s) {
+                for(size_t i = 0; i < s; i++)
+                    input[i] = 0.25f * noise.Next();
+                verb->ProcessBlock(verb_controls,
+                                   daisybed::ViewStereo(in, s),
+                                   daisybed::ViewStereo(out, s));
+            });
+            g_sink = left[0];
+        });
+        verb.reset();
+
+        // awful-paraphonic-synth: a gate every ~20 ms, so all eight voices
+        // overlap.
+        std::unique_ptr<daisybed::ParaphonicSynth> para(new daisybed::ParaphonicSynth());
+        para->Init(kSampleRate, daisybed::PitchCalibration::Default());
+        daisybed::ParaphonicControls para_controls = {};
+        para_controls.coarse_knob  = 0.4f;
+        para_controls.attack_knob  = 0.1f;
+        para_controls.cutoff_knob  = 0.6f;
+        para_controls.release_knob = 0.8f;
+        Measure(options, results, "paraphonic-callback" + suffix, "sample", [&](size_t n) {
+            size_t since_gate = 0;
+            RunBlocks(n, size, [&](size_t s) {
+                para_controls.trigger_count = 0;
+                since_gate += s;
+                if(since_gate >= 960)
+                {
+                    para_controls.triggers[0]   = 0;
+                    para_controls.trigger_count = 1;
+                    since_gate                  = 0;
+                }
+                para_controls.voct_raw = 0.1f * noise.Next();
+                para->ProcessBlock(para_controls, daisybed::ViewStereo(out, s));
+            });
+            g_sink = left[0];
+        });
+    }
+}
+
+bool WriteJson(const char *path, const std::vector<Result> &results)
+{
+    FILE *file = fopen(path, "w");
+    if(!file)
+        return false;
+    // One case per line: the --compare reader relies on it.
+    fprintf(file, "{\n  \"sample_rate\": %.0f,\n  \"cases\": [\n", kSampleRate);
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        const Result &r = results[i];
+        fprintf(file,
+                "    {\"name\": \"%s\", \"unit\": \"%s\", \"ns_per_unit\": %.4f, ",
+                r.name.c_str(),
+                r.unit,
+                r.ns);
+        if(r.cycles >= 0.)
+            fprintf(file, "\"cycles_per_unit\": %.3f}", r.cycles);
+        else
+            fprintf(file, "\"cycles_per_unit\": null}");
+        fprintf(file, "%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+struct BaselineCase
+{
+    std::string name;
+    double      ns;
+};
+
+// Reads what WriteJson() wrote.
+bool ReadBaseline(const char *path, std::vector<BaselineCase> &cases)
+{
+    FILE *file = fopen(path, "r");
+    if(!file)
+        return false;
+    char line[512];
+    while(fgets(line, sizeof(line), file))
+    {
+        const char *name = strstr(line, "\"name\": \"");
+        const char *ns   = strstr(line, "\"ns_per_unit\": ");
+        if(!name || !ns)
+            continue;
+        name += strlen("\"name\": \"");
+        const char *end = strchr(name, '"');
+        if(!end)
+            continue;
+        cases.push_back({std::string(name, end), strtod(ns + strlen("\"ns_per_unit\": "), nullptr)});
+    }
+    fclose(file);
+    return true;
+}
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--filter") == 0)
+            options.filter = argv[i + 1];
+        else if(strcmp(argv[i], "--seconds") == 0)
+            options.seconds = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--json") == 0)
+            options.json = argv[i + 1];
+        else if(strcmp(argv[i], "--compare") == 0)
+            options.compare = argv[i + 1];
+        else if(strcmp(argv[i], "--threshold") == 0)
+            options.threshold = (float)atof(argv[i + 1]);
+        else
+            return false;
+    }
+    return argc % 2 == 1 && options.seconds > 0.f && options.threshold > 0.f;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: dsp-bench [--filter text] [--seconds s] [--json out.json]\n"
+                "                 [--compare baseline.json] [--threshold 0.1]\n");
+        return 2;
+    }
+
+    std::vector<BaselineCase> baseline;
+    bool                      have_baseline = false;
+    if(options.compare)
+    {
+        have_baseline = ReadBaseline(options.compare, baseline);
+        if(!have_baseline)
+            printf("no baseline at %s; write one with --json %s\n",
+                   options.compare,
+                   options.compare);
+    }
+
+    std::vector<Result> results;
+    BenchComponents(options, results);
+    BenchCallbacks(options, results);
+
+    int regressions = 0;
+    printf("%-26s %12s %12s", "case", "ns/unit", "cycles/unit");
+    if(have_baseline)
+        printf(" %12s %8s", "baseline", "change");
+    printf("\n");
+    for(const Result &r : results)
+    {
+        printf("%-26s %12.3f", r.name.c_str(), r.ns);
+        if(r.cycles >= 0.)
+            printf(" %12.2f", r.cycles);
+        else
+            printf(" %12s", "-");
+        if(have_baseline)
+        {
+            const BaselineCase *base = nullptr;
+            for(const BaselineCase &b : baseline)
+                if(b.name == r.name)
+                    base = &b;
+            if(base == nullptr || base->ns <= 0.)
+                printf(" %12s %8s", "-", "new");
+            else
+            {
+                double change = r.ns / base->ns - 1.;
+                printf(" %12.3f %+7.1f%%", base->ns, 100. * change);
+                if(change > options.threshold)
+                {
+                    printf("  REGRESSION");
+                    regressions++;
+                }
+                else if(change < -options.threshold)
+                    printf("  faster");
+            }
+        }
+        printf("\n");
+    }
+
+    if(options.json && !WriteJson(options.json, results))
+    {
+        fprintf(stderr, "can't write %s\n", options.json);
+        return 2;
+    }
+    if(regressions > 0)
+    {
+        printf("%d case%s slower than the baseline by more than %.0f%%\n",
+               regressions,
+               regressions == 1 ? "" : "s",
+               100. * options.threshold);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,253 @@
+// Feeds GateInput (shared/GateInput.h) a simulated gate stream, the way the
+// pin interrupt does on the board, and checks where each rising edge lands.
+//
+//   gate-sim [--seconds s] [--block n] [--jitter-us us] [--load l] [--seed n]
+//
+// Edges come at random intervals (0.2 to 20 ms), timestamped on a 200 MHz
+// tick that starts a second short of wrapping. Each audio callback calls
+// BeginBlock() with the tick it runs at: the end of its block plus up to
+// --jitter-us of DMA/interrupt latency. It then runs for --load of a block.
+// An edge is placed correctly if its sample in the rendered stream is within
+// the jitter (plus one sample of rounding) of the sample it happened at.
+//
+// Whether the callback masks the edge interrupt follows the firmware's
+// priorities in GateInput.h. If it does, an edge that arrives while the
+// callback runs is timestamped only when it returns; if not, it is stamped
+// on time and may even be queued before BeginBlock() reads the queue. The
+// other arrangement is run too and printed for scale.
+//
+// It also sends a burst of more edges than fit in one block and checks the
+// gate level still follows the last of them. Prints the timing error next to
+// what polling once per block would give, and exits 1 if any check fails.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "GateInput.h"
+
+namespace
+{
+constexpr double   kTickFreq       = 200e6;
+constexpr double   kSampleRate     = 48000.0;
+constexpr double   kTicksPerSample = kTickFreq / kSampleRate;
+constexpr uint32_t kTickStart      = 0xFFFFFFFFu - (uint32_t)kTickFreq;
+// From the callback's entry, where it reads the tick, to BeginBlock()'s read
+// of the queue.
+constexpr double kQueueReadSamples = 2e-6 * kSampleRate;
+
+struct Lcg
+{
+    uint32_t state;
+    // Uniform in [0, 1).
+    double Uniform()
+    {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0;
+    }
+};
+
+struct Options
+{
+    float    seconds   = 60.f;
+    int      block     = 48;
+    float    jitter_us = 20.f;
+    float    load      = 0.7f;
+    uint32_t seed      = 1;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--seconds") == 0)
+            options.seconds = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--block") == 0)
+            options.block = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--jitter-us") == 0)
+            options.jitter_us = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--load") == 0)
+            options.load = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--seed") == 0)
+            options.seed = (uint32_t)atoi(argv[i + 1]);
+        else
+            return false;
+    }
+    return argc % 2 == 1 && options.seconds > 0.f && options.block > 0
+           && options.jitter_us >= 0.f && options.load >= 0.f && options.load < 1.f;
+}
+
+inline uint32_t TickAt(double sample)
+{
+    return kTickStart + (uint32_t)(int64_t)(sample * kTicksPerSample);
+}
+
+struct Edge
+{
+    double sample; // when it happened, in input samples
+    bool   rising;
+};
+
+struct StreamResult
+{
+    size_t rising;
+    size_t placed;
+    size_t level_fails;
+    double worst, total, worst_polled;
+};
+
+// Callback k renders block k (input samples k*block .. (k+1)*block) and runs
+// from callbacks[k] for `busy` samples. An edge is queued when its interrupt
+// runs: when it happens, or with `masked` when the callback it arrives in
+// returns, stamped then too.
+StreamResult RunStream(const std::vector<Edge>   &edges,
+                       const std::vector<double> &callbacks,
+                       size_t                     block,
+                       double                     busy,
+                       bool                       masked)
+{
+    daisybed::GateInput gate;
+    gate.Init((float)kTickFreq, (float)kSampleRate);
+
+    StreamResult        result = {};
+    std::vector<double> rising; // when each rising edge sent so far happened
+    std::vector<Edge>   queued; // each edge sent so far, as stamped
+    size_t              next     = 0;
+    size_t              window   = 0; // the callback an edge may arrive in
+    size_t              consumed = 0;
+    bool                expected = false;
+    for(size_t k = 0; k < callbacks.size(); k++)
+    {
+        double callback = callbacks[k];
+        while(next < edges.size())
+        {
+            const Edge &edge  = edges[next];
+            double      stamp = edge.sample;
+            while(window < callbacks.size() && callbacks[window] + busy <= stamp)
+                window++;
+            if(masked && window < callbacks.size() && callbacks[window] <= stamp)
+                stamp = callbacks[window] + busy;
+            if(stamp >= callback + kQueueReadSamples)
+                break;
+            gate.OnEdge(edge.rising, TickAt(stamp));
+            queued.push_back({stamp, edge.rising});
+            if(edge.rising)
+                rising.push_back(edge.sample);
+            next++;
+        }
+        gate.BeginBlock(TickAt(callback), block);
+        // The level is that of the last edge stamped by the callback's tick.
+        while(consumed < queued.size() && queued[consumed].sample <= callback)
+            expected = queued[consumed++].rising;
+
+        // The rising edges consumed this block come out in order.
+        size_t offset;
+        while(gate.NextRisingEdge(offset) && result.placed < rising.size())
+        {
+            double happened     = rising[result.placed++];
+            double error        = fabs((double)(k * block + offset) - happened);
+            double polled       = happened - (double)(k * block);
+            result.worst        = error > result.worst ? error : result.worst;
+            result.worst_polled = fabs(polled) > result.worst_polled ? fabs(polled)
+                                                                     : result.worst_polled;
+            result.total += error;
+        }
+        if(gate.IsHigh() != expected)
+            result.level_fails++;
+    }
+    // Edges queued after the last callback's read aren't placed yet.
+    result.rising = rising.size();
+    while(result.rising > 0 && rising[result.rising - 1] >= callbacks.back())
+        result.rising--;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: gate-sim [--seconds s] [--block n] [--jitter-us us] "
+                "[--load l] [--seed n]\n");
+        return 2;
+    }
+
+    const size_t block         = (size_t)options.block;
+    const double jitter        = options.jitter_us * 1e-6 * kSampleRate;
+    const double busy          = options.load * (double)block;
+    const size_t total_samples = (size_t)(options.seconds * kSampleRate);
+
+    Lcg               rng = {options.seed};
+    std::vector<Edge> edges;
+    bool              level = false;
+    for(double t = 100.0; t < total_samples - 2.0 * block;)
+    {
+        level = !level;
+        edges.push_back({t, level});
+        t += (0.2 + rng.Uniform() * 19.8) * 1e-3 * kSampleRate;
+    }
+    std::vector<double> callbacks;
+    for(size_t k = 0; (k + 1) * block <= total_samples; k++)
+        callbacks.push_back((double)((k + 1) * block) + rng.Uniform() * jitter);
+
+    // The firmware's arrangement, then the other one for scale.
+    const bool   masked = !(daisybed::kGateIrqPriority < daisybed::kAudioDmaIrqPriority);
+    StreamResult result = RunStream(edges, callbacks, block, busy, masked);
+    StreamResult other  = RunStream(edges, callbacks, block, busy, !masked);
+
+    int failures = 0;
+    printf("%zu rising edges, %zu-sample blocks, up to %.1f us callback jitter, "
+           "callback busy %.0f%% of each block\n",
+           result.rising,
+           block,
+           options.jitter_us,
+           options.load * 100.f);
+    printf("placed (edge interrupt %s the callback): worst %.2f samples, mean %.2f\n",
+           masked ? "masked by" : "preempting",
+           result.worst,
+           result.placed ? result.total / result.placed : 0.0);
+    printf("  %s the callback instead: worst %.2f samples; polled per block: worst %.2f\n",
+           masked ? "preempting" : "masked by",
+           other.worst,
+           result.worst_polled);
+    if(result.placed != result.rising)
+    {
+        printf("FAIL: %zu of %zu rising edges placed\n", result.placed, result.rising);
+        failures++;
+    }
+    if(result.worst > jitter + 1.0)
+    {
+        printf("FAIL: worst error %.2f samples, bound %.2f\n", result.worst, jitter + 1.0);
+        failures++;
+    }
+    if(result.level_fails > 0)
+    {
+        printf("FAIL: gate level wrong after %zu blocks\n", result.level_fails);
+        failures++;
+    }
+
+    // A burst of 41 edges in one block: more than a block holds, but the
+    // level must still be that of the last one.
+    daisybed::GateInput burst;
+    burst.Init((float)kTickFreq, (float)kSampleRate);
+    for(int e = 0; e < 41; e++)
+        burst.OnEdge(e % 2 == 0, TickAt((double)block * e / 41.0));
+    burst.BeginBlock(TickAt((double)block), block);
+    size_t burst_rising = 0, offset;
+    while(burst.NextRisingEdge(offset))
+        burst_rising++;
+    printf("burst of 41 edges: %zu rising edges delivered, gate %s\n",
+           burst_rising,
+           burst.IsHigh() ? "high" : "low");
+    if(!burst.IsHigh() || burst_rising == 0)
+    {
+        printf("FAIL: burst lost the gate level\n");
+        failures++;
+    }
+    return failures > 0 ? 1 : 0;
+}
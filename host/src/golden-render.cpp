@@ -0,0 +1,471 @@
+// Golden-render regression harness: renders fixed stimuli through each shared
+// engine and compares the result with reference renders stored as WAVs, so
+// an optimised DSP path can be shown to still sound the same.
+//
+//   golden-render --write dir               render and store the references
+//   golden-render --check dir [--snr-db x] [--lsd-db y] [--filter a,b...]
+//
+// Cases (one second each, stereo, 48 kHz, rendered in 48-sample blocks):
+//
+//   plate, simple-reverb, shimmer   impulse, log sweep 20 Hz..20 kHz, noise
+//                                   burst (250 ms, then the tail)
+//   monosynth                       a scripted note sequence through
+//                                   HandleMidi, with a filter sweep
+//   paraphonic                      a scripted gate and V/Oct sequence
+//
+// With neither tolerance given, --check is bit-exact: right for refactors,
+// which must not change a single sample. For deliberate approximations (fast
+// math, fixed point, decimation) give a floor on the SNR of the render
+// against the reference and/or a ceiling on their log-spectral distance,
+// e.g. --snr-db 60 --lsd-db 1. Each case prints the differing sample count,
+// the largest difference, the SNR and the spectral distance; the exit code
+// is 1 if any case fails or has no reference, or the directory is missing.
+// --filter keeps the cases whose name contains any of the comma-separated
+// texts.
+//
+// Bit-exact references only match renders from the same compiler, flags and
+// CPU family, and the same build options (DAISYBED_GRAIN_SHIMMER changes the
+// shimmer cases). A compiler or libm change moves a reverb's samples by
+// rounding only, which the tolerances absorb, so the golden target checks
+// the committed references (host/golden/) that way.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AudioMetrics.h"
+#include "AudioSpan.h"
+#include "DattorroPlate.h"
+#include "ParaphonicSynth.h"
+#include "ShimmerVerb.h"
+#include "SimpleReverb.h"
+#include "SynthEngine.h"
+#include "WavFile.h"
+
+namespace
+{
+constexpr float  kSampleRate = 48000.f;
+constexpr size_t kBlockSize  = 48;
+constexpr size_t kFrames     = 48000;
+
+// Cheap deterministic noise so every render gets the same burst.
+struct Lcg
+{
+    uint32_t state = 0x12345678u;
+    float    Next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return (float)(int32_t)state * (1.f / 2147483648.f);
+    }
+};
+
+// Mono input signal for the effect engines.
+std::vector<float> Stimulus(const char *name)
+{
+    std::vector<float> x(kFrames, 0.f);
+    if(strcmp(name, "impulse") == 0)
+        x[0] = 1.f;
+    else if(strcmp(name, "sweep") == 0)
+    {
+        // Exponential sine sweep: the phase integrates f0 * (f1/f0)^(t/T).
+        const double f0 = 20.0, f1 = 20000.0, duration = kFrames / kSampleRate;
+        const double k = log(f1 / f0);
+        for(size_t i = 0; i < kFrames; i++)
+        {
+            double t     = i / kSampleRate;
+            double phase = 2.0 * M_PI * f0 * duration / k * (exp(t / duration * k) - 1.0);
+            x[i]         = 0.5f * (float)sin(phase);
+        }
+    }
+    else if(strcmp(name, "noise-burst") == 0)
+    {
+        Lcg noise;
+        for(size_t i = 0; i < kFrames / 4; i++)
+            x[i] = 0.5f * noise.Next();
+    }
+    return x;
+}
+
+// Interleaved stereo render of one case.
+using Render = std::vector<float> (*)(const char *stimulus);
+
+// Runs a stereo effect over the stimulus a block at a time.
+template <typename Process>
+std::vector<float> RenderEffect(const char *stimulus, Process process)
+{
+    std::vector<float> in = Stimulus(stimulus), out(2 * kFrames);
+    float              left[kBlockSize], right[kBlockSize];
+    for(size_t start = 0; start < kFrames; start += kBlockSize)
+    {
+        process(&in[start], left, right, kBlockSize);
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            out[2 * (start + i)]     = left[i];
+            out[2 * (start + i) + 1] = right[i];
+        }
+    }
+    return out;
+}
+
+std::vector<float> RenderPlate(const char *stimulus)
+{
+    std::unique_ptr<daisybed::DattorroPlate> plate(new daisybed::DattorroPlate());
+    plate->Init(kSampleRate);
+    plate->SetDecay(0.85f);
+    return RenderEffect(stimulus, [&](const float *in, float *left, float *right, size_t n) {
+        for(size_t i = 0; i < n; i++)
+            plate->Process(in[i], in[i], left[i], right[i]);
+    });
+}
+
+std::vector<float> RenderSimpleReverb(const char *stimulus)
+{
+    std::unique_ptr<daisybed::SimpleReverb> reverb(new daisybed::SimpleReverb());
+    reverb->Init(kSampleRate);
+    reverb->SetFeedback(0.8f);
+    reverb->SetMix(0.5f);
+    return RenderEffect(stimulus, [&](const float *in, float *left, float *right, size_t n) {
+        for(size_t i = 0; i < n; i++)
+            left[i] = right[i] = reverb->Process(in[i]);
+    });
+}
+
+std::vector<float> RenderShimmer(const char *stimulus)
+{
+    std::unique_ptr<daisybed::ShimmerVerb> verb(new daisybed::ShimmerVerb());
+    verb->Init(kSampleRate);
+    daisybed::ShimmerVerbControls controls = {};
+    controls.adc[0] = 0.6f; // size
+    controls.adc[1] = 0.5f; // shimmer
+    controls.adc[2] = 0.4f; // interval
+    controls.adc[3] = 0.7f; // mix
+    return RenderEffect(stimulus, [&](const float *in, float *left, float *right, size_t n) {
+        const float *ins[2]  = {in, in};
+        float       *outs[2] = {left, right};
+        verb->ProcessBlock(controls,
+                           daisybed::ViewStereo(ins, n),
+                           daisybed::ViewStereo(outs, n));
+    });
+}
+
+// Blocks into the render at which the sequences' events land.
+struct MidiEvent
+{
+    size_t  block;
+    uint8_t status, data0, data1;
+};
+
+std::vector<float> RenderMonosynth(const char *)
+{
+    // A chord, a short run over it, releases, a retrigger of a held note and
+    // a zero-velocity note-on for a note that isn't playing.
+    static const MidiEvent kSequence[] = {
+        {0, 0x90, 48, 100},
+        {0, 0x90, 55, 90},
+        {0, 0x90, 60, 80},
+        {100, 0x90, 64, 110},
+        {200, 0x80, 64, 0},
+        {200, 0x90, 67, 70},
+        {300, 0x80, 67, 0},
+        {300, 0x90, 72, 127},
+        {450, 0x80, 48, 0},
+        {450, 0x80, 55, 0},
+        {500, 0x90, 60, 60},
+        {600, 0x90, 36, 0},
+        {700, 0x80, 60, 0},
+        {700, 0x80, 72, 0},
+        {800, 0x90, 43, 100},
+    };
+
+    std::unique_ptr<daisybed::SynthEngine> synth(new daisybed::SynthEngine());
+    synth->Init(kSampleRate);
+    // Filter mode, then the cutoff knob swept up across the render; soft
+    // takeover picks it up once it passes the stored cutoff.
+    daisybed::SynthControls controls = {0.f, 0.4f, 0, true, false};
+
+    std::vector<float> out(2 * kFrames);
+    float              left[kBlockSize], right[kBlockSize];
+    float             *outs[2] = {left, right};
+    size_t             next    = 0;
+    for(size_t block = 0; block * kBlockSize < kFrames; block++)
+    {
+        while(next < sizeof(kSequence) / sizeof(kSequence[0])
+              && kSequence[next].block == block)
+        {
+            const MidiEvent &e = kSequence[next++];
+            synth->HandleMidi(e.status, e.data0, e.data1);
+        }
+        controls.knob1 = (float)block * kBlockSize / kFrames;
+        synth->ProcessControls(controls);
+        controls.button1Rising = false;
+        synth->ProcessBlock(daisybed::ViewStereo(outs, kBlockSize));
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            out[2 * (block * kBlockSize + i)]     = left[i];
+            out[2 * (block * kBlockSize + i) + 1] = right[i];
+        }
+    }
+    return out;
+}
+
+std::vector<float> RenderParaphonic(const char *)
+{
+    struct Gate
+    {
+        size_t block, offset;
+        float  voct_raw;
+    };
+    // Gates at odd offsets inside their blocks, over more than eight voices
+    // so the round robin wraps.
+    static const Gate kSequence[] = {
+        {0, 0, 0.f},      {50, 13, 0.1f},   {100, 47, 0.2f},  {150, 1, 0.05f},
+        {200, 30, 0.3f},  {250, 7, 0.15f},  {300, 22, 0.25f}, {350, 40, 0.f},
+        {400, 3, 0.35f},  {450, 19, 0.12f}, {600, 11, 0.2f},  {800, 0, 0.08f},
+    };
+
+    std::unique_ptr<daisybed::ParaphonicSynth> synth(new daisybed::ParaphonicSynth());
+    synth->Init(kSampleRate, daisybed::PitchCalibration::Default());
+    daisybed::ParaphonicControls controls = {};
+    controls.coarse_knob  = 0.4f;
+    controls.attack_knob  = 0.05f;
+    controls.cutoff_knob  = 0.5f;
+    controls.release_knob = 0.3f;
+
+    std::vector<float> out(2 * kFrames);
+    float              left[kBlockSize], right[kBlockSize];
+    float             *outs[2] = {left, right};
+    size_t             next    = 0;
+    for(size_t block = 0; block * kBlockSize < kFrames; block++)
+    {
+        controls.trigger_count = 0;
+        while(next < sizeof(kSequence) / sizeof(kSequence[0])
+              && kSequence[next].block == block)
+        {
+            const Gate &g     = kSequence[next++];
+            controls.voct_raw = g.voct_raw;
+            controls.triggers[controls.trigger_count++] = g.offset;
+        }
+        synth->ProcessBlock(controls, daisybed::ViewStereo(outs, kBlockSize));
+        for(size_t i = 0; i < kBlockSize; i++)
+        {
+            out[2 * (block * kBlockSize + i)]     = left[i];
+            out[2 * (block * kBlockSize + i) + 1] = right[i];
+        }
+    }
+    return out;
+}
+
+struct Case
+{
+    const char *engine;
+    const char *stimulus;
+    Render      render;
+};
+
+const Case kCases[] = {
+    {"plate", "impulse", RenderPlate},
+    {"plate", "sweep", RenderPlate},
+    {"plate", "noise-burst", RenderPlate},
+    {"simple-reverb", "impulse", RenderSimpleReverb},
+    {"simple-reverb", "sweep", RenderSimpleReverb},
+    {"simple-reverb", "noise-burst", RenderSimpleReverb},
+    {"shimmer", "impulse", RenderShimmer},
+    {"shimmer", "sweep", RenderShimmer},
+    {"shimmer", "noise-burst", RenderShimmer},
+    {"monosynth", "notes", RenderMonosynth},
+    {"paraphonic", "notes", RenderParaphonic},
+};
+
+struct Options
+{
+    const char *write  = nullptr;
+    const char *check  = nullptr;
+    const char *filter = nullptr;
+    double      snr_db = -1.; // < 0: not given
+    double      lsd_db = -1.;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--write") == 0)
+            options.write = argv[i + 1];
+        else if(strcmp(argv[i], "--check") == 0)
+            options.check = argv[i + 1];
+        else if(strcmp(argv[i], "--filter") == 0)
+            options.filter = argv[i + 1];
+        else if(strcmp(argv[i], "--snr-db") == 0)
+            options.snr_db = atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--lsd-db") == 0)
+            options.lsd_db = atof(argv[i + 1]);
+        else
+            return false;
+    }
+    return argc % 2 == 1 && (options.write == nullptr) != (options.check == nullptr);
+}
+
+std::string CasePath(const char *dir, const Case &c)
+{
+    return std::string(dir) + "/" + c.engine + "-" + c.stimulus + ".wav";
+}
+
+// Deinterleaves one channel of a stereo render.
+std::vector<float> Channel(const std::vector<float> &stereo, int channel)
+{
+    std::vector<float> x(stereo.size() / 2);
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = stereo[2 * i + channel];
+    return x;
+}
+
+// Prints one case's comparison; true if it passes.
+bool Check(const Options &options, const Case &c, const std::vector<float> &render)
+{
+    std::string         path = CasePath(options.check, c);
+    daisybed::MappedWav wav;
+    const char         *error = nullptr;
+    if(!wav.Open(path.c_str(), &error))
+    {
+        printf("%-14s %-12s no reference (%s: %s)\n", c.engine, c.stimulus, path.c_str(), error);
+        return false;
+    }
+    if(wav.GetChannels() != 2 || wav.GetFrames() != kFrames)
+    {
+        printf("%-14s %-12s reference has a different shape\n", c.engine, c.stimulus);
+        return false;
+    }
+
+    size_t differing = 0;
+    float  max_diff  = 0.f;
+    double snr_db    = INFINITY, lsd_db = 0.;
+    for(int channel = 0; channel < 2; channel++)
+    {
+        std::vector<float> reference(kFrames);
+        wav.Read(0, kFrames, (uint16_t)channel, reference.data());
+        std::vector<float> x = Channel(render, channel);
+
+        for(size_t i = 0; i < kFrames; i++)
+        {
+            if(memcmp(&reference[i], &x[i], sizeof(float)) != 0)
+                differing++;
+            float d  = fabsf(reference[i] - x[i]);
+            max_diff = d > max_diff ? d : max_diff;
+        }
+        double snr = daisybed::SnrDb(reference.data(), x.data(), kFrames);
+        double lsd = daisybed::LogSpectralDistance(reference.data(), x.data(), kFrames);
+        snr_db     = snr < snr_db ? snr : snr_db;
+        lsd_db     = lsd > lsd_db ? lsd : lsd_db;
+    }
+
+    bool tolerant = options.snr_db >= 0. || options.lsd_db >= 0.;
+    bool pass;
+    if(tolerant)
+        pass = (options.snr_db < 0. || snr_db >= options.snr_db)
+               && (options.lsd_db < 0. || lsd_db <= options.lsd_db);
+    else
+        pass = differing == 0;
+
+    printf("%-14s %-12s %-4s %9zu %11.3g %9.1f %8.3f\n",
+           c.engine,
+           c.stimulus,
+           pass ? "ok" : "FAIL",
+           differing,
+           (double)max_diff,
+           snr_db,
+           lsd_db);
+    return pass;
+}
+
+// True if there's no filter or `name` contains one of its comma-separated
+// texts.
+bool Selected(const char *filter, const std::string &name)
+{
+    if(filter == nullptr)
+        return true;
+    for(const char *text = filter;; text++)
+    {
+        const char *end = strchr(text, ',');
+        size_t      size = end ? (size_t)(end - text) : strlen(text);
+        if(size > 0 && name.find(text, 0, size) != std::string::npos)
+            return true;
+        if(end == nullptr)
+            return false;
+        text = end;
+    }
+}
+
+bool Write(const char *dir, const Case &c, const std::vector<float> &render)
+{
+    std::string         path = CasePath(dir, c);
+    daisybed::WavWriter wav;
+    bool ok = wav.Open(path.c_str(), (uint32_t)kSampleRate, 2)
+              && wav.Write(render.data(), kFrames);
+    wav.Close();
+    printf("%-14s %-12s %s %s\n", c.engine, c.stimulus, ok ? "wrote" : "can't write", path.c_str());
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: golden-render --write dir\n"
+                "       golden-render --check dir [--snr-db x] [--lsd-db y] "
+                "[--filter a,b...]\n");
+        return 2;
+    }
+
+    if(options.check)
+    {
+        struct stat dir;
+        if(stat(options.check, &dir) != 0 || !S_ISDIR(dir.st_mode))
+        {
+            printf("FAIL: no references at %s; write them with --write %s\n",
+                   options.check,
+                   options.check);
+            return 1;
+        }
+        if(options.snr_db >= 0. || options.lsd_db >= 0.)
+            printf("tolerance: SNR >= %g dB, log-spectral distance <= %g dB\n",
+                   options.snr_db >= 0. ? options.snr_db : -INFINITY,
+                   options.lsd_db >= 0. ? options.lsd_db : INFINITY);
+        else
+            printf("bit-exact\n");
+        printf("%-14s %-12s %-4s %9s %11s %9s %8s\n",
+               "engine",
+               "stimulus",
+               "",
+               "differing",
+               "max diff",
+               "SNR dB",
+               "LSD dB");
+    }
+
+    int failures = 0;
+    for(const Case &c : kCases)
+    {
+        if(!Selected(options.filter, std::string(c.engine) + "-" + c.stimulus))
+            continue;
+        std::vector<float> render = c.render(c.stimulus);
+        bool               ok     = options.write ? Write(options.write, c, render)
+                                                  : Check(options, c, render);
+        failures += ok ? 0 : 1;
+    }
+    if(failures > 0)
+    {
+        printf("%d case%s failed\n", failures, failures == 1 ? "" : "s");
+        return 1;
+    }
+    return 0;
+}
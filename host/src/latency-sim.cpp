@@ -0,0 +1,169 @@
+// Predicts MIDI note-on to sound latency for a set of audio configurations
+// before flashing anything. It simulates the firmware pipeline described in
+// shared/AudioConfig.h and measures it with the LatencyProbe the firmware
+// runs in its latency test mode:
+//
+//   note-on's last byte arrives at a random time
+//   the UART notices the end of the message one idle byte later
+//   the next control-period MIDI poll moves it to the audio side, starting
+//   up to --poll-late-us after it fell due behind other main-loop tasks
+//   the next callback after that renders the note from its first sample
+//   the probe adds the output delay (one block + codec) to that sample
+//
+//   latency-sim [--block 4,16,48] [--poll-us 1000] [--poll-late-us 1100]
+//               [--notes n] [--seed n]
+//
+// The poll task runs off the microsecond timer and the callbacks off the
+// codec clock, so their relative phase drifts; each note gets a random one,
+// and a random lateness for its poll. The default lateness is
+// basic-monosynth's (see its AUDIO_CONFIG); 0 models a main loop with
+// nothing else to run.
+//
+// For each block size it prints the simulated distribution next to the
+// AudioConfig model's best and worst case.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "AudioConfig.h"
+#include "AudioSpan.h"
+#include "LatencyProbe.h"
+
+namespace
+{
+struct Options
+{
+    std::vector<size_t> blocks  = {4, 16, 48};
+    float               poll_us      = 1000.f;
+    float               poll_late_us = 1100.f;
+    uint32_t            notes        = 10000;
+    uint32_t            seed    = 1;
+};
+
+struct Lcg
+{
+    uint32_t state;
+    // Uniform in [0, 1).
+    double Uniform()
+    {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0;
+    }
+};
+
+// Runs `notes` simulated note-ons through one configuration.
+const daisybed::LatencyStats &Simulate(const daisybed::AudioConfig &config,
+                                     const Options               &options,
+                                     daisybed::LatencyProbe      &probe)
+{
+    const double block_us = config.BlockUs();
+    const double poll_us  = config.ControlPeriodUs();
+
+    Lcg                rng = {options.seed};
+    std::vector<float> silent(config.block_size, 0.f), sounding(config.block_size, 0.5f);
+    probe.Init(config);
+
+    double now = 0.;
+    for(uint32_t note = 0; note < options.notes; note++)
+    {
+        // Notes well apart, at a random phase against blocks and polls.
+        double arrival = now + 50000. + rng.Uniform() * 50000.;
+        double parsed  = arrival + daisybed::AudioConfig::kMidiByteUs;
+
+        // Next poll due at or after the parse, and when it gets to run.
+        double poll = parsed + rng.Uniform() * poll_us + rng.Uniform() * config.poll_late_us;
+
+        probe.MarkArrival((uint32_t)arrival);
+
+        // Every callback from the arrival on goes through the probe; the
+        // first one to start after the poll is the one that sounds.
+        double callback = block_us * ((long long)(arrival / block_us) + 1);
+        while(probe.IsArmed())
+        {
+            bool         sounds = callback > poll;
+            const float *data   = sounds ? sounding.data() : silent.data();
+            const float *out[2] = {data, data};
+            probe.ProcessBlock((uint32_t)callback,
+                               daisybed::ViewStereo(out, config.block_size));
+            callback += block_us;
+        }
+        now = callback;
+    }
+    return probe.GetStats();
+}
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--block") == 0)
+        {
+            options.blocks.clear();
+            for(char *token = strtok(argv[i + 1], ","); token; token = strtok(nullptr, ","))
+                options.blocks.push_back((size_t)atoi(token));
+        }
+        else if(strcmp(argv[i], "--poll-us") == 0)
+            options.poll_us = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--poll-late-us") == 0)
+            options.poll_late_us = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--notes") == 0)
+            options.notes = (uint32_t)atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--seed") == 0)
+            options.seed = (uint32_t)atoi(argv[i + 1]);
+        else
+            return false;
+    }
+    for(size_t block : options.blocks)
+        if(block == 0)
+            return false;
+    return argc % 2 == 1 && !options.blocks.empty() && options.poll_us > 0.f
+           && options.poll_late_us >= 0.f && options.notes > 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: latency-sim [--block 4,16,48] [--poll-us 1000] "
+                "[--poll-late-us 1100] [--notes n] [--seed n]\n");
+        return 2;
+    }
+
+    // The probe's histogram is a few KB; keep it off the stack.
+    static daisybed::LatencyProbe probe;
+
+    printf("%u notes per config, codec delay %.0f us, polls up to %.0f us late\n",
+           options.notes,
+           daisybed::kCodecDelayUs,
+           options.poll_late_us);
+    printf("block  poll every  model best..worst us |    min    p50    p95    p99    max   mean\n");
+    for(size_t block : options.blocks)
+    {
+        daisybed::AudioConfig config = daisybed::kDefaultAudioConfig;
+        config.block_size            = block;
+        config.poll_late_us          = options.poll_late_us;
+        config.control_divisor       = (uint32_t)(options.poll_us / config.BlockUs() + 0.5f);
+        if(config.control_divisor == 0)
+            config.control_divisor = 1;
+
+        const daisybed::LatencyStats &stats = Simulate(config, options, probe);
+        printf("%5zu  %3u blocks  %8.0f..%-8.0f  | %6u %6u %6u %6u %6u %6.0f\n",
+               block,
+               config.control_divisor,
+               config.BestMidiLatencyUs(),
+               config.WorstMidiLatencyUs(),
+               stats.GetMinUs(),
+               stats.GetPercentileUs(0.5f),
+               stats.GetPercentileUs(0.95f),
+               stats.GetPercentileUs(0.99f),
+               stats.GetMaxUs(),
+               stats.GetMeanUs());
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+// Prints every firmware's memory plan (projects/<name>/src/memory-plan.h):
+// per region, the planned bytes against the budget and the objects placed
+// there.
+//
+//   memory-plan
+//
+// Sizes come from this host build. The engines are nearly all float arrays,
+// so they match the board to within the odd pointer (8 bytes here, 4 there);
+// the static_asserts in the firmware build check the board's own sizes.
+
+#include <stdio.h>
+
+#include "../../projects/awful-paraphonic-synth/src/memory-plan.h"
+#include "../../projects/basic-monosynth/src/memory-plan.h"
+#include "../../projects/cinematic-verb/src/memory-plan.h"
+
+int main()
+{
+    auto print = [](const char *line) { puts(line); };
+    daisybed::ReportMemoryPlan("basic-monosynth", MONOSYNTH_MEMORY_PLAN, print);
+    daisybed::ReportMemoryPlan("cinematic-verb", kCinematicVerbMemoryPlan, print);
+    daisybed::ReportMemoryPlan("awful-paraphonic-synth", kParaphonicMemoryPlan, print);
+    return 0;
+}
@@ -0,0 +1,382 @@
+// Floods basic-monosynth's MIDI path with synthetic traffic and measures what
+// it costs the audio callback. Every scenario goes through the same steps as
+// the firmware: bytes into a parser, channel messages into the 256-entry
+// SpscQueue, and the callback drains the queue into SynthEngine::HandleMidi
+// (VoiceBank's retrigger check, voice scans and ageing) before rendering.
+//
+//   midi-flood [--seconds s] [--scenario name]
+//
+// Scenarios, one 48-sample block (1 ms) of traffic at a time:
+//
+//   cluster         all 128 notes on in one block, off 25 ms later, 20x/s
+//   arp             a note-on and the previous note's note-off every 1 ms
+//   cc-storm        three CCs on all 16 channels every block, 4 notes held
+//   running-status  cluster and arp traffic with running status, note-offs
+//                   as velocity 0 and a MIDI clock byte between messages
+//
+// Most of this is more than a DIN wire carries (about 1000 three-byte
+// messages a second); USB MIDI, or a bug upstream, can deliver it.
+//
+// For each scenario it prints events handled per second of handling time,
+// the worst single HandleMidi call and the worst block's worth, and the
+// callback (drain + render): its mean and worst block, how much the flood
+// inflates the mean over an idle baseline with every voice sounding, and
+// the worst drain as a share of the block period. The worst callback also
+// catches the host's scheduling noise; the worst drain is the MIDI path's
+// own. Queue drops are counted; the firmware loses the same messages.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "AudioSpan.h"
+#include "SpscQueue.h"
+#include "SynthEngine.h"
+
+namespace
+{
+constexpr float  kSampleRate = 48000.f;
+constexpr size_t kBlockSize  = 48;
+
+using Clock = std::chrono::steady_clock;
+
+inline double Nanos(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// As basic-monosynth queues a message for the callback.
+struct MidiBytes
+{
+    uint8_t status;
+    uint8_t data0;
+    uint8_t data1;
+};
+
+// Byte-level channel message parser with running status, standing in for
+// libDaisy's MidiParser: real-time bytes pass through without disturbing
+// it, system common messages cancel it.
+class MidiByteParser
+{
+  public:
+    bool Parse(uint8_t byte, MidiBytes &out)
+    {
+        if(byte >= 0xF8)
+            return false;
+        if(byte >= 0xF0)
+        {
+            running_ = 0;
+            return false;
+        }
+        if(byte & 0x80)
+        {
+            running_ = byte;
+            count_   = 0;
+            return false;
+        }
+        if(running_ == 0)
+            return false;
+
+        data_[count_++] = byte;
+        uint8_t type    = running_ & 0xF0;
+        int     needed  = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+        if(count_ < needed)
+            return false;
+        out    = {running_, data_[0], needed == 2 ? data_[1] : (uint8_t)0};
+        count_ = 0;
+        return true;
+    }
+
+  private:
+    uint8_t running_ = 0;
+    uint8_t data_[2];
+    int     count_ = 0;
+};
+
+// Writes channel messages as MIDI bytes, optionally with running status.
+class MidiWriter
+{
+  public:
+    MidiWriter(std::vector<uint8_t> &bytes, bool running_status)
+    : bytes_(bytes), running_status_(running_status)
+    {
+    }
+
+    void Message(uint8_t status, uint8_t data0, uint8_t data1)
+    {
+        if(running_status_)
+        {
+            // Note-off as a zero-velocity note-on, so it can share the status.
+            if((status & 0xF0) == 0x80)
+            {
+                status = 0x90 | (status & 0x0F);
+                data1  = 0;
+            }
+            if(status != last_status_)
+                bytes_.push_back(status);
+            bytes_.push_back(data0);
+            bytes_.push_back(data1);
+            bytes_.push_back(0xF8); // clock tick mid-stream
+        }
+        else
+        {
+            bytes_.push_back(status);
+            bytes_.push_back(data0);
+            bytes_.push_back(data1);
+        }
+        last_status_ = status;
+    }
+    void NoteOn(uint8_t note, uint8_t velocity) { Message(0x90, note, velocity); }
+    void NoteOff(uint8_t note) { Message(0x80, note, 64); }
+
+  private:
+    std::vector<uint8_t> &bytes_;
+    bool                  running_status_;
+    uint8_t               last_status_ = 0;
+};
+
+void Cluster(size_t block, MidiWriter &midi)
+{
+    size_t phase = block % 50;
+    if(phase == 0)
+        for(int note = 0; note < 128; note++)
+            midi.NoteOn((uint8_t)note, 100);
+    else if(phase == 25)
+        for(int note = 0; note < 128; note++)
+            midi.NoteOff((uint8_t)note);
+}
+
+void Arp(size_t block, MidiWriter &midi)
+{
+    // Up and down four octaves of a minor seventh chord.
+    static const uint8_t kSteps[] = {0, 3, 7, 10};
+    auto note = [](size_t step) {
+        size_t cycle = step % 32;
+        size_t index = cycle < 16 ? cycle : 31 - cycle;
+        return (uint8_t)(36 + 12 * (index / 4) + kSteps[index % 4]);
+    };
+    if(block > 0)
+        midi.NoteOff(note(block - 1));
+    midi.NoteOn(note(block), 90);
+}
+
+void CcStorm(size_t block, MidiWriter &midi)
+{
+    if(block == 0)
+        for(uint8_t note : {48, 55, 60, 64})
+            midi.NoteOn(note, 100);
+    for(uint8_t channel = 0; channel < 16; channel++)
+    {
+        uint8_t value = (uint8_t)((block + channel * 8) & 0x7F);
+        midi.Message(0xB0 | channel, 1, value);
+        midi.Message(0xB0 | channel, 74, value);
+        midi.Message(0xB0 | channel, 7, 127 - value);
+    }
+}
+
+void RunningStatus(size_t block, MidiWriter &midi)
+{
+    Cluster(block, midi);
+    Arp(block, midi);
+}
+
+struct Scenario
+{
+    const char *name;
+    void (*traffic)(size_t block, MidiWriter &midi);
+    bool running_status;
+};
+
+const Scenario kScenarios[] = {
+    {"cluster", Cluster, false},
+    {"arp", Arp, false},
+    {"cc-storm", CcStorm, false},
+    {"running-status", RunningStatus, true},
+};
+
+struct Result
+{
+    size_t   blocks            = 0;
+    uint64_t events            = 0;
+    uint64_t drops             = 0;
+    double   handle_ns         = 0.; // every queue drain
+    double   worst_event_ns    = 0.; // one HandleMidi call
+    double   worst_drain_ns    = 0.; // one block's drain
+    double   callback_ns       = 0.; // drain + render, every block
+    double   worst_callback_ns = 0.;
+};
+
+std::unique_ptr<daisybed::SynthEngine> MakeEngine()
+{
+    std::unique_ptr<daisybed::SynthEngine> engine(new daisybed::SynthEngine());
+    engine->Init(kSampleRate);
+    // Long decays, so the voices a scenario starts keep sounding and the
+    // render side of the callback stays at its worst.
+    engine->voices.SetAttack(0.005f);
+    engine->voices.SetDecay(30.f);
+    return engine;
+}
+
+// Every voice sounding, no MIDI: what the callback costs without the flood.
+Result Baseline(size_t blocks)
+{
+    auto engine = MakeEngine();
+    for(int v = 0; v < daisybed::SynthEngine::NUM_VOICES; v++)
+        engine->HandleMidi(0x90, (uint8_t)(48 + v), 100);
+
+    float  left[kBlockSize], right[kBlockSize];
+    float *out[2] = {left, right};
+    Result result;
+    for(size_t block = 0; block < blocks; block++)
+    {
+        auto start = Clock::now();
+        engine->ProcessBlock(daisybed::ViewStereo(out, kBlockSize));
+        double ns = Nanos(start, Clock::now());
+        result.callback_ns += ns;
+        if(ns > result.worst_callback_ns)
+            result.worst_callback_ns = ns;
+    }
+    result.blocks = blocks;
+    return result;
+}
+
+Result Run(const Scenario &scenario, size_t blocks)
+{
+    auto engine = MakeEngine();
+    // Static like the firmware's; reset by draining at the end of each run.
+    static daisybed::SpscQueue<MidiBytes, 256> queue;
+    MidiByteParser                             parser;
+    std::vector<uint8_t>                       bytes;
+    MidiWriter                                 writer(bytes, scenario.running_status);
+
+    float  left[kBlockSize], right[kBlockSize];
+    float *out[2] = {left, right};
+    Result result;
+    for(size_t block = 0; block < blocks; block++)
+    {
+        // Main loop: this block's bytes through the parser into the queue.
+        bytes.clear();
+        scenario.traffic(block, writer);
+        for(uint8_t byte : bytes)
+        {
+            MidiBytes m;
+            if(!parser.Parse(byte, m))
+                continue;
+            uint8_t type = m.status & 0xF0;
+            if(type != 0x80 && type != 0x90 && type != 0xB0)
+                continue;
+            if(!queue.Push(m))
+                result.drops++;
+        }
+
+        // Audio callback: drain, then render.
+        auto      start = Clock::now();
+        auto      last  = start;
+        MidiBytes m;
+        while(queue.Pop(m))
+        {
+            engine->HandleMidi(m.status, m.data0, m.data1);
+            auto   now = Clock::now();
+            double ns  = Nanos(last, now);
+            if(ns > result.worst_event_ns)
+                result.worst_event_ns = ns;
+            last = now;
+            result.events++;
+        }
+        double drain_ns = Nanos(start, last);
+        engine->ProcessBlock(daisybed::ViewStereo(out, kBlockSize));
+        double callback_ns = Nanos(start, Clock::now());
+
+        result.handle_ns += drain_ns;
+        result.callback_ns += callback_ns;
+        if(drain_ns > result.worst_drain_ns)
+            result.worst_drain_ns = drain_ns;
+        if(callback_ns > result.worst_callback_ns)
+            result.worst_callback_ns = callback_ns;
+    }
+    result.blocks = blocks;
+    return result;
+}
+
+struct Options
+{
+    float       seconds  = 10.f;
+    const char *scenario = nullptr;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--seconds") == 0)
+            options.seconds = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--scenario") == 0)
+            options.scenario = argv[i + 1];
+        else
+            return false;
+    }
+    if(options.scenario)
+    {
+        bool known = false;
+        for(const Scenario &scenario : kScenarios)
+            known |= strcmp(scenario.name, options.scenario) == 0;
+        if(!known)
+            return false;
+    }
+    return argc % 2 == 1 && options.seconds > 0.f;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: midi-flood [--seconds s] "
+                "[--scenario cluster|arp|cc-storm|running-status]\n");
+        return 2;
+    }
+
+    size_t blocks    = (size_t)(options.seconds * kSampleRate / kBlockSize);
+    double budget_ns = kBlockSize * 1e9 / kSampleRate;
+
+    Result baseline      = Baseline(blocks);
+    double baseline_mean = baseline.callback_ns / baseline.blocks;
+    printf("%zu blocks of %zu per scenario; idle callback with %d voices: "
+           "mean %.2f us, worst %.2f us (budget %.0f us)\n",
+           blocks,
+           kBlockSize,
+           daisybed::SynthEngine::NUM_VOICES,
+           baseline_mean * 1e-3,
+           baseline.worst_callback_ns * 1e-3,
+           budget_ns * 1e-3);
+    printf("scenario           events  Mevents/s  worst event  worst drain"
+           "  callback mean   worst  inflation  drain/budget  drops\n");
+
+    for(const Scenario &scenario : kScenarios)
+    {
+        if(options.scenario && strcmp(scenario.name, options.scenario) != 0)
+            continue;
+        Result result = Run(scenario, blocks);
+        double mean   = result.callback_ns / result.blocks;
+        printf("%-16s %8llu  %9.2f  %8.0f ns  %8.2f us  %10.2f us  %6.2f"
+               "  %8.1f%%  %11.2f%%  %5llu\n",
+               scenario.name,
+               (unsigned long long)result.events,
+               result.handle_ns > 0. ? result.events / result.handle_ns * 1e3 : 0.,
+               result.worst_event_ns,
+               result.worst_drain_ns * 1e-3,
+               mean * 1e-3,
+               result.worst_callback_ns * 1e-3,
+               100. * (mean / baseline_mean - 1.),
+               100. * result.worst_drain_ns / budget_ns,
+               (unsigned long long)result.drops);
+    }
+    return 0;
+}
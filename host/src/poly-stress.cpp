@@ -0,0 +1,184 @@
+// Load test for the basic-monosynth voice code at polyphony the board can't
+// reach: ThreadedSynth with 16 x 32 = 512 voices, kept near a target number
+// of sounding voices by a deterministic note generator, rendered once per
+// thread count.
+//
+//   poly-stress [--voices n] [--threads 1,2,4,...] [--seconds s] [--out file.wav]
+//
+// For each thread count it reports time per block, realtime factor, speedup
+// over one thread and scaling efficiency (speedup / threads), plus the
+// largest difference from the one-thread render, which should only ever be
+// float rounding from the different summation order.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "Denormals.h"
+#include "ThreadedSynth.h"
+#include "WavFile.h"
+
+namespace
+{
+constexpr float  kSampleRate = 48000.f;
+constexpr size_t kBlockSize  = 48;
+
+using Synth = daisybed::ThreadedSynth<32>;
+
+struct Options
+{
+    int              voices  = 256;
+    std::vector<int> threads = {1, 2, 4, 8};
+    float            seconds = 10.f;
+    const char      *out     = nullptr;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--voices") == 0 && i + 1 < argc)
+            options.voices = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            options.seconds = (float)atof(argv[++i]);
+        else if(strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            options.out = argv[++i];
+        else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options.threads.clear();
+            for(char *p = argv[++i]; *p;)
+            {
+                char *end;
+                long  n = strtol(p, &end, 10);
+                if(end == p || n < 1)
+                    return false;
+                options.threads.push_back((int)n);
+                p = *end == ',' ? end + 1 : end;
+            }
+        }
+        else
+            return false;
+    }
+    return options.voices >= 1 && options.voices <= Synth::kTotalVoices
+           && options.seconds > 0.f && !options.threads.empty();
+}
+
+// Cheap deterministic noise so every thread count plays the same notes.
+struct Lcg
+{
+    uint32_t state = 0x12345678u;
+    uint32_t Next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+};
+
+struct Run
+{
+    double             seconds;
+    double             mean_active;
+    std::vector<float> audio;
+};
+
+// Keeps roughly `target` voices sounding: notes with random channel, pitch
+// and velocity are started until the count is reached, and held ones are
+// released at random so the allocator sees a steady churn of note-ons,
+// note-offs and steals.
+Run Render(int threads, const Options &options)
+{
+    daisybed::ScopedFlushDenormals ftz;
+    std::unique_ptr<Synth>         synth(new Synth);
+    synth->Init(kSampleRate, kBlockSize, threads);
+    synth->SetDecay(2.f);
+
+    const size_t blocks = (size_t)(options.seconds * kSampleRate / kBlockSize);
+    Run          run;
+    run.audio.assign(blocks * kBlockSize, 0.f);
+    run.seconds     = 0.0;
+    run.mean_active = 0.0;
+
+    Lcg rng;
+    for(size_t block = 0; block < blocks; block++)
+    {
+        int active = synth->GetActiveCount();
+        for(int attempts = 0; active < options.voices && attempts < 64; attempts++)
+        {
+            uint32_t r = rng.Next();
+            synth->HandleMidi(0x90 | (r & 0x0F), 24 + (r >> 4) % 84, 40 + (r >> 12) % 88);
+            active = synth->GetActiveCount();
+        }
+        uint32_t r = rng.Next();
+        synth->HandleMidi(0x80 | (r & 0x0F), 24 + (r >> 4) % 84, 0);
+        run.mean_active += active;
+
+        auto start = std::chrono::steady_clock::now();
+        synth->ProcessBlock(&run.audio[block * kBlockSize], kBlockSize);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        run.seconds += elapsed.count();
+    }
+    run.mean_active /= blocks;
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: poly-stress [--voices n<=%d] [--threads 1,2,4,...] "
+                "[--seconds s] [--out file.wav]\n",
+                Synth::kTotalVoices);
+        return 2;
+    }
+
+    printf("%d-voice target, %.1f s, blocks of %zu\n", options.voices, options.seconds, kBlockSize);
+    printf("threads  active  us/block  realtime  speedup  efficiency  max diff\n");
+
+    // Speedup and efficiency are relative to the first thread count, so
+    // list 1 first.
+    Run reference;
+    for(int threads : options.threads)
+    {
+        Run run = Render(threads, options);
+        if(reference.audio.empty())
+            reference = run;
+        float max_diff = 0.f;
+        for(size_t i = 0; i < run.audio.size(); i++)
+            max_diff = fmaxf(max_diff, fabsf(run.audio[i] - reference.audio[i]));
+
+        double blocks  = run.audio.size() / (double)kBlockSize;
+        double speedup = reference.seconds / run.seconds;
+        double scale   = (double)threads / options.threads.front();
+        printf("%7d  %6.0f  %8.1f  %7.1fx  %6.2fx  %9.0f%%  %.2g\n",
+               threads,
+               run.mean_active,
+               run.seconds * 1e6 / blocks,
+               options.seconds / run.seconds,
+               speedup,
+               100.0 * speedup / scale,
+               max_diff);
+    }
+
+    if(options.out)
+    {
+        daisybed::WavWriter wav;
+        std::vector<float>  stereo(reference.audio.size() * 2);
+        for(size_t i = 0; i < reference.audio.size(); i++)
+            stereo[2 * i] = stereo[2 * i + 1] = reference.audio[i];
+        if(!wav.Open(options.out, (uint32_t)kSampleRate, 2)
+           || !wav.Write(stereo.data(), reference.audio.size()))
+        {
+            fprintf(stderr, "%s: can't write\n", options.out);
+            return 1;
+        }
+    }
+    return 0;
+}
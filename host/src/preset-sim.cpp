@@ -0,0 +1,279 @@
+// Runs PresetStore (shared/PresetStore.h) against a file-backed flash image
+// and checks that it survives what the board can do to it: how long a save
+// holds the main loop, how evenly it wears the sectors, and what a power cut
+// or a flipped bit leaves behind.
+//
+//   preset-sim [--image path] [--saves n] [--sectors n]
+//
+// Steps run every 10 ms, as basic-monosynth's task does, and a sector erase
+// runs on in the chip between them. That is the store's side of it: on the
+// board QspiFlash still waits out each erase in StartErase(), so there the
+// erase step lasts the erase. Three runs over the same image file, each
+// from blank:
+//   wear       --saves snapshots back to back, rebooting (reopening the file)
+//              after each and checking the load; reports the steps and flash
+//              time per save, the longest single step and erases per sector.
+//              The longest step must stay under 5 ms, a note-on's budget,
+//              and nothing may touch the flash while it erases.
+//   power cut  the power is cut during every erase and program of a save, over
+//              enough saves to wrap the region twice; after the reboot the load
+//              must be the previous snapshot or the new one, and a retried save
+//              must then load.
+//   bit flip   a bit of the newest snapshot is flipped; the reboot must load
+//              the one before it, and the next save must skip the bad slot.
+//
+// Exits 1 if any check fails.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FileFlash.h"
+#include "PresetStore.h"
+#include "SynthEngine.h"
+
+namespace
+{
+using daisybed::FileFlash;
+using daisybed::SynthSnapshot;
+constexpr size_t   kSlotSize     = 256;   // basic-monosynth's
+constexpr uint32_t kStepPeriodUs = 10000; // and its task's period
+constexpr uint32_t kMaxStepUs    = 5000;
+typedef daisybed::PresetStore<FileFlash, kSlotSize> Store;
+
+struct Lcg
+{
+    uint32_t state;
+    uint32_t Next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+};
+
+// A distinct, reproducible snapshot per n.
+SynthSnapshot MakeSnapshot(uint32_t n)
+{
+    SynthSnapshot snapshot;
+    Lcg           rng = {n * 2654435761u + 1};
+    for(int f = 0; f < SynthSnapshot::NUM_FIELDS; f++)
+        snapshot.values[f] = (float)(rng.Next() % 10000) / 10000.f;
+    snapshot.values[SynthSnapshot::WAVEFORM] = (float)(n % 4);
+    return snapshot;
+}
+
+bool Same(const SynthSnapshot &a, const SynthSnapshot &b)
+{
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// The flash and store as the firmware has them after a (re)boot.
+struct Board
+{
+    const char *image;
+    uint32_t    sectors;
+    FileFlash   flash;
+    Store       store;
+
+    bool Boot()
+    {
+        if(!flash.Open(image, sectors))
+            return false;
+        store.Init(&flash, 0, sectors);
+        return true;
+    }
+
+    bool Load(SynthSnapshot &out) { return store.Load(out, SynthSnapshot::VERSION); }
+};
+
+struct SaveTiming
+{
+    uint32_t steps;
+    uint64_t flash_us;
+    uint32_t worst_step_us;
+};
+
+// Runs a save to completion (or until the power goes) the way the scheduler
+// task does, one Step() at a time.
+bool Save(Board &board, const SynthSnapshot &snapshot, SaveTiming *timing = nullptr)
+{
+    if(!board.store.BeginSave(snapshot, SynthSnapshot::VERSION))
+        return false;
+    uint32_t saves = board.store.GetStats().saves;
+    bool     more  = true;
+    while(more)
+    {
+        uint64_t before = board.flash.ElapsedUs();
+        more            = board.store.Step();
+        uint32_t step   = (uint32_t)(board.flash.ElapsedUs() - before);
+        if(timing)
+        {
+            timing->steps++;
+            timing->flash_us += step;
+            if(step > timing->worst_step_us)
+                timing->worst_step_us = step;
+        }
+        board.flash.Wait(kStepPeriodUs);
+    }
+    return board.store.GetStats().saves == saves + 1;
+}
+
+struct Options
+{
+    const char *image   = "preset-sim.img";
+    int         saves   = 1000;
+    int         sectors = 8;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--image") == 0)
+            options.image = argv[i + 1];
+        else if(strcmp(argv[i], "--saves") == 0)
+            options.saves = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--sectors") == 0)
+            options.sectors = atoi(argv[i + 1]);
+        else
+            return false;
+    }
+    return argc % 2 == 1 && options.saves > 0 && options.sectors >= 2;
+}
+
+int failures = 0;
+
+void Fail(const char *run, uint32_t n, const char *what)
+{
+    if(failures++ < 10)
+        printf("  FAIL %s, snapshot %u: %s\n", run, n, what);
+}
+
+void RunWear(Board &board, int saves)
+{
+    remove(board.image);
+    if(!board.Boot())
+    {
+        Fail("wear", 0, "can't open the image");
+        return;
+    }
+
+    SaveTiming timing = {};
+    for(int n = 1; n <= saves; n++)
+    {
+        SynthSnapshot snapshot = MakeSnapshot(n), loaded;
+        if(!Save(board, snapshot, &timing))
+            Fail("wear", n, "save did not verify");
+        if(!board.Boot() || !board.Load(loaded) || !Same(loaded, snapshot))
+            Fail("wear", n, "reboot did not load it");
+    }
+
+    const std::vector<uint32_t> &erases = board.flash.SectorErases();
+    uint32_t                     least = erases[0], most = erases[0];
+    for(uint32_t e : erases)
+    {
+        least = e < least ? e : least;
+        most  = e > most ? e : most;
+    }
+    printf("wear: %d saves, %.2f steps and %.1f ms of flash each, longest step %.1f ms\n",
+           saves,
+           (double)timing.steps / saves,
+           timing.flash_us / 1000.0 / saves,
+           timing.worst_step_us / 1000.0);
+    printf("      %zu sectors erased %u..%u times each\n", erases.size(), least, most);
+    if(timing.worst_step_us > kMaxStepUs)
+        Fail("wear", 0, "a step held the main loop for more than 5 ms");
+    if(board.flash.BusyErrors() > 0)
+        Fail("wear", 0, "the flash was programmed or read while it erased");
+}
+
+void RunPowerCuts(Board &board)
+{
+    remove(board.image);
+    board.Boot();
+
+    // Each save is cut at its first flash operation, then (after the reboot)
+    // at its second, and so on until one gets through uncut.
+    const uint32_t slots = board.sectors * (FileFlash::kSectorSize / kSlotSize);
+    uint32_t       cuts  = 0;
+    SynthSnapshot  previous;
+    bool           has_previous = false;
+    for(uint32_t n = 1; n <= 2 * slots + 2; n++)
+    {
+        SynthSnapshot snapshot = MakeSnapshot(n), loaded;
+        for(uint32_t op = 1; op <= 8; op++)
+        {
+            board.flash.CutPower(op);
+            bool saved = Save(board, snapshot);
+            bool cut   = !board.flash.IsPowered();
+            if(!board.Boot())
+            {
+                Fail("power cut", n, "can't reopen the image");
+                return;
+            }
+            bool ok = board.Load(loaded);
+            if(has_previous ? !ok || (!Same(loaded, previous) && !Same(loaded, snapshot))
+                            : ok && !Same(loaded, snapshot))
+                Fail("power cut", n, "reboot lost both snapshots");
+            if(!cut)
+            {
+                if(!saved || !ok || !Same(loaded, snapshot))
+                    Fail("power cut", n, "uncut save did not load");
+                break;
+            }
+            cuts++;
+        }
+        previous     = snapshot;
+        has_previous = true;
+    }
+    printf("power cut: %u saves cut short, every reboot loaded the old or new snapshot\n",
+           cuts);
+}
+
+void RunBitFlip(Board &board)
+{
+    remove(board.image);
+    board.Boot();
+
+    // From blank, saves fill slots 0, 1, 2... in order.
+    SynthSnapshot first = MakeSnapshot(1), second = MakeSnapshot(2), third = MakeSnapshot(3);
+    SynthSnapshot loaded;
+    Save(board, first);
+    Save(board, second);
+    board.flash.FlipBit(kSlotSize + 20, 3); // in the second's payload
+    board.Boot();
+    if(!board.Load(loaded) || !Same(loaded, first))
+        Fail("bit flip", 2, "reboot did not fall back to the previous snapshot");
+    if(!Save(board, third) || !board.Boot() || !board.Load(loaded) || !Same(loaded, third))
+        Fail("bit flip", 3, "the save after it did not load");
+    printf("bit flip: fell back to the previous snapshot, next save skipped the slot\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: preset-sim [--image path] [--saves n] [--sectors n]\n");
+        return 2;
+    }
+
+    Board board;
+    board.image   = options.image;
+    board.sectors = (uint32_t)options.sectors;
+
+    RunWear(board, options.saves);
+    RunPowerCuts(board);
+    RunBitFlip(board);
+    board.flash.Close();
+    remove(options.image);
+
+    if(failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,413 @@
+// Replays a control trace captured from a firmware built with
+// -DDAISYBED_TRACE=ON through the same engine code on the host, writes the
+// render to a WAV file and reports how long it took.
+//
+//   replay <trace.bin> [out.wav] [--tail seconds] [--impulse]
+//
+// Capture the trace by dumping the board's USB serial port to a file, e.g.
+//   cat /dev/ttyACM0 > trace.bin
+// A capture started after boot is replayed from the first resync header in it
+// (about a second in), from the engine's defaults plus the re-sent knobs and
+// settings; only a capture from boot reproduces the board bit-exactly.
+//
+// The cinematic-verb's audio input isn't part of the trace; it is replayed
+// with silence, or a single unit impulse at the start with --impulse.
+//
+// Afterwards it prints the engine's stage meters (peak, RMS, clips, NaN/Inf
+// resets) for the replayed render, next to the readings the board itself
+// sent in the trace.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "AudioSpan.h"
+#include "Denormals.h"
+#include "ParaphonicSynth.h"
+#include "ShimmerVerb.h"
+#include "SynthEngine.h"
+#include "TraceStream.h"
+#include "WavFile.h"
+
+namespace
+{
+struct Options
+{
+    const char *trace_path   = nullptr;
+    const char *output_path  = "replay.wav";
+    float       tail_seconds = 0.f;
+    bool        impulse      = false;
+};
+
+// Each replayer applies one block's records, then renders that block.
+struct MonosynthReplayer
+{
+    static constexpr int kNumMeters = daisybed::SynthEngine::NUM_METERS;
+
+    daisybed::SynthEngine   engine;
+    daisybed::SynthControls controls = {};
+    // A loaded preset arrives as one kConfig record per field. A resync
+    // (a block with a header record) re-sends the sounding one.
+    daisybed::SynthSnapshot preset        = {};
+    int                     preset_fields = 0;
+    bool                    resync        = false;
+
+    void Init(float sample_rate) { engine.Init(sample_rate); }
+    void Apply(const daisybed::TraceRecord &r)
+    {
+        switch(r.Kind())
+        {
+            case daisybed::TraceKind::kHeader: resync = true; break;
+            case daisybed::TraceKind::kLevel:
+                engine.SetQualityLevel((int)r.value);
+                break;
+            case daisybed::TraceKind::kMidi:
+                engine.HandleMidi(r.value & 0xFF, (r.value >> 8) & 0xFF, (r.value >> 16) & 0xFF);
+                break;
+            case daisybed::TraceKind::kEncoder:
+                controls.encoderIncrement = (int32_t)r.value;
+                break;
+            case daisybed::TraceKind::kButton:
+                (r.id == 0 ? controls.button1Rising : controls.button2Rising) = true;
+                break;
+            case daisybed::TraceKind::kKnob:
+                (r.id == 0 ? controls.knob1 : controls.knob2) = r.AsFloat();
+                break;
+            case daisybed::TraceKind::kConfig:
+                if(r.id < daisybed::SynthSnapshot::NUM_FIELDS)
+                {
+                    preset.values[r.id] = r.AsFloat();
+                    preset_fields++;
+                }
+                break;
+            default: break;
+        }
+    }
+    void Render(float *left, float *right, size_t size)
+    {
+        // Applying the preset a resync re-sends would reset the knobs'
+        // pickup, so it is applied only if this engine isn't already there.
+        daisybed::SynthSnapshot sounding;
+        engine.GetSnapshot(sounding);
+        if(preset_fields == daisybed::SynthSnapshot::NUM_FIELDS
+           && (!resync || memcmp(&sounding, &preset, sizeof(preset)) != 0))
+            engine.ApplySnapshot(preset);
+        preset_fields = 0;
+        resync        = false;
+        engine.ProcessControls(controls);
+        // Edges and increments are per block; knob readings persist.
+        controls.encoderIncrement = 0;
+        controls.button1Rising    = false;
+        controls.button2Rising    = false;
+        float *out[2]             = {left, right};
+        engine.ProcessBlock(daisybed::ViewStereo(out, size));
+    }
+};
+
+struct ShimmerReplayer
+{
+    static constexpr int kNumMeters = daisybed::ShimmerVerb::kNumMeters;
+
+    daisybed::ShimmerVerb         engine;
+    daisybed::ShimmerVerbControls controls = {};
+    std::vector<float>            silence, first_block;
+    bool                          impulse = false;
+
+    void Init(float sample_rate) { engine.Init(sample_rate); }
+    void Apply(const daisybed::TraceRecord &r)
+    {
+        if(r.Kind() == daisybed::TraceKind::kLevel)
+            engine.SetQualityLevel((int)r.value);
+        else if(r.Kind() == daisybed::TraceKind::kKnob
+                && r.id < daisybed::ShimmerVerbControls::kNumAdc)
+            controls.adc[r.id] = r.AsFloat();
+        else if(r.Kind() == daisybed::TraceKind::kConfig
+                && r.id == daisybed::ShimmerVerb::kConfigMotion)
+            engine.SetMotion(r.AsFloat() != 0.f);
+    }
+    void Render(float *left, float *right, size_t size)
+    {
+        silence.assign(size, 0.f);
+        const float *input = silence.data();
+        if(impulse)
+        {
+            first_block.assign(size, 0.f);
+            first_block[0] = 1.f;
+            input          = first_block.data();
+            impulse        = false;
+        }
+        const float *in[2]  = {input, input};
+        float       *out[2] = {left, right};
+        engine.ProcessBlock(controls,
+                            daisybed::ViewStereo(in, size),
+                            daisybed::ViewStereo(out, size));
+    }
+};
+
+struct ParaphonicReplayer
+{
+    static constexpr int kNumMeters = daisybed::ParaphonicSynth::kNumMeters;
+
+    daisybed::ParaphonicSynth    engine;
+    daisybed::ParaphonicControls controls = {};
+
+    void Init(float sample_rate)
+    {
+        engine.Init(sample_rate, daisybed::PitchCalibration::Default());
+    }
+    void Apply(const daisybed::TraceRecord &r)
+    {
+        switch(r.Kind())
+        {
+            case daisybed::TraceKind::kKnob:
+            {
+                float *adc[] = {&controls.coarse_knob,
+                                &controls.attack_knob,
+                                &controls.cutoff_knob,
+                                &controls.release_knob,
+                                &controls.voct_raw};
+                if(r.id < 5)
+                    *adc[r.id] = r.AsFloat();
+                break;
+            }
+            case daisybed::TraceKind::kGate:
+                if(r.value != 0
+                   && controls.trigger_count < daisybed::ParaphonicControls::kMaxTriggers)
+                    controls.triggers[controls.trigger_count++] = r.aux;
+                break;
+            case daisybed::TraceKind::kConfig:
+            {
+                daisybed::PitchCalibration cal = engine.GetPitchCv().GetCalibration();
+                if(r.id == daisybed::ParaphonicSynth::kConfigCalibrationOffset)
+                    cal.offset = r.AsFloat();
+                else if(r.id == daisybed::ParaphonicSynth::kConfigCalibrationScale)
+                    cal.scale = r.AsFloat();
+                engine.GetPitchCv().SetCalibration(cal);
+                break;
+            }
+            default: break;
+        }
+    }
+    void Render(float *left, float *right, size_t size)
+    {
+        float *out[2] = {left, right};
+        engine.ProcessBlock(controls, daisybed::ViewStereo(out, size));
+        controls.trigger_count = 0;
+    }
+};
+
+// What the board reported for one meter over the whole trace.
+struct DeviceMeter
+{
+    bool     seen   = false;
+    float    peak   = 0.f;
+    float    rms    = 0.f; // last reading
+    uint32_t clips  = 0;
+    uint32_t faults = 0;
+};
+
+void CollectMeter(const daisybed::TraceRecord &r, std::vector<DeviceMeter> &meters)
+{
+    if(r.id >= meters.size())
+        return;
+    DeviceMeter &meter = meters[r.id];
+    meter.seen         = true;
+    if(r.Kind() == daisybed::TraceKind::kMeterPeak)
+    {
+        meter.peak = fmaxf(meter.peak, r.AsFloat());
+        meter.clips += r.aux;
+    }
+    else
+    {
+        meter.rms    = r.AsFloat();
+        meter.faults = r.aux;
+    }
+}
+
+float ToDb(float level)
+{
+    return level > 0.f ? 20.f * log10f(level) : -INFINITY;
+}
+
+template <typename Replayer>
+void PrintMeters(Replayer &replayer, const std::vector<DeviceMeter> &device)
+{
+    bool any_device = false;
+    for(const DeviceMeter &meter : device)
+        any_device |= meter.seen;
+
+    printf("%-8s %9s %9s %7s %6s", "meter", "peak dB", "rms dB", "clips", "nan");
+    if(any_device)
+        printf("   | board: %9s %9s %7s %6s", "peak dB", "rms dB", "clips", "nan");
+    printf("\n");
+    for(int m = 0; m < Replayer::kNumMeters; m++)
+    {
+        daisybed::MeterReading host = replayer.engine.GetMeter(m).Read();
+        printf("%-8s %9.1f %9.1f %7u %6u",
+               replayer.engine.GetMeterName(m),
+               ToDb(host.peak),
+               ToDb(host.rms),
+               host.clips,
+               host.faults);
+        if(any_device && device[m].seen)
+            printf("   |        %9.1f %9.1f %7u %6u",
+                   ToDb(device[m].peak),
+                   ToDb(device[m].rms),
+                   device[m].clips,
+                   device[m].faults);
+        printf("\n");
+    }
+}
+
+template <typename Replayer>
+int Replay(Replayer                     &replayer,
+           daisybed::TraceReader        &reader,
+           const Options                &options)
+{
+    const float  sample_rate = reader.GetSampleRate();
+    const size_t block_size  = reader.GetBlockSize();
+    const uint32_t traced    = reader.GetLastBlock() + 1;
+    const uint32_t blocks
+        = traced + (uint32_t)(options.tail_seconds * sample_rate / block_size);
+
+    daisybed::WavWriter wav;
+    if(!wav.Open(options.output_path, (uint32_t)sample_rate, 2))
+    {
+        fprintf(stderr, "replay: can't write %s\n", options.output_path);
+        return 1;
+    }
+
+    // Match the firmware: every callback runs with flush-to-zero enabled.
+    daisybed::ScopedFlushDenormals ftz;
+    replayer.Init(sample_rate);
+
+    std::vector<float> left(block_size), right(block_size);
+    std::vector<float> interleaved(block_size * 2);
+    std::chrono::duration<double> render_time(0);
+    uint32_t overflows = 0;
+    std::vector<DeviceMeter> device_meters(Replayer::kNumMeters);
+
+    for(uint32_t block = reader.GetFirstBlock(); block < blocks; block++)
+    {
+        daisybed::TraceRecord record;
+        while(reader.NextInBlock(block, record))
+        {
+            if(record.Kind() == daisybed::TraceKind::kOverflow)
+                overflows += record.value;
+            else if(record.Kind() == daisybed::TraceKind::kMeterPeak
+                    || record.Kind() == daisybed::TraceKind::kMeterRms)
+                CollectMeter(record, device_meters);
+            replayer.Apply(record);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        replayer.Render(left.data(), right.data(), block_size);
+        render_time += std::chrono::steady_clock::now() - start;
+
+        for(size_t i = 0; i < block_size; i++)
+        {
+            interleaved[2 * i]     = left[i];
+            interleaved[2 * i + 1] = right[i];
+        }
+        wav.Write(interleaved.data(), block_size);
+    }
+    wav.Close();
+
+    const uint32_t rendered = blocks - reader.GetFirstBlock();
+    double audio_seconds = (double)rendered * block_size / sample_rate;
+    printf("%u blocks of %zu @ %.0f Hz (%.2f s) -> %s\n",
+           rendered,
+           block_size,
+           sample_rate,
+           audio_seconds,
+           options.output_path);
+    printf("render: %.3f ms, %.1fx realtime, %.1f ns/sample\n",
+           render_time.count() * 1e3,
+           audio_seconds / render_time.count(),
+           render_time.count() * 1e9 / ((double)rendered * block_size));
+    PrintMeters(replayer, device_meters);
+    if(overflows != 0)
+        fprintf(stderr,
+                "replay: %u records were dropped on the device, the render "
+                "will diverge from what the board played\n",
+                overflows);
+    return 0;
+}
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    int positional = 0;
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--tail") == 0 && i + 1 < argc)
+            options.tail_seconds = (float)atof(argv[++i]);
+        else if(strcmp(argv[i], "--impulse") == 0)
+            options.impulse = true;
+        else if(positional == 0)
+            options.trace_path = argv[i], positional++;
+        else if(positional == 1)
+            options.output_path = argv[i], positional++;
+        else
+            return false;
+    }
+    return options.trace_path != nullptr;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: replay <trace.bin> [out.wav] [--tail seconds] [--impulse]\n");
+        return 2;
+    }
+
+    FILE *file = fopen(options.trace_path, "rb");
+    if(!file)
+    {
+        fprintf(stderr, "replay: can't open %s\n", options.trace_path);
+        return 1;
+    }
+    std::vector<uint8_t> data;
+    uint8_t              chunk[4096];
+    size_t               n;
+    while((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        data.insert(data.end(), chunk, chunk + n);
+    fclose(file);
+
+    daisybed::TraceReader reader;
+    if(!reader.Init(data.data(), data.size()) || reader.GetBlockSize() == 0)
+    {
+        fprintf(stderr, "replay: %s is not a daisybed trace\n", options.trace_path);
+        return 1;
+    }
+
+    switch(reader.GetFirmware())
+    {
+        case daisybed::TraceFirmware::kBasicMonosynth:
+        {
+            static MonosynthReplayer replayer;
+            return Replay(replayer, reader, options);
+        }
+        case daisybed::TraceFirmware::kCinematicVerb:
+        {
+            // The plate and pitch-shifters are too big for the stack.
+            static ShimmerReplayer replayer;
+            replayer.impulse = options.impulse;
+            return Replay(replayer, reader, options);
+        }
+        case daisybed::TraceFirmware::kAwfulParaphonic:
+        {
+            static ParaphonicReplayer replayer;
+            return Replay(replayer, reader, options);
+        }
+    }
+    fprintf(stderr, "replay: unknown firmware id %d\n", (int)reader.GetFirmware());
+    return 1;
+}
@@ -0,0 +1,298 @@
+// Runs the firmware Scheduler (shared/Scheduler.h) against a simulated clock
+// and reports per-task timing: how late each release started, how long the
+// task ran, and how many deadlines it missed, plus how much of the time the
+// core would have spent asleep.
+//
+//   scheduler-sim [--seconds s] [--audio-load 0..1] [--save-every s]
+//                 [--max-late-us us] [--seed n]
+//
+// The simulated board mirrors the firmwares: an audio DMA interrupt every
+// millisecond that takes --audio-load of it, a MIDI poll, an LED update and a
+// trace drain every millisecond with randomised run times, and an occasional
+// settings save, begun by an event task signalled from the audio interrupt.
+// The save runs as PresetStore over QspiFlash does, one step per 10 ms task
+// run: a sector erase that waits out the chip's 35..45 ms, a page program,
+// then the read-back. Interrupts preempt tasks and wake the idle core, as on
+// the hardware.
+//
+// Exits 1 if a periodic task ever started later than the bound, or an event
+// task missed its deadline. Tasks don't preempt each other, so by default the
+// bound is what that allows: one run of every task (the one in progress and
+// the others due first) plus one audio period. --max-late-us sets it
+// explicitly, e.g. to check a budget with --save-every 0.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Scheduler.h"
+
+namespace
+{
+struct Lcg
+{
+    uint32_t state;
+    uint32_t Next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+    // Uniform in [lo, hi].
+    uint32_t Range(uint32_t lo, uint32_t hi) { return lo + Next() % (hi - lo + 1); }
+};
+
+class SimClock;
+typedef daisybed::Scheduler<SimClock> SimScheduler;
+
+// Simulated time. Task code "runs" by calling Consume(); any audio interrupt
+// that falls due meanwhile runs first and pushes the task's finish back.
+class SimClock
+{
+  public:
+    static constexpr uint32_t kAudioPeriodUs = 1000;
+
+    void Init(float audio_load, float save_every_s, uint32_t seed)
+    {
+        now_us_       = 0;
+        next_audio_   = kAudioPeriodUs;
+        audio_us_     = (uint32_t)(audio_load * kAudioPeriodUs);
+        save_every_   = (uint32_t)(save_every_s * 1e6f / kAudioPeriodUs);
+        audio_blocks_ = 0;
+        asleep_us_    = 0;
+        rng_.state    = seed;
+    }
+
+    void Attach(SimScheduler *scheduler, int save_task)
+    {
+        scheduler_ = scheduler;
+        save_task_ = save_task;
+    }
+
+    inline uint32_t NowUs() const { return now_us_; }
+
+    template <typename Pending>
+    void Idle(uint32_t wake_us, Pending pending)
+    {
+        if(pending())
+            return;
+        // WFI: sleep until the next interrupt or the scheduler's wake time,
+        // whichever comes first. (The hardware clock can only do the former;
+        // its SysTick interrupt is folded into the audio one here.)
+        uint32_t until = (int32_t)(wake_us - next_audio_) < 0 ? wake_us : next_audio_;
+        if((int32_t)(until - now_us_) > 0)
+        {
+            asleep_us_ += until - now_us_;
+            now_us_ = until;
+        }
+        ServiceInterrupts();
+    }
+
+    // Task body taking `us` of CPU.
+    void Consume(uint32_t us)
+    {
+        uint32_t end = now_us_ + us;
+        while((int32_t)(end - next_audio_) >= 0)
+        {
+            now_us_ = next_audio_;
+            end += AudioInterrupt();
+        }
+        now_us_ = end;
+    }
+
+    // Task body waiting `us` of wall-clock time on a peripheral, as a
+    // blocking flash erase does; interrupts run meanwhile without pushing
+    // the end back.
+    void Wait(uint32_t us)
+    {
+        uint32_t end = now_us_ + us;
+        while((int32_t)(end - next_audio_) >= 0)
+        {
+            now_us_ = next_audio_;
+            now_us_ += AudioInterrupt();
+        }
+        if((int32_t)(end - now_us_) > 0)
+            now_us_ = end;
+    }
+
+    inline Lcg     &Random() { return rng_; }
+    inline uint64_t GetAsleepUs() const { return asleep_us_; }
+
+  private:
+    void ServiceInterrupts()
+    {
+        while((int32_t)(now_us_ - next_audio_) >= 0)
+            now_us_ += AudioInterrupt();
+    }
+
+    // One audio callback; returns the CPU time it took.
+    uint32_t AudioInterrupt()
+    {
+        next_audio_ += kAudioPeriodUs;
+        audio_blocks_++;
+        if(save_every_ && audio_blocks_ % save_every_ == 0)
+            scheduler_->Signal(save_task_);
+        return audio_us_;
+    }
+
+    uint32_t      now_us_, next_audio_, audio_us_, save_every_, audio_blocks_;
+    uint64_t      asleep_us_;
+    Lcg           rng_;
+    SimScheduler *scheduler_ = nullptr;
+    int           save_task_ = SimScheduler::kInvalidTask;
+};
+
+SimClock     sim_clock;
+SimScheduler scheduler;
+
+void PollMidi(void *) { sim_clock.Consume(sim_clock.Random().Range(5, 30)); }
+void UpdateLed(void *) { sim_clock.Consume(2); }
+void DrainTrace(void *) { sim_clock.Consume(sim_clock.Random().Range(0, 200)); }
+// The save in progress, between steps.
+enum class SaveStage
+{
+    kIdle,
+    kErase,
+    kProgram,
+    kVerify,
+};
+SaveStage save_stage = SaveStage::kIdle;
+
+void BeginSave(void *)
+{
+    sim_clock.Consume(2);
+    if(save_stage == SaveStage::kIdle)
+        save_stage = SaveStage::kErase;
+}
+
+void SaveStep(void *)
+{
+    switch(save_stage)
+    {
+        case SaveStage::kIdle: sim_clock.Consume(1); break;
+        case SaveStage::kErase:
+            sim_clock.Wait(sim_clock.Random().Range(35000, 45000));
+            save_stage = SaveStage::kProgram;
+            break;
+        case SaveStage::kProgram:
+            sim_clock.Consume(sim_clock.Random().Range(600, 800));
+            save_stage = SaveStage::kVerify;
+            break;
+        case SaveStage::kVerify:
+            sim_clock.Consume(sim_clock.Random().Range(20, 40));
+            save_stage = SaveStage::kIdle;
+            break;
+    }
+}
+
+struct Options
+{
+    float    seconds    = 10.f;
+    float    audio_load = 0.6f;
+    float    save_every  = 2.f;
+    uint32_t max_late_us = 0; // 0: derived from the run times, see above
+    uint32_t seed        = 1;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--seconds") == 0)
+            options.seconds = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--audio-load") == 0)
+            options.audio_load = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--save-every") == 0)
+            options.save_every = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--max-late-us") == 0)
+            options.max_late_us = (uint32_t)atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--seed") == 0)
+            options.seed = (uint32_t)atoi(argv[i + 1]);
+        else
+            return false;
+    }
+    return argc % 2 == 1 && options.seconds > 0.f && options.audio_load >= 0.f
+           && options.audio_load < 1.f;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: scheduler-sim [--seconds s] [--audio-load 0..1] "
+                "[--save-every s] [--max-late-us us] [--seed n]\n");
+        return 2;
+    }
+
+    sim_clock.Init(options.audio_load, options.save_every, options.seed);
+    scheduler.Init(&sim_clock);
+    struct
+    {
+        const char *name;
+        int         id;
+        bool        periodic;
+    } tasks[] = {
+        {"midi-poll", scheduler.AddPeriodic(PollMidi, nullptr, 1000), true},
+        {"led", scheduler.AddPeriodic(UpdateLed, nullptr, 1000), true},
+        {"trace-drain", scheduler.AddPeriodic(DrainTrace, nullptr, 1000), true},
+        {"save-step", scheduler.AddPeriodic(SaveStep, nullptr, 10000, 500000), true},
+        {"save (event)", scheduler.AddEvent(BeginSave, nullptr, 500000), false},
+    };
+    sim_clock.Attach(&scheduler, tasks[4].id);
+
+    const uint64_t total_us = (uint64_t)(options.seconds * 1e6f);
+    uint64_t       elapsed  = 0;
+    uint32_t       last     = sim_clock.NowUs();
+    while(elapsed < total_us)
+    {
+        scheduler.RunOnce();
+        elapsed += sim_clock.NowUs() - last;
+        last = sim_clock.NowUs();
+    }
+
+    printf("%.1f s simulated, audio interrupt %.0f%% of each 1 ms, core asleep %.1f%%\n",
+           options.seconds,
+           options.audio_load * 100.f,
+           100.0 * sim_clock.GetAsleepUs() / elapsed);
+    printf("task          runs  misses  mean late us  max late us  max run us\n");
+    for(const auto &task : tasks)
+    {
+        const SimScheduler::TaskStats &s = scheduler.GetStats(task.id);
+        printf("%-12s %5u  %6u  %12.1f  %11u  %10u\n",
+               task.name,
+               s.runs,
+               s.misses,
+               s.runs ? (double)s.total_lateness_us / s.runs : 0.0,
+               s.max_lateness_us,
+               s.max_runtime_us);
+    }
+
+    uint32_t bound = options.max_late_us;
+    if(bound == 0)
+    {
+        bound = SimClock::kAudioPeriodUs;
+        for(const auto &task : tasks)
+            bound += scheduler.GetStats(task.id).max_runtime_us;
+    }
+    printf("lateness bound for periodic tasks: %u us\n", bound);
+
+    int failures = 0;
+    for(const auto &task : tasks)
+    {
+        const SimScheduler::TaskStats &s = scheduler.GetStats(task.id);
+        if(task.periodic && s.max_lateness_us > bound)
+        {
+            printf("FAIL: %s started %u us late\n", task.name, s.max_lateness_us);
+            failures++;
+        }
+        if(!task.periodic && s.misses > 0)
+        {
+            printf("FAIL: %s missed its deadline %u times\n", task.name, s.misses);
+            failures++;
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
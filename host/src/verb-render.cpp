@@ -0,0 +1,188 @@
+// Runs a WAV file through the cinematic-verb signal path (ShimmerVerb.h, the
+// exact code the firmware runs) and writes the result as a float WAV.
+//
+//   verb-render <in.wav> <out.wav> [--curves file] [--block frames] [--tail seconds]
+//               [--motion]
+//
+// The input is memory-mapped and converted a callback-sized block at a time;
+// the output streams out through a double buffer, so memory use doesn't grow
+// with the length of the file. Channels are processed in stereo pairs, each
+// pair with its own engine; a mono input (or a lone last channel) feeds both
+// sides of its engine and keeps the left output.
+//
+// Knobs and CV jacks hold the defaults below unless the --curves file
+// automates them (see ControlCurves.h for the format). Control names:
+//   size shimmer interval mix   (K1..K4, 0..1)
+//   cv5 cv6 cv7 cv8             (the CV jack summed into each knob, -1..1)
+// The controls are evaluated once per block, like the firmware's ADC reads.
+// --motion renders with the toggle up: the size drifts and the input ducks
+// the mix (ShimmerVerb::SetMotion()).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "AudioSpan.h"
+#include "ControlCurves.h"
+#include "Denormals.h"
+#include "ShimmerVerb.h"
+#include "WavFile.h"
+
+namespace
+{
+const char *const kControlNames[daisybed::ShimmerVerbControls::kNumAdc]
+    = {"size", "shimmer", "interval", "mix", "cv5", "cv6", "cv7", "cv8"};
+// Interval 0.4 is the octave-up step, the firmware's power-on default.
+const float kControlDefaults[daisybed::ShimmerVerbControls::kNumAdc]
+    = {0.5f, 0.3f, 0.4f, 0.4f, 0.f, 0.f, 0.f, 0.f};
+
+struct Options
+{
+    const char *input_path   = nullptr;
+    const char *output_path  = nullptr;
+    const char *curves_path  = nullptr;
+    size_t      block_size   = 48;
+    float       tail_seconds = 0.f;
+    bool        motion       = false;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    int positional = 0;
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--curves") == 0 && i + 1 < argc)
+            options.curves_path = argv[++i];
+        else if(strcmp(argv[i], "--block") == 0 && i + 1 < argc)
+            options.block_size = (size_t)atoi(argv[++i]);
+        else if(strcmp(argv[i], "--tail") == 0 && i + 1 < argc)
+            options.tail_seconds = (float)atof(argv[++i]);
+        else if(strcmp(argv[i], "--motion") == 0)
+            options.motion = true;
+        else if(positional == 0)
+            options.input_path = argv[i], positional++;
+        else if(positional == 1)
+            options.output_path = argv[i], positional++;
+        else
+            return false;
+    }
+    return positional == 2 && options.block_size > 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: verb-render <in.wav> <out.wav> [--curves file] "
+                "[--block frames] [--tail seconds] [--motion]\n");
+        return 2;
+    }
+
+    daisybed::MappedWav input;
+    const char         *error = nullptr;
+    if(!input.Open(options.input_path, &error))
+    {
+        fprintf(stderr, "%s: %s\n", options.input_path, error);
+        return 1;
+    }
+
+    daisybed::ControlCurves curves;
+    curves.Init(kControlNames, kControlDefaults, daisybed::ShimmerVerbControls::kNumAdc);
+    if(options.curves_path && !curves.Load(options.curves_path))
+        return 1;
+
+    const uint16_t channels    = input.GetChannels();
+    const float    sample_rate = (float)input.GetSampleRate();
+    const size_t   block       = options.block_size;
+    const uint64_t in_frames   = input.GetFrames();
+    const uint64_t out_frames
+        = in_frames + (uint64_t)(options.tail_seconds * sample_rate);
+
+    daisybed::WavStreamWriter output;
+    if(!output.Open(options.output_path, input.GetSampleRate(), channels))
+    {
+        fprintf(stderr, "%s: can't write\n", options.output_path);
+        return 1;
+    }
+
+    // Match the firmware: every callback runs with flush-to-zero enabled.
+    daisybed::ScopedFlushDenormals ftz;
+
+    // The plate and pitch-shifters are a few hundred KB each; heap, not stack.
+    const size_t pairs = (channels + 1) / 2;
+    std::unique_ptr<daisybed::ShimmerVerb[]> engines(new daisybed::ShimmerVerb[pairs]);
+    for(size_t p = 0; p < pairs; p++)
+    {
+        engines[p].Init(sample_rate);
+        engines[p].SetMotion(options.motion);
+    }
+
+    std::vector<float> in_left(block), in_right(block);
+    std::vector<float> out_left(block), out_right(block);
+    std::vector<float> interleaved(block * channels);
+    daisybed::ShimmerVerbControls controls;
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint64_t frame = 0; frame < out_frames; frame += block)
+    {
+        size_t n = (size_t)std::min<uint64_t>(block, out_frames - frame);
+        size_t n_in
+            = frame < in_frames ? (size_t)std::min<uint64_t>(n, in_frames - frame) : 0;
+
+        float seconds = (float)((double)frame / sample_rate);
+        for(int c = 0; c < daisybed::ShimmerVerbControls::kNumAdc; c++)
+            controls.adc[c] = curves.Value(c, seconds);
+
+        for(size_t p = 0; p < pairs; p++)
+        {
+            uint16_t left_channel  = (uint16_t)(2 * p);
+            bool     has_right     = left_channel + 1 < channels;
+            uint16_t right_channel = has_right ? left_channel + 1 : left_channel;
+
+            // Past the end of the file the tail rings out on silence.
+            std::fill(in_left.begin() + n_in, in_left.begin() + n, 0.f);
+            std::fill(in_right.begin() + n_in, in_right.begin() + n, 0.f);
+            input.Read(frame, n_in, left_channel, in_left.data());
+            input.Read(frame, n_in, right_channel, in_right.data());
+
+            const float *in[2]  = {in_left.data(), in_right.data()};
+            float       *out[2] = {out_left.data(), out_right.data()};
+            engines[p].ProcessBlock(controls,
+                                    daisybed::ViewStereo(in, n),
+                                    daisybed::ViewStereo(out, n));
+
+            for(size_t i = 0; i < n; i++)
+            {
+                interleaved[i * channels + left_channel] = out_left[i];
+                if(has_right)
+                    interleaved[i * channels + right_channel] = out_right[i];
+            }
+        }
+        output.Write(interleaved.data(), n);
+    }
+    bool written = output.Close();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double audio_seconds = (double)out_frames / sample_rate;
+    printf("%s: %u ch @ %.0f Hz, %.1f s in %.2f s (%.1fx realtime)\n",
+           options.output_path,
+           channels,
+           sample_rate,
+           audio_seconds,
+           elapsed.count(),
+           audio_seconds / elapsed.count());
+    if(!written)
+    {
+        fprintf(stderr, "%s: write failed\n", options.output_path);
+        return 1;
+    }
+    return 0;
+}
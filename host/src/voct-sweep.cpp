@@ -0,0 +1,240 @@
+// Sweeps the V/Oct pipeline (shared/PitchCv.h) over the Patch SM's whole
+// -5..+5 V input, ten octaves, and checks the pitch error in cents.
+//
+//   voct-sweep [--units n] [--points n] [--max-cents c] [--seed n]
+//
+// Each simulated unit has its own ADC gain error (up to 3%) and offset (up to
+// 20 mV), 16-bit quantisation and a couple of LSBs of noise, averaged over 32
+// conversions as libDaisy's ADC oversampling does. The unit is calibrated the
+// way the firmware does it, from readings at 1 V and 3 V, then every sweep
+// point goes through PitchCv and Exp2Table and is compared with the exact
+// 2^volts, except where the unit's ADC clips (a gain above 1 reaches full
+// scale a little short of 5 V). The uncalibrated error (the default
+// calibration on the same unit) is printed alongside for scale.
+//
+// Each point is a single block's reading, as the firmware gets it. The step
+// case also moves each unit's input between random voltages, one held for a
+// few blocks before the next, and checks the first block after every step:
+// a voice triggered with the step plays that block's pitch for the whole
+// note, so it must already be within --max-cents of the new voltage.
+//
+// Exits 1 if any calibrated unit is off by more than --max-cents anywhere,
+// including right after a step, or if Exp2Table alone is off by more than
+// 0.01 cent.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PitchCv.h"
+
+namespace
+{
+using daisybed::PitchCalibration;
+using daisybed::PitchCv;
+
+constexpr float  kSampleRate   = 48000.f;
+constexpr double kLowVolts     = -5.0;
+constexpr double kHighVolts    = 5.0;
+constexpr int    kOversampling = 32;
+constexpr int    kSteps        = 200; // per unit
+
+struct Lcg
+{
+    uint32_t state;
+    // Uniform in [-1, 1).
+    double Bipolar()
+    {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 8388608.0 - 1.0;
+    }
+};
+
+// One unit's CV input: -5..+5 V to a -1..1 reading, with its own errors.
+struct Adc
+{
+    double gain;
+    double offset;
+    Lcg    rng;
+
+    inline bool InRange(double volts) const
+    {
+        return fabs(volts / 5.0 * gain + offset) < 1.0 - 4.0 / 32768.0;
+    }
+
+    float Read(double volts)
+    {
+        double sum = 0.0;
+        for(int i = 0; i < kOversampling; i++)
+        {
+            double raw = volts / 5.0 * gain + offset + rng.Bipolar() * 2.0 / 32768.0;
+            raw        = raw < -1.0 ? -1.0 : (raw > 1.0 ? 1.0 : raw);
+            sum += round(raw * 32768.0) / 32768.0;
+        }
+        return (float)(sum / kOversampling);
+    }
+};
+
+double Cents(double hz, double volts)
+{
+    return 1200.0 * log2(hz / (PitchCv::kC0Hz * exp2(volts)));
+}
+
+// Worst error over the sweep through a PitchCv with this calibration. A
+// unit whose gain is above 1 clips a little short of +-5 V; those points are
+// its range, not calibration error, so they are skipped.
+double WorstCents(Adc &adc, const PitchCalibration &calibration, int points)
+{
+    PitchCv pitch;
+    pitch.Init(kSampleRate, calibration);
+    double worst = 0.0;
+    for(int p = 0; p < points; p++)
+    {
+        double volts = kLowVolts + (kHighVolts - kLowVolts) * p / (points - 1);
+        if(!adc.InRange(volts))
+            continue;
+        float  measured = pitch.Update(adc.Read(volts));
+        double error    = fabs(Cents(pitch.VoltsToFrequency(measured), volts));
+        worst           = error > worst ? error : worst;
+    }
+    return worst;
+}
+
+// Worst error in the first block after a step between two random voltages
+// inside the unit's range, each held for a few blocks first.
+double WorstStepCents(Adc &adc, const PitchCalibration &calibration, Lcg &rng)
+{
+    PitchCv pitch;
+    pitch.Init(kSampleRate, calibration);
+    double worst = 0.0;
+    for(int step = 0; step < kSteps; step++)
+    {
+        double from = 4.9 * rng.Bipolar(), to = 4.9 * rng.Bipolar();
+        if(!adc.InRange(from) || !adc.InRange(to))
+            continue;
+        for(int i = 0; i < 4; i++)
+            pitch.Update(adc.Read(from));
+        float  measured = pitch.Update(adc.Read(to));
+        double error    = fabs(Cents(pitch.VoltsToFrequency(measured), to));
+        worst           = error > worst ? error : worst;
+    }
+    return worst;
+}
+
+struct Options
+{
+    int      units     = 100;
+    int      points    = 2001;
+    float    max_cents = 1.f;
+    uint32_t seed      = 1;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--units") == 0)
+            options.units = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--points") == 0)
+            options.points = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--max-cents") == 0)
+            options.max_cents = (float)atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--seed") == 0)
+            options.seed = (uint32_t)atoi(argv[i + 1]);
+        else
+            return false;
+    }
+    return argc % 2 == 1 && options.units > 0 && options.points > 1
+           && options.max_cents > 0.f;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if(!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: voct-sweep [--units n] [--points n] [--max-cents c] "
+                "[--seed n]\n");
+        return 2;
+    }
+
+    int failures = 0;
+
+    // The table on its own, against exp2 in double precision.
+    daisybed::Exp2Table table;
+    table.Init();
+    double table_worst = 0.0;
+    for(int p = 0; p < options.points * 10; p++)
+    {
+        double x     = kLowVolts + (kHighVolts - kLowVolts) * p / (options.points * 10 - 1);
+        double error = fabs(1200.0 * log2(table.Exp2((float)x) / exp2(x)));
+        table_worst  = error > table_worst ? error : table_worst;
+    }
+    printf("Exp2Table over %.0f..%.0f octaves: worst %.5f cents\n",
+           kLowVolts,
+           kHighVolts,
+           table_worst);
+    if(table_worst > 0.01)
+    {
+        printf("FAIL: Exp2Table off by more than 0.01 cent\n");
+        failures++;
+    }
+
+    Lcg    rng = {options.seed};
+    double worst_calibrated = 0.0, worst_default = 0.0, sum_calibrated = 0.0;
+    double worst_step   = 0.0;
+    int    failed_units = 0, failed_steps = 0;
+    for(int unit = 0; unit < options.units; unit++)
+    {
+        Adc adc;
+        adc.gain      = 1.0 + 0.03 * rng.Bipolar();
+        adc.offset    = 0.020 / 5.0 * rng.Bipolar();
+        adc.rng.state = options.seed + 7919u * (uint32_t)unit;
+
+        PitchCalibration calibration = PitchCalibration::Default();
+        calibration.Calibrate(adc.Read(1.0), 1.f, adc.Read(3.0), 3.f);
+
+        double calibrated   = WorstCents(adc, calibration, options.points);
+        double uncalibrated = WorstCents(adc, PitchCalibration::Default(), options.points);
+        double stepped      = WorstStepCents(adc, calibration, rng);
+        worst_calibrated    = calibrated > worst_calibrated ? calibrated : worst_calibrated;
+        worst_default       = uncalibrated > worst_default ? uncalibrated : worst_default;
+        worst_step          = stepped > worst_step ? stepped : worst_step;
+        sum_calibrated += calibrated;
+        if(calibrated > options.max_cents)
+            failed_units++;
+        if(stepped > options.max_cents)
+            failed_steps++;
+    }
+
+    printf("%d units, %d points over 10 octaves: calibrated worst %.3f cents "
+           "(mean of per-unit worst %.3f), uncalibrated worst %.1f cents\n",
+           options.units,
+           options.points,
+           worst_calibrated,
+           sum_calibrated / options.units,
+           worst_default);
+    if(failed_units > 0)
+    {
+        printf("FAIL: %d units off by more than %.2f cents\n",
+               failed_units,
+               options.max_cents);
+        failures++;
+    }
+
+    printf("%d steps per unit: first block after a step worst %.3f cents\n",
+           kSteps,
+           worst_step);
+    if(failed_steps > 0)
+    {
+        printf("FAIL: %d units off by more than %.2f cents the block after a step\n",
+               failed_steps,
+               options.max_cents);
+        failures++;
+    }
+    return failures > 0 ? 1 : 0;
+}
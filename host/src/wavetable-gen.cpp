@@ -0,0 +1,198 @@
+// Generates the band-limited mip-mapped tables WavetableOsc plays, as C++
+// source for the firmwares to compile into flash.
+//
+//   wavetable-gen out.cpp
+//
+// Every table is summed from its harmonic series in double precision, so each
+// mip level is exactly band-limited: level L of a waveform holds harmonics 1
+// to WavetableOsc::kMaxHarmonics >> L, and a waveform has levels until only
+// the fundamental is left. Each waveform is scaled once, so its loudest
+// sample over all of its levels is full scale, and the levels stay at the
+// same loudness as the oscillator moves between them.
+//
+// Adding a waveform means a spectrum here and an entry in WavetableOsc's
+// enum, in the same order. The output is committed as
+// shared/WavetableData.cpp; rewrite it with the wavetables target.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include "WavetableOsc.h"
+
+namespace
+{
+using daisybed::WavetableOsc;
+
+constexpr size_t kTableSize = WavetableOsc::kTableSize;
+constexpr double kPi        = 3.14159265358979323846;
+
+// Amplitude of harmonic h (of sin(h x)); zero to leave it out.
+struct Spectrum
+{
+    const char *name;
+    double (*amplitude)(int h);
+};
+
+double Saw(int h)
+{
+    return (h % 2 ? 2.0 : -2.0) / (kPi * h);
+}
+
+double Square(int h)
+{
+    return h % 2 ? 4.0 / (kPi * h) : 0.0;
+}
+
+double Triangle(int h)
+{
+    if(h % 2 == 0)
+        return 0.0;
+    return ((h / 2) % 2 ? -8.0 : 8.0) / (kPi * kPi * h * h);
+}
+
+double Sine(int h)
+{
+    return h == 1 ? 1.0 : 0.0;
+}
+
+// In WavetableOsc's enum order.
+const Spectrum kSpectra[] = {
+    {"saw", Saw},
+    {"square", Square},
+    {"triangle", Triangle},
+    {"sine", Sine},
+};
+static_assert(sizeof(kSpectra) / sizeof(kSpectra[0]) == WavetableOsc::WAVE_LAST,
+              "one spectrum per WavetableOsc waveform");
+
+// The highest harmonic with any energy, so a sine gets one level, not eight.
+int HighestHarmonic(const Spectrum &spectrum)
+{
+    for(int h = WavetableOsc::kMaxHarmonics; h > 1; h--)
+        if(spectrum.amplitude(h) != 0.0)
+            return h;
+    return 1;
+}
+
+struct Shape
+{
+    uint32_t                         offset;
+    std::vector<std::vector<double>> levels;
+    std::vector<int>                 harmonics; // per level
+};
+
+Shape Render(const Spectrum &spectrum, uint32_t offset)
+{
+    Shape shape;
+    shape.offset = offset;
+    int highest  = HighestHarmonic(spectrum);
+    for(int level = 0; level < WavetableOsc::kMipLevels; level++)
+    {
+        int harmonics = WavetableOsc::kMaxHarmonics >> level;
+        if(harmonics > highest)
+            harmonics = highest;
+
+        std::vector<double> table(kTableSize + 1, 0.0);
+        for(int h = 1; h <= harmonics; h++)
+        {
+            double amplitude = spectrum.amplitude(h);
+            if(amplitude == 0.0)
+                continue;
+            for(size_t i = 0; i < kTableSize; i++)
+                table[i] += amplitude * sin(2.0 * kPi * h * i / kTableSize);
+        }
+        table[kTableSize] = table[0];
+        shape.levels.push_back(table);
+        shape.harmonics.push_back(harmonics);
+
+        // Stop once the next level would be this one again.
+        int next = WavetableOsc::kMaxHarmonics >> (level + 1);
+        if(next < 1 || next >= highest)
+            break;
+    }
+    return shape;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "usage: wavetable-gen out.cpp\n");
+        return 2;
+    }
+
+    std::vector<Shape> shapes;
+    uint32_t           offset = 0;
+    for(const Spectrum &spectrum : kSpectra)
+    {
+        shapes.push_back(Render(spectrum, offset));
+        offset += (uint32_t)(shapes.back().levels.size() * (kTableSize + 1));
+    }
+
+    FILE *file = fopen(argv[1], "w");
+    if(!file)
+    {
+        fprintf(stderr, "wavetable-gen: can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(file,
+            "// Generated by host/src/wavetable-gen.cpp; do not edit. Rewrite "
+            "it with\n// `cmake --build host/build --target wavetables`.\n"
+            "//\n// %zu-sample int16 tables plus a guard sample each: %u samples,\n"
+            "// %u bytes of flash.\n\n"
+            "#include \"WavetableOsc.h\"\n\nnamespace daisybed\n{\n",
+            kTableSize,
+            offset,
+            offset * 2);
+
+    fprintf(file, "const WavetableShape kWavetableShapes[WavetableOsc::WAVE_LAST] = {\n");
+    for(size_t s = 0; s < shapes.size(); s++)
+        fprintf(file,
+                "    {%u, %zu}, // %s\n",
+                shapes[s].offset,
+                shapes[s].levels.size(),
+                kSpectra[s].name);
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "const int16_t kWavetableData[%u] = {\n", offset);
+    for(size_t s = 0; s < shapes.size(); s++)
+    {
+        double peak = 0.0;
+        for(const std::vector<double> &table : shapes[s].levels)
+            for(double sample : table)
+                peak = fabs(sample) > peak ? fabs(sample) : peak;
+        double scale = peak > 0.0 ? 32767.0 / peak : 0.0;
+
+        for(size_t level = 0; level < shapes[s].levels.size(); level++)
+        {
+            const std::vector<double> &table = shapes[s].levels[level];
+            fprintf(file,
+                    "    // %s, level %zu: harmonics 1..%d\n",
+                    kSpectra[s].name,
+                    level,
+                    shapes[s].harmonics[level]);
+            for(size_t i = 0; i < table.size(); i++)
+            {
+                fprintf(file,
+                        "%s%d,%s",
+                        i % 12 == 0 ? "    " : " ",
+                        (int)lround(table[i] * scale),
+                        i % 12 == 11 || i + 1 == table.size() ? "\n" : "");
+            }
+        }
+    }
+    fprintf(file, "};\n\n} // namespace daisybed\n");
+
+    if(fclose(file) != 0)
+    {
+        fprintf(stderr, "wavetable-gen: error writing %s\n", argv[1]);
+        return 1;
+    }
+    printf("wrote %s: %u samples in %zu waveforms\n", argv[1], offset, shapes.size());
+    return 0;
+}
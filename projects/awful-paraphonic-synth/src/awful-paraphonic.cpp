@@ -1,65 +1,163 @@
 #include "daisy_patch_sm.h"
 #include "daisysp.h"
+#include "AudioSpan.h"
+#include "Denormals.h"
+#include "GateInput.h"
+#include "GateInterrupt.h"
+#include "ParaphonicSynth.h"
+#include "PitchCv.h"
+#include "TraceStream.h"
+#include "DaisyClock.h"
+#include "Scheduler.h"
+#include "AudioConfig.h"
+#include "ControlScanner.h"
+#include "memory-plan.h"
 
 using namespace daisy;
 using namespace patch_sm;
 using namespace daisysp;
 
-static const size_t NUM_VOICES = 8;
+// The voices, filter and V/Oct pipeline live in ParaphonicSynth.h so the host
+// tools can run them; this file is the Patch SM glue around it. The statics
+// are placed as memory-plan.h lays out.
+DaisyPatchSM hw;                                         // Hardware layer
+static daisybed::ParaphonicSynth DTCM_MEM_SECTION synth; // Voices + filter
+daisybed::GateInput DTCM_MEM_SECTION gate;               // Timestamped gate input for triggering voices
 
-// Small Voice abstraction
-struct Voice
+// Configured with -DDAISYBED_TRACE=ON, every ADC reading, gate trigger and
+// calibration change the callback consumes is streamed over USB for replay
+// on the host.
+static daisybed::TraceRecorder trace;
+static UsbHandle usb;
+static uint32_t block_count = 0;
+
+// The main loop only wakes for scheduler tasks; otherwise the core sleeps.
+static daisybed::DaisyClock scheduler_clock;
+static daisybed::Scheduler<daisybed::DaisyClock> scheduler;
+static int save_calibration_task = daisybed::Scheduler<daisybed::DaisyClock>::kInvalidTask;
+
+// libDaisy's default 48-sample block with a 1 ms control scan. Gate edges
+// are placed to the sample inside the block after they arrive, so a gate
+// sounds one to two blocks (plus the codec) after its edge. A smaller block
+// would shorten that, but the eight voices and filter haven't been measured
+// at the per-callback overhead it costs; measure with a CpuLoadMeter first.
+static constexpr daisybed::AudioConfig kAudioConfig
+    = daisybed::kDefaultAudioConfig;
+
+// The knobs (CV_1..CV_4) are scanned at the control rate by a scheduler task
+// rather than once per audio block. kNumKnobs comes from memory-plan.h.
+//
+// V/Oct (CV_5) stays out of the scanner: the audio callback reads it fresh
+// every block, so a gate edge picks up a pitch at most one block old. Nothing
+// smooths it across blocks, since a voice keeps the pitch it was triggered
+// with; the ADC's hardware oversampling is its only filtering.
+static daisybed::ControlScanner<kNumKnobs> DTCM_MEM_SECTION control_scanner;
+
+// libDaisy slews a bipolar CV input over 2 ms at the rate it's told it runs
+// at, a coefficient of 1 / (0.002 * rate / 2). At 1 kHz that is 1, so CV_5 is
+// told 1 kHz whatever the block size and each Process() returns the ADC's
+// current reading rather than a lagging blend with earlier blocks.
+static constexpr float kVoctControlRate = 1000.f;
+
+// Two-point V/Oct calibration, kept in QSPI across power cycles. Hold the
+// gate high while powering up to calibrate: patch 1 V into CV_5 and send a
+// gate, then 3 V and another gate. The user LED is lit until it's done.
+PersistentStorage<daisybed::PitchCalibration> calibration_storage(hw.qspi);
+enum CalibrationStep
 {
-  Oscillator oscillator;
-  AdEnv envelope;
+  CALIBRATION_OFF,
+  CALIBRATION_WAIT_1V,
+  CALIBRATION_WAIT_3V,
+};
+static volatile CalibrationStep calibration_step = CALIBRATION_OFF;
+static bool calibration_pending = false;
+static float calibration_raw_1v = 0.f;
+static daisybed::PitchCalibration new_calibration;
 
-  void Init(float sample_rate)
+// Called for each gate rising edge while calibrating. The result is applied
+// at the top of the next block, where the trace can place it exactly.
+static void CalibrationEdge(float raw)
+{
+  if (calibration_step == CALIBRATION_WAIT_1V)
   {
-    oscillator.Init(sample_rate);
-    oscillator.SetWaveform(oscillator.WAVE_POLYBLEP_SAW);
-    oscillator.SetFreq(220);
-    oscillator.SetAmp(0.0f); // amplitude will come from envelope
-    envelope.Init(sample_rate);
-    envelope.SetTime(ADENV_SEG_ATTACK, 0.f);
-    envelope.SetTime(ADENV_SEG_DECAY, 0.35f);
-    envelope.SetMin(0.0f);
-    envelope.SetMax(1.f);
-    envelope.SetCurve(0.f); // linear
+    calibration_raw_1v = raw;
+    calibration_step = CALIBRATION_WAIT_3V;
   }
-
-  // Trigger the envelope and set a new freq
-  void Trigger(float freq)
+  else if (calibration_step == CALIBRATION_WAIT_3V)
   {
-    oscillator.SetFreq(freq);
-    envelope.Trigger();
+    new_calibration = synth.GetPitchCv().GetCalibration();
+    new_calibration.Calibrate(calibration_raw_1v, 1.f, raw, 3.f);
+    calibration_pending = true;
+    calibration_step = CALIBRATION_OFF;
   }
+}
+
+static void TraceCalibration(const daisybed::PitchCalibration &calibration)
+{
+  trace.Config(daisybed::ParaphonicSynth::kConfigCalibrationOffset,
+               calibration.offset);
+  trace.Config(daisybed::ParaphonicSynth::kConfigCalibrationScale,
+               calibration.scale);
+}
 
-  float Process()
+// Scheduler event, signalled by the audio callback. Flash writes stay out of
+// the audio callback.
+static void SaveCalibration(void *)
+{
+  calibration_storage.GetSettings() = new_calibration;
+  calibration_storage.Save();
+  hw.SetLed(false);
+}
+
+// The gate is on B10 (PG14), EXTI line 14; this firmware owns the vector.
+extern "C" void EXTI15_10_IRQHandler(void)
+{
+  daisybed::ServiceGateInterrupt(10, 15);
+}
+
+// Only the knobs: CV_5's AnalogControl belongs to the audio callback.
+static void ScanControls(void *)
+{
+  float knobs[kNumKnobs];
+  for (int i = 0; i < kNumKnobs; i++)
   {
-    float env_sig = envelope.Process();
-    // Scale oscillator amplitude by envelope.
-    oscillator.SetAmp(env_sig * 0.2f);
-    return oscillator.Process(); // same levels as your original
+    knobs[i] = hw.controls[CV_1 + i].Process();
   }
-};
+  control_scanner.Scan(knobs, 0, nullptr);
+}
 
-DaisyPatchSM hw;                      // Hardware layer
-static Voice voices[NUM_VOICES];      // Voices
-static size_t active_voice_index = 0; // Active voice index
-Svf svf;                              // Single filter on the sum of voices
-Switch gate;                          // Gate input for triggering voices
+static void DrainTrace(void *)
+{
+  trace.Drain([](const uint8_t *data, size_t size) {
+    return usb.TransmitInternal(const_cast<uint8_t *>(data), size)
+           == UsbHandle::Result::OK;
+  });
+}
 
 // Main audio callback of the program
 static void AudioCallback(AudioHandle::InputBuffer in,
                           AudioHandle::OutputBuffer out,
                           size_t size)
 {
+  control_scanner.BeginBlock();
+  gate.BeginBlock(System::GetTick(), size);
+  trace.BeginBlock(block_count++);
+  if (trace.SyncDue())
+  {
+    // A reader that attached late needs the calibration in use too.
+    TraceCalibration(synth.GetPitchCv().GetCalibration());
+  }
 
-  hw.ProcessAllControls();
-  gate.Debounce();
+  if (calibration_pending)
+  {
+    calibration_pending = false;
+    synth.GetPitchCv().SetCalibration(new_calibration);
+    TraceCalibration(new_calibration);
+    scheduler.Signal(save_calibration_task);
+  }
 
   // monitor the gate input and output it to CV_OUT_2
-  if (gate.RawState())
+  if (gate.IsHigh())
   {
     hw.WriteCvOut(CV_OUT_2, 5.f);
   }
@@ -68,77 +166,106 @@ static void AudioCallback(AudioHandle::InputBuffer in,
     hw.WriteCvOut(CV_OUT_2, 0.f);
   }
 
-  // On a gate rising edge, set the frequency of the active voice
-  // and then trigger it. then move to the next voice
-  if (gate.RisingEdge())
-  {
-    float coarse_knob = hw.GetAdcValue(CV_1);
-    float coarse = fmap(coarse_knob, 0.f, 96.f);
-    float voct_cv = hw.GetAdcValue(CV_5); // TODO: This is not accurate v/oct conversion at all!
-    float voct = fmap(voct_cv, 0.f, 60.f);
-    float midi_nn = fclamp(coarse + voct, 0.f, 127.f);
-    float freq = mtof(midi_nn); // Convert note to freq
-    voices[active_voice_index].Trigger(freq);
-
-    // naive Round-robin voice steal
-    int next_voice = (active_voice_index + 1) % NUM_VOICES;
-    active_voice_index = next_voice;
-  }
+  daisybed::ParaphonicControls controls;
+  controls.coarse_knob = control_scanner.Adc(0);
+  controls.attack_knob = control_scanner.Adc(1);
+  controls.cutoff_knob = control_scanner.Adc(2);
+  controls.release_knob = control_scanner.Adc(3);
+  controls.voct_raw = hw.controls[CV_5].Process();
 
-  float filterCutKnob = hw.GetAdcValue(CV_3);
-  float filterCutoff = fmap(filterCutKnob, 0.f, 3000.f);
-  float rel_knob = hw.GetAdcValue(CV_4);
-  float releaseTime = fmap(rel_knob, 0.01f, 2.f);
-  float att_knob = hw.GetAdcValue(CV_2);
-  float attackTime = fmap(att_knob, 0.01f, 1.f);
+  trace.Knob(0, controls.coarse_knob);
+  trace.Knob(1, controls.attack_knob);
+  trace.Knob(2, controls.cutoff_knob);
+  trace.Knob(3, controls.release_knob);
+  trace.Knob(4, controls.voct_raw);
 
-  // Apply envelope times to *all* voices
-  for (size_t v = 0; v < NUM_VOICES; v++)
+  // Gate rising edges become triggers, except while calibrating, when they
+  // capture the V/Oct reading instead.
+  controls.trigger_count = 0;
+  size_t offset;
+  while (gate.NextRisingEdge(offset))
   {
-    voices[v].envelope.SetTime(ADENV_SEG_ATTACK, attackTime);
-    voices[v].envelope.SetTime(ADENV_SEG_DECAY, releaseTime);
+    if (calibration_step != CALIBRATION_OFF)
+    {
+      CalibrationEdge(controls.voct_raw);
+      continue;
+    }
+    if (controls.trigger_count < daisybed::ParaphonicControls::kMaxTriggers)
+    {
+      controls.triggers[controls.trigger_count++] = offset;
+      trace.Gate(offset, true);
+    }
   }
 
-  // Update filter freq
-  svf.SetFreq(filterCutoff);
+  synth.ProcessBlock(controls, daisybed::ViewStereo(out, size));
 
-  for (size_t i = 0; i < size; i++)
+  // Stage meters ride along with the trace, ~20 readings a second.
+  if (trace.MeterDue())
   {
-    float mix = 0.f;
-    // Sum all voices
-    for (size_t v = 0; v < NUM_VOICES; v++)
+    for (int meter = 0; meter < daisybed::ParaphonicSynth::kNumMeters; meter++)
     {
-      mix += voices[v].Process();
+      trace.Meter(meter, synth.GetMeter(meter).Read());
     }
-
-    // Process sum through the single filter
-    svf.Process(mix);
-
-    OUT_L[i] = svf.Low();
-    OUT_R[i] = svf.Low();
   }
 }
 
 int main(void)
 {
   hw.Init();
+  hw.SetAudioBlockSize(kAudioConfig.block_size);
+
+  daisybed::PitchCalibration default_calibration
+      = daisybed::PitchCalibration::Default();
+  calibration_storage.Init(default_calibration);
+  synth.Init(hw.AudioSampleRate(), calibration_storage.GetSettings());
 
-  // Initialize all voices
-  for (size_t v = 0; v < NUM_VOICES; v++)
+  if (hw.gate_in_1.State())
   {
-    voices[v].Init(hw.AudioSampleRate());
+    calibration_step = CALIBRATION_WAIT_1V;
+    hw.SetLed(true);
   }
 
-  svf.Init(hw.AudioSampleRate());
-  svf.SetFreq(1000.f);
-  svf.SetRes(0.7f);
+  // Edges are timestamped in the pin interrupt and placed sample-accurately
+  // inside the next audio block.
+  gate.Init(System::GetTickFreq(), hw.AudioSampleRate());
+  daisybed::StartGateInterrupt(gate, hw.B10);
 
-  gate.Init(hw.B10, hw.AudioCallbackRate());
+  if (daisybed::TraceRecorder::kEnabled)
+  {
+    usb.Init(UsbHandle::FS_INTERNAL);
+  }
+  trace.Init(daisybed::TraceFirmware::kAwfulParaphonic,
+             hw.AudioSampleRate(),
+             hw.AudioBlockSize());
+  // The stored calibration is part of the replay's starting state.
+  TraceCalibration(calibration_storage.GetSettings());
 
-  // Start audio engine
-  hw.StartAudio(AudioCallback);
+  // Knob smoothing runs at the scan rate and V/Oct has none; scan once so
+  // the first block sees real knob readings.
+  for (int i = 0; i < kNumKnobs; i++)
+  {
+    hw.controls[CV_1 + i].SetSampleRate(kAudioConfig.ControlRate());
+  }
+  hw.controls[CV_5].SetSampleRate(kVoctControlRate);
+  control_scanner.Init();
+  ScanControls(nullptr);
 
-  while (1)
+  // Keep the filter state out of subnormals once the voices fall silent.
+  daisybed::EnableFlushToZero();
+
+  // A QSPI sector erase takes tens of milliseconds; the deadline only
+  // flags a save that took pathologically long.
+  scheduler.Init(&scheduler_clock);
+  save_calibration_task = scheduler.AddEvent(SaveCalibration, nullptr, 500000);
+  scheduler.AddPeriodic(
+      ScanControls, nullptr, kAudioConfig.ControlTaskPeriodUs());
+  if (daisybed::TraceRecorder::kEnabled)
   {
+    scheduler.AddPeriodic(DrainTrace, nullptr, 1000);
   }
+
+  // Start audio engine
+  hw.StartAudio(AudioCallback);
+
+  scheduler.Run();
 }
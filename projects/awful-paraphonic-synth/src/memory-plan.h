@@ -0,0 +1,29 @@
+#pragma once
+
+#include "MemoryPlan.h"
+#include "ControlScanner.h"
+#include "GateInput.h"
+#include "ParaphonicSynth.h"
+#include "TraceStream.h"
+
+// CV_1..CV_4, the knobs. CV_5 (V/Oct) is read in the audio callback.
+static const int kNumKnobs = 4;
+
+// Where awful-paraphonic's statics live; awful-paraphonic.cpp places them to
+// match. There are no delay lines: the voices, filter, gate queue and
+// control scanner are all small and run every block, so they go in DTCM.
+static constexpr daisybed::Allocation kParaphonicMemoryPlan[] = {
+    {"synth", daisybed::MemoryRegion::kDtcm, sizeof(daisybed::ParaphonicSynth)},
+    {"gate", daisybed::MemoryRegion::kDtcm, sizeof(daisybed::GateInput)},
+    {"control_scanner", daisybed::MemoryRegion::kDtcm, sizeof(daisybed::ControlScanner<kNumKnobs>)},
+#if DAISYBED_TRACE
+    {"trace", daisybed::MemoryRegion::kSram, sizeof(daisybed::TraceRecorder)},
+#endif
+};
+
+static_assert(daisybed::Fits(kParaphonicMemoryPlan, daisybed::MemoryRegion::kDtcm),
+              "awful-paraphonic: DTCM plan over budget");
+static_assert(daisybed::Fits(kParaphonicMemoryPlan, daisybed::MemoryRegion::kSram),
+              "awful-paraphonic: SRAM plan over budget");
+static_assert(daisybed::Fits(kParaphonicMemoryPlan, daisybed::MemoryRegion::kSdram),
+              "awful-paraphonic: SDRAM plan over budget");
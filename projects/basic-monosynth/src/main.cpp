@@ -1,218 +1,162 @@
 #include "daisy_pod.h"
 #include "daisysp.h"
-#include "knob.h"
-#include "Voice.h"
+#include "SynthEngine.h"
+#include "AudioSpan.h"
+#include "SpscQueue.h"
+#include "Denormals.h"
+#include "LoadGovernor.h"
+#include "TraceStream.h"
+#include "DaisyClock.h"
+#include "Scheduler.h"
+#include "AudioConfig.h"
+#include "ControlScanner.h"
+#include "PresetStore.h"
+#include "QspiFlash.h"
+#include "memory-plan.h"
 
 using namespace daisy;
 using namespace daisysp;
 
-const int NUM_VOICES = 10;
-// Mode tracking
-enum Mode {
-    MODE_DEFAULT,
-    MODE_FILTER,
-    MODE_AD,
-    MODE_REVERB
-};
-Mode currentMode = MODE_DEFAULT;
-
+// The voices, filter, reverb and knob modes live in SynthEngine.h so the host
+// tools can run them; this file is the Pod glue around it. The statics are
+// placed as memory-plan.h lays out.
 DaisyPod hw;
-Svf filter;
-Voice voices[NUM_VOICES];
-
-// Simple Schroeder Reverb implementation
-class SimpleReverb {
-private:
-    static const int NUM_COMBS = 8;
-    static const int NUM_ALLPASS = 4;
-    
-    // Larger delay lines for longer reverb tail
-    DelayLine<float, 8192> combDelays[NUM_COMBS];     // Doubled buffer size
-    DelayLine<float, 4096> allpassDelays[NUM_ALLPASS]; // Doubled buffer size
-    
-    // Higher feedback coefficients for longer decay
-    float combFeedback[NUM_COMBS] = {0.95f, 0.94f, 0.93f, 0.92f, 0.91f, 0.90f, 0.89f, 0.88f};
-    float allpassFeedback = 0.85f;  // Increased from 0.8
-    
-    // Longer delay lengths (still using prime numbers)
-    int combLengths[NUM_COMBS] = {7919, 8147, 8423, 8699, 8969, 9241, 9511, 9767};
-    int allpassLengths[NUM_ALLPASS] = {2371, 3079, 3677, 4177};
-    
-    float mix = 0.5f;
-    float feedback = 0.85f;
-
-public:
-    void Init(float sampleRate) {
-        for(int i = 0; i < NUM_COMBS; i++) {
-            combDelays[i].Init();
-            combDelays[i].SetDelay(static_cast<size_t>(combLengths[i]));
-        }
-        for(int i = 0; i < NUM_ALLPASS; i++) {
-            allpassDelays[i].Init();
-            allpassDelays[i].SetDelay(static_cast<size_t>(allpassLengths[i]));
-        }
-    }
-    
-    void SetMix(float newMix) { mix = newMix; }
-    void SetFeedback(float newFeedback) { 
-        feedback = newFeedback;
-        for(int i = 0; i < NUM_COMBS; i++) {
-            combFeedback[i] = feedback * (0.88f - i * 0.01f);  // Higher base feedback
-        }
-    }
-    
-    float Process(float in) {
-        float combOut = 0.0f;
-        
-        // Parallel comb filters
-        for(int i = 0; i < NUM_COMBS; i++) {
-            float delay = combDelays[i].Read();
-            combDelays[i].Write(in + delay * combFeedback[i]);
-            combOut += delay;
-        }
-        combOut *= 0.16f;  // Adjusted scaling for 6 combs
-        
-        // Series allpass filters
-        float allpassOut = combOut;
-        for(int i = 0; i < NUM_ALLPASS; i++) {
-            float delay = allpassDelays[i].Read();
-            float temp = allpassOut + delay * allpassFeedback;
-            allpassDelays[i].Write(temp);
-            allpassOut = delay - temp * allpassFeedback;
-        }
-        
-        // Mix dry and wet with slight emphasis on wet signal
-        return in * (1.0f - mix) + allpassOut * (mix * 1.2f);
-    }
-};
+static daisybed::SynthEngine synth;
+
+CpuLoadMeter loadMeter;
+daisybed::LoadGovernor DTCM_MEM_SECTION governor;
+
+// Configured with -DDAISYBED_TRACE=ON, everything the callback consumes is
+// streamed over USB for replay on the host. The USB handle is the firmware's
+// own, as on the Patch SM firmwares, rather than hw.seed.usb_handle.
+static daisybed::TraceRecorder trace;
+static UsbHandle usb;
+static uint32_t blockCount = 0;
+
+// Everything outside the audio callback runs as a scheduler task; the core
+// sleeps in between.
+static daisybed::DaisyClock schedulerClock;
+static daisybed::Scheduler<daisybed::DaisyClock> scheduler;
 
-static SimpleReverb reverb;
+// libDaisy's default 48-sample block, with controls and MIDI polled every
+// block (1 ms). The budget is for note-on to sound. A poll can wait behind a
+// save step already running (a page program, up to 0.8 ms) and behind a
+// control scan and a trace drain due first (well under 0.3 ms together).
+// A save's sector erase is the exception: it holds the poll for the whole
+// erase, which the two-second debounce keeps to after the controls settle.
+static constexpr float POLL_LATE_US = 1100.0f;
+static constexpr daisybed::AudioConfig AUDIO_CONFIG = {
+    48000.0f, 48, 1, daisybed::kCodecDelayUs, POLL_LATE_US};
+static_assert(AUDIO_CONFIG.WorstMidiLatencyUs() <= 5000.0f,
+              "basic-monosynth: note-on to sound must stay under 5 ms");
 
-// Waveform selection
-int currentWaveform = 0;
-const int NUM_WAVEFORMS = 4;
-const int WAVEFORMS[NUM_WAVEFORMS] = {
-    Oscillator::WAVE_POLYBLEP_SAW,
-    Oscillator::WAVE_POLYBLEP_SQUARE,
-    Oscillator::WAVE_POLYBLEP_TRI,
-    Oscillator::WAVE_SIN
+// Knobs, encoder and buttons are scanned at the control rate by a scheduler
+// task, not per audio block, so the block size can shrink without the scan
+// cost growing with it.
+static daisybed::ControlScanner<2, 2> DTCM_MEM_SECTION controlScanner;
+
+// MIDI is parsed in the main loop but applied at the top of the next audio
+// block, so note handling never races the voice loop and lands on a block
+// boundary the trace can reproduce.
+struct MidiBytes {
+    uint8_t status;
+    uint8_t data0;
+    uint8_t data1;
 };
+static daisybed::SpscQueue<MidiBytes, 256> midiQueue;
 
-// Control parameters with knobs
-struct Controls {
-    Knob attackKnob;
-    Knob releaseKnob;
-    Knob cutoffKnob;
-    Knob resonanceKnob;
-    Knob reverbFeedbackKnob;
-    Knob reverbMixKnob;
-    
-    // Add constructor with initialization list
-    Controls() : attackKnob(), releaseKnob(), cutoffKnob(), resonanceKnob(), 
-                reverbFeedbackKnob(), reverbMixKnob() {}
-    
-    void Init() {
-        attackKnob.Init(0.005f, 0.001f, 1.0f);
-        releaseKnob.Init(0.15f, 0.1f, 1.0f);
-        cutoffKnob.Init(2000.0f, 200.0f, 10000.0f);
-        resonanceKnob.Init(0.4f, 0.1f, 0.95f);
-        reverbFeedbackKnob.Init(0.7f, 0.4f, 0.95f);  // Higher default and min feedback
-        reverbMixKnob.Init(0.4f, 0.1f, 0.9f);  // Higher default mix and range
-    }
-    
-    void ResetMode(Mode mode) {
-        switch(mode) {
-            case MODE_AD:
-                attackKnob.Reset();
-                releaseKnob.Reset();
-                break;
-            case MODE_FILTER:
-                cutoffKnob.Reset();
-                resonanceKnob.Reset();
-                break;
-            case MODE_REVERB:
-                reverbFeedbackKnob.Reset();
-                reverbMixKnob.Reset();
-                break;
-            default:
-                break;
-        }
+// The last preset is kept in the top 32 KB of the QSPI chip and written back
+// by a scheduler task a flash operation at a time. The callback hands a
+// snapshot of the engine to the main loop every PRESET_CAPTURE_BLOCKS blocks;
+// once the same settings have been captured for PRESET_STABLE_CAPTURES in a
+// row (~2 s) and differ from what was saved, they are saved. A preset loaded
+// at boot goes the other way and is applied at the top of a block, whole.
+static constexpr uint32_t PRESET_SECTORS = 8;
+static constexpr uint32_t PRESET_ADDRESS = 0x800000 - PRESET_SECTORS * 4096;
+static constexpr uint32_t PRESET_CAPTURE_BLOCKS = 100;
+static constexpr int PRESET_STABLE_CAPTURES = 20;
+static daisybed::QspiFlash presetFlash(hw.seed.qspi);
+static daisybed::PresetStore<daisybed::QspiFlash> presetStore;
+static daisybed::SpscQueue<daisybed::SynthSnapshot, 2> presetLoadQueue;
+static daisybed::SpscQueue<daisybed::SynthSnapshot, 4> presetCaptureQueue;
+static daisybed::SynthSnapshot savedPreset;
+static daisybed::SynthSnapshot capturedPreset;
+static int stableCaptures = 0;
+
+void QueueMidiMessage(MidiEvent m) {
+    uint8_t status;
+    switch(m.type) {
+        case NoteOn: status = 0x90; break;
+        case NoteOff: status = 0x80; break;
+        case ControlChange: status = 0xB0; break;
+        default: return;
     }
-} controls;
-
-// Find oldest voice to steal
-int findOldestVoice() {
-    int oldestIdx = 0;
-    uint32_t oldestAge = voices[0].GetAge();
-    
-    for(int i = 1; i < NUM_VOICES; i++) {
-        if(voices[i].GetAge() > oldestAge) {
-            oldestAge = voices[i].GetAge();
-            oldestIdx = i;
-        }
+    MidiBytes bytes = {static_cast<uint8_t>(status | m.channel), m.data[0], m.data[1]};
+    midiQueue.Push(bytes);
+}
+
+// Scheduler task: move parsed TRS MIDI into the queue the callback reads.
+void PollMidi(void *) {
+    hw.midi.Listen();
+    while(hw.midi.HasEvents()) {
+        QueueMidiMessage(hw.midi.PopEvent());
     }
-    return oldestIdx;
 }
 
-// Find available voice or steal oldest if needed
-int findAvailableVoice(int noteNumber) {
-    // First, check if this note is already playing (prevent retriggering)
-    for(int i = 0; i < NUM_VOICES; i++) {
-        if(voices[i].GetNote() == noteNumber && voices[i].IsActive()) {
-            return -1;
+void ScanControls(void *) {
+    hw.ProcessAllControls();
+    float knobs[2] = {hw.GetKnobValue(DaisyPod::KNOB_1), hw.GetKnobValue(DaisyPod::KNOB_2)};
+    bool buttons[2] = {hw.button1.Pressed(), hw.button2.Pressed()};
+    controlScanner.Scan(knobs, hw.encoder.Increment(), buttons);
+}
+
+// Scheduler task: debounce the captured snapshots and advance the save in
+// progress by one step: start an erase or check on it, program a page, or
+// verify.
+void SavePreset(void *) {
+    daisybed::SynthSnapshot snapshot;
+    while(presetCaptureQueue.Pop(snapshot)) {
+        if(memcmp(&snapshot, &capturedPreset, sizeof(snapshot)) != 0) {
+            capturedPreset = snapshot;
+            stableCaptures = 0;
+        } else if(stableCaptures < PRESET_STABLE_CAPTURES) {
+            stableCaptures++;
         }
     }
-    
-    // Then, look for an inactive voice
-    for(int i = 0; i < NUM_VOICES; i++) {
-        if(!voices[i].IsActive()) {
-            return i;
+
+    if(stableCaptures == PRESET_STABLE_CAPTURES && !presetStore.IsBusy()
+       && memcmp(&capturedPreset, &savedPreset, sizeof(savedPreset)) != 0) {
+        if(presetStore.BeginSave(capturedPreset, daisybed::SynthSnapshot::VERSION)) {
+            savedPreset = capturedPreset;
         }
     }
-    
-    // If all voices are active, steal the oldest one
-    return findOldestVoice();
+    presetStore.Step();
 }
 
-void HandleMidiMessage(MidiEvent m) {
-    switch(m.type) {
-        case NoteOn: {
-            NoteOnEvent p = m.AsNoteOn();
-            if(p.velocity == 0) {
-                // Note-off message in disguise
-                for(int i = 0; i < NUM_VOICES; i++) {
-                    if(voices[i].GetNote() == p.note && voices[i].IsActive()) {
-                        voices[i].Release();
-                    }
-                }
-                return;
-            }
-            
-            int voice = findAvailableVoice(p.note);
-            if(voice == -1) return; // Note is already playing
-            
-            // Set up the voice
-            voices[voice].SetNote(p.note, p.velocity / 127.0f);
-            
-            // Increment age of other voices
-            for(int i = 0; i < NUM_VOICES; i++) {
-                if(i != voice && voices[i].IsActive()) {
-                    voices[i].IncrementAge();
-                }
-            }
-            
-            break;
-        }
-        
-        case NoteOff: {
-            NoteOffEvent p = m.AsNoteOff();
-            for(int i = 0; i < NUM_VOICES; i++) {
-                if(voices[i].GetNote() == p.note && voices[i].IsActive()) {
-                    voices[i].Release();
-                }
-            }
-            break;
-        }
+void DrainTrace(void *) {
+    trace.Drain([](const uint8_t *data, size_t size) {
+        return usb.TransmitInternal(const_cast<uint8_t *>(data), size)
+               == UsbHandle::Result::OK;
+    });
+}
+
+void UpdateModeLeds(daisybed::SynthEngine::Mode mode) {
+    // Turn off both LEDs and then set the active one
+    hw.led1.Set(0.0f, 0.0f, 0.0f);
+    hw.led2.Set(0.0f, 0.0f, 0.0f);
+    if(mode == daisybed::SynthEngine::MODE_FILTER) {
+        hw.led1.Set(1.0f, 0.0f, 0.0f);
+    } else if(mode == daisybed::SynthEngine::MODE_AD) {
+        hw.led2.Set(0.0f, 0.0f, 1.0f);
+    } else if(mode == daisybed::SynthEngine::MODE_REVERB) {
+        hw.led2.Set(0.0f, 1.0f, 0.0f);
+    }
+    hw.UpdateLeds();
+}
+
+void TracePreset(const daisybed::SynthSnapshot &preset) {
+    for(int f = 0; f < daisybed::SynthSnapshot::NUM_FIELDS; f++) {
+        trace.Config(f, preset.values[f]);
     }
 }
 
@@ -220,177 +164,116 @@ void AudioCallback(AudioHandle::InputBuffer in,
                   AudioHandle::OutputBuffer out,
                   size_t size)
 {
-    hw.ProcessAllControls();
+    loadMeter.OnBlockStart();
+    controlScanner.BeginBlock();
+    trace.BeginBlock(blockCount++);
 
-    // Handle encoder for waveform selection
-    int32_t inc = hw.encoder.Increment();
-    if(inc != 0) {
-        currentWaveform = (currentWaveform + inc) % NUM_WAVEFORMS;
-        if(currentWaveform < 0) currentWaveform = NUM_WAVEFORMS - 1;
-        
-        // Set all oscillators to the same waveform
-        for(int v = 0; v < NUM_VOICES; v++) {
-            voices[v].osc.SetWaveform(WAVEFORMS[currentWaveform]);
-        }
+    int level = governor.Update(loadMeter.GetAvgCpuLoad());
+    trace.Level(level);
+    synth.SetQualityLevel(level);
+
+    MidiBytes m;
+    while(midiQueue.Pop(m)) {
+        trace.Midi(m.status, m.data0, m.data1);
+        synth.HandleMidi(m.status, m.data0, m.data1);
     }
 
-    // Handle mode switching
-    if(hw.button1.RisingEdge()) {
-        if(currentMode == MODE_FILTER) {
-            currentMode = MODE_DEFAULT;
-        } else {
-            currentMode = MODE_FILTER;
-        }
-        controls.ResetMode(currentMode);
-        
-        // Turn off both LEDs and then set the active one
-        hw.led1.Set(0.0f, 0.0f, 0.0f);
-        hw.led2.Set(0.0f, 0.0f, 0.0f);
-        if(currentMode == MODE_FILTER) {
-            hw.led1.Set(1.0f, 0.0f, 0.0f);
-        }
-        hw.UpdateLeds();
+    daisybed::SynthSnapshot preset;
+    if(presetLoadQueue.Pop(preset)) {
+        synth.ApplySnapshot(preset);
+        TracePreset(preset);
+    } else if(trace.SyncDue()) {
+        // A reader that attached late needs the sounding preset too.
+        synth.GetSnapshot(preset);
+        TracePreset(preset);
     }
-    
-    if(hw.button2.RisingEdge()) {
-        if(currentMode == MODE_AD) {
-            currentMode = MODE_REVERB;
-        } else if(currentMode == MODE_REVERB) {
-            currentMode = MODE_DEFAULT;
-        } else {
-            currentMode = MODE_AD;
-        }
-        controls.ResetMode(currentMode);
-        
-        // Turn off both LEDs and then set the active one
-        hw.led1.Set(0.0f, 0.0f, 0.0f);
-        hw.led2.Set(0.0f, 0.0f, 0.0f);
-        if(currentMode == MODE_AD) {
-            hw.led2.Set(0.0f, 0.0f, 1.0f);
-        } else if(currentMode == MODE_REVERB) {
-            hw.led2.Set(0.0f, 1.0f, 0.0f);
-        }
-        hw.UpdateLeds();
+
+    daisybed::SynthControls controls;
+    controls.encoderIncrement = controlScanner.EncoderIncrement();
+    controls.button1Rising = controlScanner.RisingEdge(0);
+    controls.button2Rising = controlScanner.RisingEdge(1);
+    controls.knob1 = controlScanner.Adc(0);
+    controls.knob2 = controlScanner.Adc(1);
+
+    trace.Encoder(controls.encoderIncrement);
+    trace.Button(0, controls.button1Rising);
+    trace.Button(1, controls.button2Rising);
+    trace.Knob(0, controls.knob1);
+    trace.Knob(1, controls.knob2);
+
+    if(synth.ProcessControls(controls)) {
+        UpdateModeLeds(synth.GetMode());
     }
 
-    float knob1 = hw.GetKnobValue(DaisyPod::KNOB_1);
-    float knob2 = hw.GetKnobValue(DaisyPod::KNOB_2);
-
-    switch(currentMode) {
-        case MODE_AD:
-            if (controls.attackKnob.Update(knob1)) {
-                float attackTime = controls.attackKnob.GetValue();
-                for(int v = 0; v < NUM_VOICES; v++) {
-                    voices[v].env.SetTime(ADENV_SEG_ATTACK, attackTime);
-                }
-            }
-            
-            if (controls.releaseKnob.Update(knob2)) {
-                float releaseTime = controls.releaseKnob.GetValue();
-                for(int v = 0; v < NUM_VOICES; v++) {
-                    voices[v].env.SetTime(ADENV_SEG_DECAY, releaseTime);
-                }
-            }
-            break;
-
-        case MODE_FILTER:
-            if (controls.cutoffKnob.Update(knob1)) {
-                filter.SetFreq(controls.cutoffKnob.GetValue());
-            }
-            
-            if (controls.resonanceKnob.Update(knob2)) {
-                filter.SetRes(controls.resonanceKnob.GetValue());
-            }
-            break;
-
-        case MODE_REVERB:
-            if (controls.reverbFeedbackKnob.Update(knob1)) {
-                reverb.SetFeedback(controls.reverbFeedbackKnob.GetValue());
-            }
-            
-            if (controls.reverbMixKnob.Update(knob2)) {
-                reverb.SetMix(controls.reverbMixKnob.GetValue());
-            }
-            break;
-
-        case MODE_DEFAULT:
-            break;
+    if(blockCount % PRESET_CAPTURE_BLOCKS == 0) {
+        synth.GetSnapshot(preset);
+        presetCaptureQueue.Push(preset);
     }
 
-    for(size_t i = 0; i < size; i++)
-    {
-        float signal = 0.0f;
-        for(int v = 0; v < NUM_VOICES; v++) {
-            float envValue = voices[v].env.Process();
-            // Check if envelope is done releasing
-            if(voices[v].IsActive() && envValue < 0.001f) {
-                voices[v].Clear();
-            }
-            
-            float voiceOutput = voices[v].osc.Process() * envValue;
-            // Use voice if either active or releasing
-            if(voices[v].IsActive()) {
-                signal += voiceOutput;
-            }
+    synth.ProcessBlock(daisybed::ViewStereo(out, size));
+
+    // Stage meters ride along with the trace, ~20 readings a second.
+    if(trace.MeterDue()) {
+        for(int m = 0; m < daisybed::SynthEngine::NUM_METERS; m++) {
+            trace.Meter(m, synth.GetMeter(m).Read());
         }
-        
-        // Scale final mix to prevent clipping
-        signal *= (0.7f / NUM_VOICES);  // Reduced further for reverb headroom
-        
-        filter.Process(signal);
-        float filtered = filter.Low();
-        
-        // Add safety clipping
-        filtered = fclamp(filtered, -1.0f, 1.0f);
-        
-        // Process reverb
-        float processed = reverb.Process(filtered);
-        
-        out[0][i] = processed;
-        out[1][i] = processed;
     }
+
+    loadMeter.OnBlockEnd();
 }
 
 int main(void)
 {
     hw.Init();
+    hw.SetAudioBlockSize(AUDIO_CONFIG.block_size);
     hw.StartAdc();
-    
+
     // Initialize MIDI for TRS input
     hw.midi.StartReceive();
-    
-    // Initialize all oscillators
+
     float sampleRate = hw.AudioSampleRate();
-    filter.Init(sampleRate);
-    
-    // Initialize reverb
-    reverb.Init(sampleRate);
-    reverb.SetFeedback(0.7f);  // Higher initial feedback
-    reverb.SetMix(0.4f);  // Higher initial mix
-    
-    // Initialize oscillators and envelopes for each voice
-    for(int v = 0; v < NUM_VOICES; v++) {
-        voices[v].Init(sampleRate);
+    synth.Init(sampleRate);
+
+    // The saved preset is applied by the first audio block; with none, the
+    // defaults count as saved, so an untouched synth never writes flash.
+    presetStore.Init(&presetFlash, PRESET_ADDRESS, PRESET_SECTORS);
+    if(presetStore.Load(savedPreset, daisybed::SynthSnapshot::VERSION)) {
+        presetLoadQueue.Push(savedPreset);
+    } else {
+        synth.GetSnapshot(savedPreset);
     }
+    capturedPreset = savedPreset;
 
-    // Initialize controls
-    controls.Init();
+    // A fast-ish meter so the governor reacts within a few blocks.
+    loadMeter.Init(sampleRate, hw.AudioBlockSize(), 20.0f);
+    governor.Init(daisybed::SynthEngine::MAX_QUALITY_LEVEL);
 
-    // Set up filter
-    filter.SetRes(0.4f);  // Set a moderate fixed resonance
+    if(daisybed::TraceRecorder::kEnabled) {
+        usb.Init(UsbHandle::FS_INTERNAL);
+    }
+    trace.Init(daisybed::TraceFirmware::kBasicMonosynth, sampleRate, hw.AudioBlockSize());
 
-    hw.StartAudio(AudioCallback);
+    // The knobs' smoothing is set up for the audio callback rate; they are
+    // processed at the scan rate now. Scan once so the first block already
+    // sees real values.
+    hw.knob1.SetSampleRate(AUDIO_CONFIG.ControlRate());
+    hw.knob2.SetSampleRate(AUDIO_CONFIG.ControlRate());
+    controlScanner.Init();
+    ScanControls(nullptr);
 
-    for(;;)
-    {
-        hw.midi.Listen();    
-        // Handle USB MIDI Events
-        while(hw.midi.HasEvents())
-        {
-            HandleMidiMessage(hw.midi.PopEvent());
-        }
+    // Reverb and filter tails would otherwise decay into subnormals.
+    daisybed::EnableFlushToZero();
 
-    }
+    hw.StartAudio(AudioCallback);
 
-    while(1) {}
+    scheduler.Init(&schedulerClock);
+    scheduler.AddPeriodic(ScanControls, nullptr, AUDIO_CONFIG.ControlTaskPeriodUs());
+    scheduler.AddPeriodic(PollMidi, nullptr, AUDIO_CONFIG.ControlTaskPeriodUs());
+    // QspiFlash waits out each sector erase, holding the main loop for tens
+    // of ms; the deadline allows for the chip's worst case.
+    scheduler.AddPeriodic(SavePreset, nullptr, 10000, 500000);
+    if(daisybed::TraceRecorder::kEnabled) {
+        scheduler.AddPeriodic(DrainTrace, nullptr, 1000);
+    }
+    scheduler.Run();
 }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "MemoryPlan.h"
+#include "ControlScanner.h"
+#include "LoadGovernor.h"
+#include "SynthEngine.h"
+#include "TraceStream.h"
+
+// Where basic-monosynth's statics live; main.cpp places them to match. The
+// engine is almost all SimpleReverb delay line, so it stays in SRAM; the
+// control scanner and governor are touched every block and go in DTCM.
+static constexpr daisybed::Allocation MONOSYNTH_MEMORY_PLAN[] = {
+    {"synth", daisybed::MemoryRegion::kSram, sizeof(daisybed::SynthEngine)},
+#if DAISYBED_TRACE
+    {"trace", daisybed::MemoryRegion::kSram, sizeof(daisybed::TraceRecorder)},
+#endif
+    {"controlScanner", daisybed::MemoryRegion::kDtcm, sizeof(daisybed::ControlScanner<2, 2>)},
+    {"governor", daisybed::MemoryRegion::kDtcm, sizeof(daisybed::LoadGovernor)},
+};
+
+static_assert(daisybed::Fits(MONOSYNTH_MEMORY_PLAN, daisybed::MemoryRegion::kDtcm),
+              "basic-monosynth: DTCM plan over budget");
+static_assert(daisybed::Fits(MONOSYNTH_MEMORY_PLAN, daisybed::MemoryRegion::kSram),
+              "basic-monosynth: SRAM plan over budget");
+static_assert(daisybed::Fits(MONOSYNTH_MEMORY_PLAN, daisybed::MemoryRegion::kSdram),
+              "basic-monosynth: SDRAM plan over budget");
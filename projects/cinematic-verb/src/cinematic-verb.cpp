@@ -1,6 +1,15 @@
 #include "daisy_patch_sm.h"
 #include "daisysp.h"
-#include "DattorroPlate.h"
+#include "ShimmerVerb.h"
+#include "AudioSpan.h"
+#include "Denormals.h"
+#include "LoadGovernor.h"
+#include "TraceStream.h"
+#include "DaisyClock.h"
+#include "Scheduler.h"
+#include "AudioConfig.h"
+#include "ControlScanner.h"
+#include "memory-plan.h"
 
 using namespace daisy;
 using namespace patch_sm;
@@ -11,208 +20,210 @@ using namespace daisysp;
 //
 // A Dattorro-style plate reverb (our own MIT implementation, see
 // DattorroPlate.h) whose tail is pitch-shifted upward and fed back into its
-// input, producing a rising angelic / cinematic halo.
+// input, producing a rising angelic / cinematic halo. Forty early reflections
+// (MultiTapDelay.h) ahead of the plate give the space its size. The signal
+// path lives in ShimmerVerb.h so the host tools can run it too.
 //
 // Control layout (Option C). Each knob is summed with its CV jack, so any
 // parameter can be automated from the modular:
-//   K1 + CV_5 -> Size + Tone     (bigger space => longer decay + darker tail)
+//   K1 + CV_5 -> Size + Tone     (bigger space => longer decay + darker tail,
+//                                 later and wider early reflections)
 //   K2 + CV_6 -> Shimmer amount  (how much pitched tail is fed back)
 //   K3 + CV_7 -> Shimmer interval, stepped: +7 | +12 | +12&+19 | +24
 //   K4 + CV_8 -> Dry / Wet mix (equal-power)
+//   Toggle    -> Motion: the size drifts slowly and the input ducks the mix
 //
-// The user LED brightness follows the wet/dry mix.
+// The knobs and CV jacks are scanned by a 1 kHz scheduler task, oversampled
+// and deadbanded, independent of the audio block size. The same task
+// debounces the toggle.
+//
+// The user LED brightness follows the wet/dry mix, through a hardware PWM
+// channel a 1 kHz scheduler task updates.
+//
+// When the callback runs short of CPU a LoadGovernor degrades gracefully:
+//   level 1 -> shimmer runs on the first pitch-shifter only (or half the
+//              grains, see below)
+//   level 2 -> plate tank modulation is frozen as well
+// and restores each step once the load has stayed low for a while.
+//
+// Configured with -DDAISYBED_TRACE=ON, every ADC reading and governor level
+// the callback consumes is streamed over USB for replay on the host, along
+// with the engine's stage meters.
+//
+// Configured with -DDAISYBED_GRAIN_SHIMMER=ON, the shimmer comes from a
+// GrainCloud instead of the two pitch-shifters: a denser, detuned cloud.
 // ----------------------------------------------------------------------------
 
 DaisyPatchSM hardware;
 
-// The plate (~155 KB) and both pitch-shifters (~128 KB each) all fit in SRAM.
-static daisybed::DattorroPlate reverb;
-static PitchShifter            shifter_first;
-static PitchShifter            shifter_second;
-
-static DcBlock shimmer_dc_blocker;
+// Placed as memory-plan.h lays out: the reverb in SRAM, the per-block state
+// in DTCM.
+static daisybed::ShimmerVerb shimmer_verb;
 
-static float previous_wet_left  = 0.f;
-static float previous_wet_right = 0.f;
+static CpuLoadMeter                            load_meter;
+static daisybed::LoadGovernor DTCM_MEM_SECTION governor;
 
-static float smoothed_decay          = 0.7f;
-static float smoothed_brightness     = 0.6f;
-static float smoothed_shimmer_amount = 0.f;
-static float smoothed_mix            = 0.4f;
+static daisybed::TraceRecorder trace;
+static UsbHandle               usb;
+static uint32_t                block_count = 0;
 
-// Written at block rate by the audio callback, read by the LED PWM in main().
+// Written at block rate by the audio callback, read by the LED task.
 static volatile float led_duty_cycle = 0.f;
 
-static const float kHalfPi = 1.5707963f;
+// The user LED (PC7) is TIM3 channel 2's pin: 1 MHz ticks over a 1000-tick
+// period, the 1 kHz, 1 us steps the old software PWM had, with no CPU.
+static PWMHandle      led_pwm;
+static const uint32_t kLedPwmPrescaler = 199; // 200 MHz timer clock / 200
+static const uint32_t kLedPwmPeriod    = 999; // 1000 ticks
+
+// The main loop only runs short tasks; the core sleeps in between.
+static daisybed::DaisyClock                      scheduler_clock;
+static daisybed::Scheduler<daisybed::DaisyClock> scheduler;
+
+// 48-sample blocks keep the per-callback overhead small next to the plate;
+// the control scan runs every block (1 ms). There is no MIDI, so no note
+// latency to budget for.
+static constexpr daisybed::AudioConfig kAudioConfig
+    = daisybed::kDefaultAudioConfig;
+static daisybed::ControlScanner<daisybed::ShimmerVerbControls::kNumAdc>
+    DTCM_MEM_SECTION control_scanner;
+
+// The toggle (B8), debounced by the control task, read by the callback.
+static Switch        motion_switch;
+static volatile bool motion = false;
+static bool          motion_applied = false;
 
-// Panel knob plus its bipolar CV jack. Unpatched jacks read ~0, so the knob
-// alone still spans the full range.
-static inline float KnobPlusControlVoltage(int knob_index, int jack_index)
+static void AudioCallback(AudioHandle::InputBuffer in,
+                          AudioHandle::OutputBuffer out,
+                          size_t size)
 {
-  return fclamp(hardware.GetAdcValue(knob_index)
-                    + hardware.GetAdcValue(jack_index),
-                0.f,
-                1.f);
-}
+  load_meter.OnBlockStart();
+  control_scanner.BeginBlock();
+  trace.BeginBlock(block_count++);
 
-static int interval_step = 1; // Default: octave up.
+  int level = governor.Update(load_meter.GetAvgCpuLoad());
+  trace.Level(level);
+  shimmer_verb.SetQualityLevel(level);
 
-// A little hysteresis around each edge keeps CV noise from flipping the
-// interval mid-tail.
-static int QuantizeInterval(float control)
-{
-  static const float kStepEdges[3] = {0.25f, 0.5f, 0.75f};
-  const float        kHysteresis   = 0.02f;
-  for (int edge = 0; edge < 3; edge++)
+  bool motion_now = motion;
+  if (motion_now != motion_applied || trace.SyncDue())
   {
-    if (interval_step <= edge && control > kStepEdges[edge] + kHysteresis)
-      interval_step = edge + 1;
-    else if (interval_step > edge && control < kStepEdges[edge] - kHysteresis)
-      interval_step = edge;
+    shimmer_verb.SetMotion(motion_now);
+    motion_applied = motion_now;
+    trace.Config(daisybed::ShimmerVerb::kConfigMotion, motion_now ? 1.f : 0.f);
   }
-  return interval_step;
-}
 
-static void SetInterval(int    step_index,
-                        float &semitones_first,
-                        float &gain_first,
-                        float &semitones_second,
-                        float &gain_second)
-{
-  switch (step_index)
+  daisybed::ShimmerVerbControls controls;
+  for (int adc = 0; adc < daisybed::ShimmerVerbControls::kNumAdc; adc++)
   {
-    case 0: // Fifth up: harmonic, pad-like
-      semitones_first  = 7.f;
-      gain_first       = 1.f;
-      semitones_second = 7.f;
-      gain_second      = 0.f;
-      break;
-    case 2: // Octave + fifth: lush cinematic stack
-      semitones_first  = 12.f;
-      gain_first       = 0.8f;
-      semitones_second = 19.f;
-      gain_second      = 0.8f;
-      break;
-    case 3: // Two octaves up: glassy, airy sparkle
-      semitones_first  = 24.f;
-      gain_first       = 1.f;
-      semitones_second = 24.f;
-      gain_second      = 0.f;
-      break;
-    case 1: // Octave up: classic shimmer
-    default:
-      semitones_first  = 12.f;
-      gain_first       = 1.f;
-      semitones_second = 12.f;
-      gain_second      = 0.f;
-      break;
+    controls.adc[adc] = control_scanner.Adc(adc);
+    trace.Knob(adc, controls.adc[adc]);
   }
-}
 
-static void AudioCallback(AudioHandle::InputBuffer in,
-                          AudioHandle::OutputBuffer out,
-                          size_t size)
-{
-  hardware.ProcessAllControls();
+  shimmer_verb.ProcessBlock(controls,
+                            daisybed::ViewStereo(in, size),
+                            daisybed::ViewStereo(out, size));
 
-  float size_control           = KnobPlusControlVoltage(CV_1, CV_5);
-  float shimmer_amount_control = KnobPlusControlVoltage(CV_2, CV_6);
-  float interval_control       = KnobPlusControlVoltage(CV_3, CV_7);
-  float mix_control            = KnobPlusControlVoltage(CV_4, CV_8);
+  // Stage meters ride along with the trace, ~20 readings a second.
+  if (trace.MeterDue())
+  {
+    for (int meter = 0; meter < daisybed::ShimmerVerb::kNumMeters; meter++)
+    {
+      trace.Meter(meter, shimmer_verb.GetMeter(meter).Read());
+    }
+  }
 
-  // K1: bigger => longer tail (more decay) and darker (less brightness).
-  float target_decay      = fmap(size_control, 0.4f, 0.9f);
-  float target_brightness = fmap(1.f - size_control, 0.2f, 0.95f);
-  // K2: shimmer feedback amount.
-  float target_shimmer_amount = fmap(shimmer_amount_control, 0.f, 0.85f);
+  // Squared so the LED fade reads as linear to the eye.
+  float mix      = shimmer_verb.GetMix();
+  led_duty_cycle = mix * mix;
 
-  fonepole(smoothed_decay, target_decay, 0.2f);
-  fonepole(smoothed_brightness, target_brightness, 0.2f);
-  fonepole(smoothed_shimmer_amount, target_shimmer_amount, 0.2f);
-  fonepole(smoothed_mix, mix_control, 0.2f);
+  load_meter.OnBlockEnd();
+}
 
-  // Squared so the LED fade reads as linear to the eye.
-  led_duty_cycle = smoothed_mix * smoothed_mix;
-
-  reverb.SetDecay(smoothed_decay);
-  reverb.SetBrightness(smoothed_brightness);
-
-  // K3: shimmer interval (stepped).
-  float semitones_first, gain_first, semitones_second, gain_second;
-  SetInterval(QuantizeInterval(interval_control),
-              semitones_first,
-              gain_first,
-              semitones_second,
-              gain_second);
-  shifter_first.SetTransposition(semitones_first);
-  shifter_second.SetTransposition(semitones_second);
-
-  // K4: equal-power dry/wet gains.
-  float dry_gain = cosf(smoothed_mix * kHalfPi);
-  float wet_gain = sinf(smoothed_mix * kHalfPi);
-
-  for (size_t sample = 0; sample < size; sample++)
+static void ScanControls(void *)
+{
+  hardware.ProcessAnalogControls();
+  float adc[daisybed::ShimmerVerbControls::kNumAdc];
+  for (int i = 0; i < daisybed::ShimmerVerbControls::kNumAdc; i++)
   {
-    float dry_left  = IN_L[sample];
-    float dry_right = IN_R[sample];
-
-    // Pitch-shift the previous (mono) tail upward for the shimmer feedback.
-    float tail = 0.5f * (previous_wet_left + previous_wet_right);
-    float shifted_first  = shifter_first.Process(tail);
-    float shifted_second = shifter_second.Process(tail);
-    float mixed_shift = shifted_first * gain_first
-                        + shifted_second * gain_second;
-    float shimmer     = smoothed_shimmer_amount * mixed_shift;
-    // Soft-limit + DC-block so the feedback loop blooms instead of blowing up.
-    shimmer = shimmer_dc_blocker.Process(tanhf(shimmer));
-
-    float wet_left, wet_right;
-    reverb.Process(dry_left + shimmer,
-                   dry_right + shimmer,
-                   wet_left,
-                   wet_right);
-
-    previous_wet_left  = wet_left;
-    previous_wet_right = wet_right;
-
-    OUT_L[sample] = dry_left * dry_gain + wet_left * wet_gain;
-    OUT_R[sample] = dry_right * dry_gain + wet_right * wet_gain;
+    adc[i] = hardware.GetAdcValue(CV_1 + i);
   }
+  control_scanner.Scan(adc, 0, nullptr);
+
+  motion_switch.Debounce();
+  motion = motion_switch.Pressed();
+}
+
+// The timer does the pulses; this only moves the compare value.
+static void UpdateLed(void *)
+{
+  led_pwm.Channel2().Set(led_duty_cycle);
+}
+
+static void DrainTrace(void *)
+{
+  trace.Drain([](const uint8_t *data, size_t size) {
+    return usb.TransmitInternal(const_cast<uint8_t *>(data), size)
+           == UsbHandle::Result::OK;
+  });
 }
 
 int main(void)
 {
   hardware.Init();
+  hardware.SetAudioBlockSize(kAudioConfig.block_size);
 
   float sample_rate = hardware.AudioSampleRate();
 
-  reverb.Init(sample_rate);
+  shimmer_verb.Init(sample_rate);
 
-  shifter_first.Init(sample_rate);
-  shifter_second.Init(sample_rate);
-  // A touch of internal modulation keeps the shimmer voices from sounding static.
-  shifter_first.SetFun(0.1f);
-  shifter_second.SetFun(0.1f);
+  // A fast-ish meter so the governor reacts within a few blocks.
+  load_meter.Init(sample_rate, hardware.AudioBlockSize(), 20.f);
+  governor.Init(2);
 
-  shimmer_dc_blocker.Init(sample_rate);
+  // Takes the LED pin over from the GPIO hardware.Init() set up.
+  led_pwm.Init(PWMHandle::Config(
+      PWMHandle::Config::Peripheral::TIM_3, kLedPwmPrescaler, kLedPwmPeriod));
+  led_pwm.Channel2().Init(PWMHandle::Channel::Config(
+      Pin(PORTC, 7), PWMHandle::Channel::Config::Polarity::HIGH));
+  led_pwm.Channel2().Set(0.f);
 
-  hardware.StartAudio(AudioCallback);
+  if (daisybed::TraceRecorder::kEnabled)
+  {
+    usb.Init(UsbHandle::FS_INTERNAL);
+  }
+  trace.Init(daisybed::TraceFirmware::kCinematicVerb,
+             sample_rate,
+             hardware.AudioBlockSize());
 
-  // Software PWM for the user LED, which is a plain on/off GPIO. The duty
-  // cycle is sampled once per period so the pulse width never changes
-  // mid-period, and unsigned subtraction stays correct across timer wrap.
-  const uint32_t kLedPeriodMicroseconds = 1000;
-  uint32_t       period_start           = System::GetUs();
-  uint32_t       on_time                = 0;
+  // The ADC smoothing runs at the scan rate, not the callback rate. One scan
+  // up front so the first block doesn't see zeros.
+  for (int i = 0; i < daisybed::ShimmerVerbControls::kNumAdc; i++)
+  {
+    hardware.controls[CV_1 + i].SetSampleRate(kAudioConfig.ControlRate());
+  }
+  control_scanner.Init();
+  for (int i = daisybed::ShimmerVerbControls::kNumAdc / 2;
+       i < daisybed::ShimmerVerbControls::kNumAdc;
+       i++)
+  {
+    control_scanner.SetRange(i, -1.f, 1.f); // the CV jacks
+  }
+  motion_switch.Init(DaisyPatchSM::B8, kAudioConfig.ControlRate());
+  ScanControls(nullptr);
 
-  while (1)
+  // The plate tail and the DC blocker both decay toward subnormals in silence.
+  daisybed::EnableFlushToZero();
+
+  hardware.StartAudio(AudioCallback);
+
+  scheduler.Init(&scheduler_clock);
+  scheduler.AddPeriodic(
+      ScanControls, nullptr, kAudioConfig.ControlTaskPeriodUs());
+  scheduler.AddPeriodic(UpdateLed, nullptr, 1000);
+  if (daisybed::TraceRecorder::kEnabled)
   {
-    uint32_t now = System::GetUs();
-    if (now - period_start >= kLedPeriodMicroseconds)
-    {
-      period_start = now;
-      on_time      = (uint32_t)(led_duty_cycle * kLedPeriodMicroseconds);
-    }
-    hardware.SetLed((now - period_start) < on_time);
+    scheduler.AddPeriodic(DrainTrace, nullptr, 1000);
   }
+  scheduler.Run();
 }
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "MemoryPlan.h"
+#include "ControlScanner.h"
+#include "LoadGovernor.h"
+#include "ShimmerVerb.h"
+#include "TraceStream.h"
+
+// Where cinematic-verb's statics live; cinematic-verb.cpp places them to
+// match. The plate (~155 KB), both pitch-shifters (~128 KB each) and the
+// 16 KB early-reflection buffer fit in SRAM with little to spare; the grain
+// shimmer needs one 128 KB capture buffer in place of the shifters.
+static constexpr daisybed::Allocation kCinematicVerbMemoryPlan[] = {
+    {"shimmer_verb", daisybed::MemoryRegion::kSram, sizeof(daisybed::ShimmerVerb)},
+#if DAISYBED_TRACE
+    {"trace", daisybed::MemoryRegion::kSram, sizeof(daisybed::TraceRecorder)},
+#endif
+    {"control_scanner",
+     daisybed::MemoryRegion::kDtcm,
+     sizeof(daisybed::ControlScanner<daisybed::ShimmerVerbControls::kNumAdc>)},
+    {"governor", daisybed::MemoryRegion::kDtcm, sizeof(daisybed::LoadGovernor)},
+};
+
+static_assert(daisybed::Fits(kCinematicVerbMemoryPlan, daisybed::MemoryRegion::kDtcm),
+              "cinematic-verb: DTCM plan over budget");
+static_assert(daisybed::Fits(kCinematicVerbMemoryPlan, daisybed::MemoryRegion::kSram),
+              "cinematic-verb: SRAM plan over budget");
+static_assert(daisybed::Fits(kCinematicVerbMemoryPlan, daisybed::MemoryRegion::kSdram),
+              "cinematic-verb: SDRAM plan over budget");
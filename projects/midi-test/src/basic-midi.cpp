@@ -1,26 +1,59 @@
 #include "daisy_pod.h"
 #include "daisysp.h"
+#include "AudioConfig.h"
+#include "AudioSpan.h"
+#include "Denormals.h"
+#include "DaisyClock.h"
+#include "Scheduler.h"
+#include "LatencyProbe.h"
 #include <stdio.h>
 #include <string.h>
 
+// Configured with -DDAISYBED_LATENCY_TEST=ON (see shared/cmake/daisybed.cmake)
+// the firmware measures its own note-on to sound latency; see LatencyPing().
+#ifndef DAISYBED_LATENCY_TEST
+#define DAISYBED_LATENCY_TEST 0
+#endif
+
 using namespace daisy;
 using namespace daisysp;
 
+// 4-sample blocks. MIDI is polled on every pass of the main loop, and the
+// audio interrupt alone wakes it every block, so a parsed message waits at
+// most one block for its poll: a control divisor of 1. The only task is the
+// latency test's ping, whose blocking send is the note it then times, so
+// nothing holds a poll up.
+static constexpr daisybed::AudioConfig kAudioConfig
+    = {48000.f, 4, 1, daisybed::kCodecDelayUs, 0.f};
+static_assert(kAudioConfig.WorstMidiLatencyUs() <= 2500.f,
+              "midi-test: note-on to sound must stay under 2.5 ms");
+static constexpr bool kLatencyTest = DAISYBED_LATENCY_TEST != 0;
+
 DaisyPod   hw;
 Oscillator osc;
 Svf        filt;
 
+daisybed::DaisyClock                      scheduler_clock;
+daisybed::Scheduler<daisybed::DaisyClock> scheduler;
+
+daisybed::LatencyProbe latency_probe;
+uint32_t               latency_notes_sent = 0;
+
 void AudioCallback(AudioHandle::InterleavingInputBuffer  in,
                    AudioHandle::InterleavingOutputBuffer out,
                    size_t                                size)
 {
-    float sig;
-    for(size_t i = 0; i < size; i += 2)
+    uint32_t callback_us = kLatencyTest ? System::GetUs() : 0;
+    auto     output      = daisybed::ViewInterleaved(out, size);
+    float    sig;
+    for(size_t i = 0; i < output.Size(); i++)
     {
         sig = osc.Process();
         filt.Process(sig);
-        out[i] = out[i + 1] = filt.Low();
+        output.left[i] = output.right[i] = filt.Low();
     }
+    if(kLatencyTest)
+        latency_probe.ProcessBlock(callback_us, output);
 }
 
 // Typical Switch case for Message Type.
@@ -68,6 +101,61 @@ void HandleMidiMessage(MidiEvent m)
     }
 }
 
+// Drains the UART MIDI parser; main() calls it after every wake.
+void PollMidi()
+{
+    hw.midi.Listen();
+    // Handle MIDI Events
+    while(hw.midi.HasEvents())
+    {
+        HandleMidiMessage(hw.midi.PopEvent());
+    }
+}
+
+void ReportLatency()
+{
+    const daisybed::LatencyStats &stats = latency_probe.GetStats();
+    char                          buff[256];
+    sprintf(buff,
+            "Latency us:\tn %lu\tlost %lu\tmin %lu\tp50 %lu\tp95 %lu\t"
+            "p99 %lu\tmax %lu\t(model %d..%d)\r\n",
+            (unsigned long)stats.GetCount(),
+            (unsigned long)(latency_notes_sent - stats.GetCount()),
+            (unsigned long)stats.GetMinUs(),
+            (unsigned long)stats.GetPercentileUs(0.5f),
+            (unsigned long)stats.GetPercentileUs(0.95f),
+            (unsigned long)stats.GetPercentileUs(0.99f),
+            (unsigned long)stats.GetMaxUs(),
+            (int)kAudioConfig.BestMidiLatencyUs(),
+            (int)kAudioConfig.WorstMidiLatencyUs());
+    hw.seed.usb_handle.TransmitInternal((uint8_t *)buff, strlen(buff));
+}
+
+// Latency test, every 125 ms with MIDI OUT patched to MIDI IN: one call
+// silences the oscillator, the next sends a note-on to ourselves. The
+// blocking UART send returns once the last byte has been shifted out, which
+// over the loopback is the moment it arrives, so that is the start time.
+// The note then takes the normal path (parser, PollMidi, HandleMidiMessage)
+// and the probe stops the clock at the first audible output sample.
+void LatencyPing(void *)
+{
+    static bool muted = false;
+    if(!muted)
+    {
+        // A note still armed after 125 ms never sounded: counted as lost.
+        latency_probe.Disarm();
+        if(latency_notes_sent != 0 && latency_notes_sent % 20 == 0)
+            ReportLatency();
+        osc.SetAmp(0.f);
+        muted = true;
+        return;
+    }
+    uint8_t note_on[3] = {0x90, 69, 100};
+    hw.midi.SendMessage(note_on, sizeof(note_on));
+    latency_probe.MarkArrival(System::GetUs());
+    latency_notes_sent++;
+    muted = false;
+}
 
 // Main -- Init, and Midi Handling
 int main(void)
@@ -75,8 +163,8 @@ int main(void)
     // Init
     float samplerate;
     hw.Init();
-    hw.SetAudioBlockSize(4);
-    
+    hw.SetAudioBlockSize(kAudioConfig.block_size);
+
     System::Delay(250);
 
     // Synthesis
@@ -84,19 +172,23 @@ int main(void)
     osc.Init(samplerate);
     osc.SetWaveform(Oscillator::WAVE_POLYBLEP_SAW);
     filt.Init(samplerate);
+    latency_probe.Init(kAudioConfig);
 
     // Start stuff.
+    daisybed::EnableFlushToZero();
     hw.StartAdc();
     hw.StartAudio(AudioCallback);
     hw.midi.StartReceive();
-    
+
+    // The core sleeps until the next interrupt instead of spinning. Any
+    // wake (the UART, the audio DMA, SysTick) goes on to poll MIDI; a
+    // message queued just before the WFI waits for the next audio block.
+    scheduler.Init(&scheduler_clock);
+    if(kLatencyTest)
+        scheduler.AddPeriodic(LatencyPing, nullptr, 125000);
     for(;;)
     {
-        hw.midi.Listen();
-        // Handle MIDI Events
-        while(hw.midi.HasEvents())
-        {
-            HandleMidiMessage(hw.midi.PopEvent());
-        }
+        scheduler.RunOnce();
+        PollMidi();
     }
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef DAISYBED_AUDIO_CONFIG_H
+#define DAISYBED_AUDIO_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace daisybed
+{
+// Audio block size and control rate of a firmware, with the MIDI-to-sound
+// latency they imply. Each firmware picks one of the configurations below
+// (or its own) and static_asserts it against its latency budget, so a block
+// size change that blows the budget fails to compile. The host latency-sim
+// tool runs the same numbers as a simulation.
+//
+// The path of a note-on through a firmware:
+//
+//   last MIDI byte   the UART DMA notices the end of the message one idle
+//    on the wire     character later and the parser queues the event
+//   control poll     the next PollMidi task moves it to the audio side;
+//                    polls run every control_divisor blocks, each up to
+//                    poll_late_us late behind the other main-loop tasks
+//   block start      the next audio callback applies it and renders
+//   DMA + codec      that block plays once the half-buffer in flight is
+//                    done, then through the DAC's group delay
+struct AudioConfig
+{
+    // One MIDI byte (10 bits at 31250 baud): the UART's idle-line time.
+    static constexpr float kMidiByteUs = 320.f;
+
+    float    sample_rate;
+    size_t   block_size;
+    uint32_t control_divisor; // controls and MIDI polled every N blocks
+    float    codec_delay_us;  // DAC group delay, from the datasheet
+    // How late a MIDI poll can start after it falls due: the tasks the
+    // Scheduler may run ahead of it, the one in progress and any due with
+    // an earlier deadline. Only their own time counts. An audio callback
+    // that preempts them also delays the poll, but the event would have
+    // waited for the next block anyway, so the block term already covers
+    // it. That's why this is smaller than scheduler-sim's "max late".
+    float poll_late_us;
+
+    constexpr float BlockUs() const { return block_size * 1e6f / sample_rate; }
+    constexpr float ControlPeriodUs() const { return BlockUs() * control_divisor; }
+    constexpr float ControlRate() const { return 1e6f / ControlPeriodUs(); }
+    // Rounded, for Scheduler::AddPeriodic().
+    constexpr uint32_t ControlTaskPeriodUs() const
+    {
+        return (uint32_t)(ControlPeriodUs() + 0.5f);
+    }
+
+    // A sample rendered in a callback reaches the output this long after the
+    // callback started (plus its own position in the block).
+    constexpr float OutputDelayUs() const { return BlockUs() + codec_delay_us; }
+
+    // Last byte of a note-on to its first sample at the output.
+    constexpr float BestMidiLatencyUs() const
+    {
+        return kMidiByteUs + OutputDelayUs();
+    }
+    constexpr float WorstMidiLatencyUs() const
+    {
+        return kMidiByteUs + ControlPeriodUs() + poll_late_us + BlockUs()
+               + OutputDelayUs();
+    }
+};
+
+// The AK4556's DAC filter is about 20 samples at 48 kHz, from the datasheet.
+// Nothing in the tree measures it: LatencyProbe adds it (with the block of
+// DMA) to the callback time rather than observing the output, so checking it
+// takes a scope on the audio output against the callback.
+static constexpr float kCodecDelayUs = 20 * 1e6f / 48000.f;
+
+// libDaisy's default 48-sample block with a 1 ms control and MIDI poll, and
+// nothing else in the main loop to hold the poll up.
+static constexpr AudioConfig kDefaultAudioConfig = {48000.f, 48, 1, kCodecDelayUs, 0.f};
+
+} // namespace daisybed
+
+#endif // DAISYBED_AUDIO_CONFIG_H
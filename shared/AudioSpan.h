@@ -0,0 +1,69 @@
+#pragma once
+#ifndef DAISYBED_AUDIO_SPAN_H
+#define DAISYBED_AUDIO_SPAN_H
+
+#include <stddef.h>
+
+namespace daisybed
+{
+// Zero-copy views over the two audio buffer layouts libDaisy hands a callback:
+//
+//   AudioHandle::InputBuffer / OutputBuffer            one pointer per channel
+//   AudioHandle::InterleavingInputBuffer / ...Output   L R L R ... in one array
+//
+// A StridedSpan addresses one channel of either layout. The stride is a
+// template parameter, so the non-interleaved (Stride == 1) case compiles down
+// to the same contiguous loop as indexing OUT_L directly.
+template <typename T, size_t Stride>
+class StridedSpan
+{
+  public:
+    StridedSpan(T *data, size_t size) : data_(data), size_(size) {}
+
+    inline T &operator[](size_t i) const { return data_[i * Stride]; }
+    inline size_t Size() const { return size_; }
+
+  private:
+    T     *data_;
+    size_t size_;
+};
+
+// Left/right pair of channel spans covering the same block.
+template <typename T, size_t Stride>
+struct StereoSpan
+{
+    StridedSpan<T, Stride> left;
+    StridedSpan<T, Stride> right;
+
+    inline size_t Size() const { return left.Size(); }
+};
+
+using StereoIn             = StereoSpan<const float, 1>;
+using StereoOut            = StereoSpan<float, 1>;
+using InterleavedStereoIn  = StereoSpan<const float, 2>;
+using InterleavedStereoOut = StereoSpan<float, 2>;
+
+// Non-interleaved callback buffers; size is frames per channel.
+inline StereoIn ViewStereo(const float *const *in, size_t size)
+{
+    return {{in[0], size}, {in[1], size}};
+}
+inline StereoOut ViewStereo(float **out, size_t size)
+{
+    return {{out[0], size}, {out[1], size}};
+}
+
+// Interleaved callback buffers; libDaisy passes the total sample count here
+// (both channels), so the view covers size / 2 frames.
+inline InterleavedStereoIn ViewInterleaved(const float *in, size_t size)
+{
+    return {{in, size / 2}, {in + 1, size / 2}};
+}
+inline InterleavedStereoOut ViewInterleaved(float *out, size_t size)
+{
+    return {{out, size / 2}, {out + 1, size / 2}};
+}
+
+} // namespace daisybed
+
+#endif // DAISYBED_AUDIO_SPAN_H
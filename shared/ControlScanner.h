@@ -0,0 +1,157 @@
+#pragma once
+#ifndef DAISYBED_CONTROL_SCANNER_H
+#define DAISYBED_CONTROL_SCANNER_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace daisybed
+{
+// One published scan. Encoder and button counts are running totals, so the
+// audio side can't miss an edge however its block rate relates to the scan
+// rate; ControlScanner::BeginBlock() turns them back into per-block events.
+template <size_t NumAdc, size_t NumButtons>
+struct ControlSnapshot
+{
+    float    adc[NumAdc];
+    int32_t  encoder_total;
+    uint32_t rising_total[NumButtons];
+    bool     pressed[NumButtons];
+    uint32_t scan; // number of scans so far
+};
+
+// Control scanning decoupled from the audio block size. A main-loop task
+// scans the hardware at a fixed rate (1 kHz in the firmwares) and hands the
+// raw readings to Scan(); the audio callback calls BeginBlock() and reads
+// the latest snapshot, however small its blocks are.
+//
+// Each ADC channel is averaged over the last kOversample scans and then held
+// inside a deadband, so ADC noise doesn't flicker the value (or flood the
+// trace, which records knobs on change). An average within the deadband of
+// either end of the channel's range snaps to that end, so a knob turned all
+// the way still reaches exactly 0 or full scale.
+//
+// Publication is a double buffer: Scan() fills the buffer the reader isn't
+// looking at and then flips the index. That's lock-free and safe as long as
+// the reader can preempt the writer but not the other way round -- the audio
+// interrupt reading what the main loop writes, on one core.
+template <size_t NumAdc, size_t NumButtons = 0>
+class ControlScanner
+{
+  public:
+    typedef ControlSnapshot<NumAdc == 0 ? 1 : NumAdc, NumButtons == 0 ? 1 : NumButtons>
+        Snapshot;
+
+    static const size_t kOversample = 4;
+
+    // deadband: smallest change (in ADC units, full scale 1) that gets
+    // through. Pitch CV wants it small; a panel knob can afford more.
+    // Every channel's range starts out as 0..1; see SetRange().
+    void Init(float deadband = 0.001f)
+    {
+        deadband_      = deadband;
+        for(size_t i = 0; i < NumAdc; i++)
+        {
+            low_[i]  = 0.f;
+            high_[i] = 1.f;
+        }
+        history_index_ = 0;
+        history_count_ = 0;
+        for(size_t b = 0; b < 2; b++)
+            buffers_[b] = Snapshot();
+        published_.store(0, std::memory_order_release);
+        scan_    = Snapshot();
+        current_ = Snapshot();
+        last_    = Snapshot();
+    }
+
+    // For bipolar channels, e.g. Patch SM CV jacks at -1..1.
+    void SetRange(size_t index, float low, float high)
+    {
+        low_[index]  = low;
+        high_[index] = high;
+    }
+
+    // Main loop, once per scan period. `adc` holds NumAdc readings, `buttons`
+    // NumButtons debounced pressed states (either may be null when empty).
+    void Scan(const float *adc, int32_t encoder_increment, const bool *buttons)
+    {
+        for(size_t i = 0; i < NumAdc; i++)
+        {
+            history_[i][history_index_] = adc[i];
+            size_t count = history_count_ + 1;
+            if(count > kOversample)
+                count = kOversample;
+            float sum = 0.f;
+            for(size_t k = 0; k < count; k++)
+                sum += history_[i][k];
+            float average = sum / count;
+            if(average >= high_[i] - deadband_)
+                average = high_[i];
+            else if(average <= low_[i] + deadband_)
+                average = low_[i];
+            if(history_count_ == 0 || fabsf(average - scan_.adc[i]) >= deadband_)
+                scan_.adc[i] = average;
+        }
+        history_index_ = (history_index_ + 1) % kOversample;
+        if(history_count_ < kOversample)
+            history_count_++;
+
+        scan_.encoder_total += encoder_increment;
+        for(size_t i = 0; i < NumButtons; i++)
+        {
+            if(buttons[i] && !scan_.pressed[i])
+                scan_.rising_total[i]++;
+            scan_.pressed[i] = buttons[i];
+        }
+        scan_.scan++;
+
+        uint8_t next   = 1 - published_.load(std::memory_order_relaxed);
+        buffers_[next] = scan_;
+        published_.store(next, std::memory_order_release);
+    }
+
+    // Audio callback, once at the top of each block: takes the latest
+    // snapshot and works out this block's encoder and button events.
+    void BeginBlock()
+    {
+        last_    = current_;
+        current_ = buffers_[published_.load(std::memory_order_acquire)];
+    }
+
+    inline float Adc(size_t index) const { return current_.adc[index]; }
+    inline int32_t EncoderIncrement() const
+    {
+        return current_.encoder_total - last_.encoder_total;
+    }
+    inline bool RisingEdge(size_t button) const
+    {
+        return current_.rising_total[button] != last_.rising_total[button];
+    }
+    inline bool Pressed(size_t button) const { return current_.pressed[button]; }
+    // Scans published so far; stops advancing if the scan task stalls.
+    inline uint32_t GetScanCount() const { return current_.scan; }
+
+  private:
+    // Writer side
+    float    deadband_;
+    float    low_[NumAdc == 0 ? 1 : NumAdc];
+    float    high_[NumAdc == 0 ? 1 : NumAdc];
+    float    history_[NumAdc == 0 ? 1 : NumAdc][kOversample];
+    size_t   history_index_;
+    size_t   history_count_;
+    Snapshot scan_;
+
+    Snapshot             buffers_[2];
+    std::atomic<uint8_t> published_{0};
+
+    // Reader side
+    Snapshot current_;
+    Snapshot last_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_CONTROL_SCANNER_H
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef DAISYBED_DAISY_CLOCK_H
+#define DAISYBED_DAISY_CLOCK_H
+
+#include <stdint.h>
+#include "daisy_core.h"
+#include "sys/system.h"
+#include "stm32h7xx_hal.h"
+
+namespace daisybed
+{
+// Scheduler clock for the Daisy: microseconds from System::GetUs(), and WFI
+// while idle. Any interrupt wakes the core -- the 1 kHz SysTick, the audio
+// DMA, USB, UART -- so the scheduler never oversleeps a release by more than
+// a millisecond, and there's no wake-up timer to program.
+struct DaisyClock
+{
+    inline uint32_t NowUs() const { return daisy::System::GetUs(); }
+
+    // Interrupts are masked around the check so an event signalled between
+    // the check and the WFI still wakes it: a pending interrupt ends WFI
+    // even while masked, and runs as soon as they're unmasked again.
+    template <typename Pending>
+    inline void Idle(uint32_t wake_us, Pending pending)
+    {
+        (void)wake_us;
+        __disable_irq();
+        if(!pending())
+            __WFI();
+        __enable_irq();
+    }
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_DAISY_CLOCK_H
@@ -4,6 +4,8 @@
 
 #include <math.h>
 #include "daisysp.h"
+#include "AudioSpan.h"
+#include "Denormals.h"
 
 namespace daisybed
 {
@@ -19,6 +21,27 @@ class DattorroPlate
     {
         scale_ = sample_rate / kRefSr;
 
+        Clear();
+
+        // Slow, mutually-detuned tank modulation to avoid metallic ringing.
+        lfo_phase_l_ = 0.f;
+        lfo_phase_r_ = 1.5f;
+        lfo_inc_l_   = kTwoPi * 0.70f / sample_rate;
+        lfo_inc_r_   = kTwoPi * 1.10f / sample_rate;
+        excursion_   = 16.f * scale_;
+        mod_l_       = 672.f * scale_;
+        mod_r_       = 908.f * scale_;
+        modulate_    = true;
+
+        decay_  = 0.7f;
+        bright_ = 0.6f;
+        dc_     = kDenormalOffset;
+    }
+
+    // Silences the tank and the diffusers, keeping every setting. For
+    // recovering from a NaN without re-tuning the plate.
+    void Clear()
+    {
         in_ap1_.Init();
         in_ap2_.Init();
         in_ap3_.Init();
@@ -34,27 +57,25 @@ class DattorroPlate
 
         lp_l_ = lp_r_ = 0.f;
         fb_   = 0.f;
-
-        // Slow, mutually-detuned tank modulation to avoid metallic ringing.
-        lfo_phase_l_ = 0.f;
-        lfo_phase_r_ = 1.5f;
-        lfo_inc_l_   = kTwoPi * 0.70f / sample_rate;
-        lfo_inc_r_   = kTwoPi * 1.10f / sample_rate;
-        excursion_   = 16.f * scale_;
-
-        decay_  = 0.7f;
-        bright_ = 0.6f;
     }
 
     // decay: tank feedback / tail length (0..~0.92).
     inline void SetDecay(float d) { decay_ = d; }
     // bright: damping filter brightness, 0 (dark) .. 1 (bright).
     inline void SetBrightness(float b) { bright_ = b; }
+    // Keep a tiny DC offset circulating in the tank so the tail never decays
+    // into subnormals (see Denormals.h). On by default.
+    inline void SetDenormalOffset(bool on) { dc_ = on ? kDenormalOffset : 0.f; }
+    // Cheaper path for when CPU is short: freezes the tank modulation, which
+    // saves both sinf() calls per sample at the cost of a more static tail.
+    inline void SetModulation(bool on) { modulate_ = on; }
+    // Tank modulation depth in samples at the reference rate (default 16).
+    inline void SetExcursion(float samples) { excursion_ = samples * scale_; }
 
     void Process(float in_l, float in_r, float &out_l, float &out_r)
     {
         // Plate is mono-in; sum the stereo input.
-        float x = 0.5f * (in_l + in_r);
+        float x = 0.5f * (in_l + in_r) + dc_;
 
         // Input diffusion (four fixed allpasses).
         x = in_ap1_.Allpass(x, (size_t)(142.f * scale_), 0.75f);
@@ -62,22 +83,28 @@ class DattorroPlate
         x = in_ap3_.Allpass(x, (size_t)(379.f * scale_), 0.625f);
         x = in_ap4_.Allpass(x, (size_t)(277.f * scale_), 0.625f);
 
-        // Advance tank modulation LFOs.
-        lfo_phase_l_ += lfo_inc_l_;
-        if(lfo_phase_l_ > kTwoPi)
-            lfo_phase_l_ -= kTwoPi;
-        lfo_phase_r_ += lfo_inc_r_;
-        if(lfo_phase_r_ > kTwoPi)
-            lfo_phase_r_ -= kTwoPi;
-        float mod_l = 672.f * scale_ + excursion_ * sinf(lfo_phase_l_);
-        float mod_r = 908.f * scale_ + excursion_ * sinf(lfo_phase_r_);
+        // Advance tank modulation LFOs. With modulation off the tank delays
+        // hold wherever the LFOs last left them, so toggling never jumps.
+        if(modulate_)
+        {
+            lfo_phase_l_ += lfo_inc_l_;
+            if(lfo_phase_l_ > kTwoPi)
+                lfo_phase_l_ -= kTwoPi;
+            lfo_phase_r_ += lfo_inc_r_;
+            if(lfo_phase_r_ > kTwoPi)
+                lfo_phase_r_ -= kTwoPi;
+            mod_l_ = 672.f * scale_ + excursion_ * sinf(lfo_phase_l_);
+            mod_r_ = 908.f * scale_ + excursion_ * sinf(lfo_phase_r_);
+        }
+        float mod_l = mod_l_;
+        float mod_r = mod_r_;
 
         // Left half of the figure-8 tank.
         float split_l = x + fb_; // fb_ = decay * right-branch output (prev sample)
         float n_l     = ModAllpass(ap_l1_, mod_l, 0.7f, split_l);
         del_l1_.Write(n_l);
         float a_l = del_l1_.Read(4453.f * scale_);
-        lp_l_ += bright_ * (a_l - lp_l_);
+        lp_l_ += bright_ * (a_l - lp_l_) + dc_;
         float u_l = ap_l2_.Allpass(lp_l_, (size_t)(1800.f * scale_), 0.5f);
         del_l2_.Write(u_l);
         float z_l = del_l2_.Read(3720.f * scale_);
@@ -87,7 +114,7 @@ class DattorroPlate
         float n_r     = ModAllpass(ap_r1_, mod_r, 0.7f, split_r);
         del_r1_.Write(n_r);
         float a_r = del_r1_.Read(4217.f * scale_);
-        lp_r_ += bright_ * (a_r - lp_r_);
+        lp_r_ += bright_ * (a_r - lp_r_) + dc_;
         float u_r = ap_r2_.Allpass(lp_r_, (size_t)(2656.f * scale_), 0.5f);
         del_r2_.Write(u_r);
         float z_r = del_r2_.Read(3163.f * scale_);
@@ -108,6 +135,19 @@ class DattorroPlate
         out_r = yr * 0.6f;
     }
 
+    // Block form over any StereoSpan layout (see AudioSpan.h). Input and
+    // output may alias, so the plate can run in place on a callback buffer.
+    template <typename In, typename Out>
+    void ProcessBlock(const In &in, const Out &out)
+    {
+        for(size_t i = 0; i < in.Size(); i++)
+        {
+            float in_l = in.left[i];
+            float in_r = in.right[i];
+            Process(in_l, in_r, out.left[i], out.right[i]);
+        }
+    }
+
   private:
     static constexpr float  kRefSr  = 29761.0f;
     static constexpr float  kTwoPi  = 6.2831853f;
@@ -145,7 +185,10 @@ class DattorroPlate
     float scale_;
     float decay_, bright_;
     float lp_l_, lp_r_, fb_;
+    float dc_;
     float lfo_phase_l_, lfo_phase_r_, lfo_inc_l_, lfo_inc_r_, excursion_;
+    float mod_l_, mod_r_;
+    bool  modulate_;
 
     daisysp::DelayLine<float, kInAp1> in_ap1_;
     daisysp::DelayLine<float, kInAp2> in_ap2_;
@@ -0,0 +1,87 @@
+#pragma once
+#ifndef DAISYBED_DENORMALS_H
+#define DAISYBED_DENORMALS_H
+
+#include <stdint.h>
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define DAISYBED_DENORMALS_X86 1
+#elif defined(__arm__) && defined(__ARM_FP)
+#define DAISYBED_DENORMALS_ARM 1
+#endif
+
+namespace daisybed
+{
+// Reverb tails and damping filters decay toward zero once the input goes
+// silent and eventually land in the subnormal range. On x86 each subnormal op
+// can cost 10-100x; on the Cortex-M7 it depends on FPSCR.FZ, which nothing
+// sets by default. Three tools, pick what fits:
+//
+//   EnableFlushToZero()    process-wide, call once from main() before audio
+//   ScopedFlushDenormals   RAII guard for host renders and worker threads
+//   kDenormalOffset        tiny DC added inside feedback loops, so the state
+//                          never gets small enough to matter on any FPU
+
+// Far below audibility (~-360 dBFS) but far above FLT_MIN after any realistic
+// amount of recirculation.
+static constexpr float kDenormalOffset = 1e-18f;
+
+#if defined(DAISYBED_DENORMALS_X86)
+static constexpr uint32_t kFlushDenormalBits = 0x8040; // MXCSR FTZ | DAZ
+
+inline uint32_t ReadFpControl() { return _mm_getcsr(); }
+inline void     WriteFpControl(uint32_t csr) { _mm_setcsr(csr); }
+#elif defined(DAISYBED_DENORMALS_ARM)
+static constexpr uint32_t kFlushDenormalBits = 1u << 24; // FPSCR.FZ
+
+inline uint32_t ReadFpControl()
+{
+    uint32_t fpscr;
+    asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+    return fpscr;
+}
+inline void WriteFpControl(uint32_t fpscr)
+{
+    asm volatile("vmsr fpscr, %0" : : "r"(fpscr));
+}
+#else
+static constexpr uint32_t kFlushDenormalBits = 0;
+
+inline uint32_t ReadFpControl() { return 0; }
+inline void     WriteFpControl(uint32_t) {}
+#endif
+
+// Sets flush-to-zero for the calling context. On Cortex-M the audio callback
+// runs in an interrupt, and exception entry loads FPSCR from FPDSCR rather
+// than inheriting main()'s FPSCR, so the default register is set as well.
+inline void EnableFlushToZero()
+{
+    WriteFpControl(ReadFpControl() | kFlushDenormalBits);
+#if defined(DAISYBED_DENORMALS_ARM)
+    volatile uint32_t *fpdscr = reinterpret_cast<volatile uint32_t *>(0xE000EF3C);
+    *fpdscr |= kFlushDenormalBits;
+#endif
+}
+
+// Flush-to-zero for the lifetime of the guard, restoring the previous mode on
+// exit. Useful on host threads that render shared DSP code.
+class ScopedFlushDenormals
+{
+  public:
+    ScopedFlushDenormals() : saved_(ReadFpControl())
+    {
+        WriteFpControl(saved_ | kFlushDenormalBits);
+    }
+    ~ScopedFlushDenormals() { WriteFpControl(saved_); }
+
+    ScopedFlushDenormals(const ScopedFlushDenormals &) = delete;
+    ScopedFlushDenormals &operator=(const ScopedFlushDenormals &) = delete;
+
+  private:
+    uint32_t saved_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_DENORMALS_H
@@ -0,0 +1,126 @@
+#pragma once
+#ifndef DAISYBED_GATE_INPUT_H
+#define DAISYBED_GATE_INPUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SpscQueue.h"
+
+namespace daisybed
+{
+// Gate / trigger input with sub-block timing.
+//
+// Polling a Switch once per callback quantizes every edge to the start of a
+// block. Here each edge is timestamped when it happens (from a pin interrupt
+// on the board, see GateInterrupt.cpp, or from a simulated stream on host) and
+// the audio callback maps the timestamps onto sample offsets within the block
+// it is rendering. Latency is then a constant one block instead of anything
+// between zero and one block.
+//
+// Hardware-free: timestamps are in whatever tick unit the caller uses, as long
+// as Init() is given its frequency and it wraps at 32 bits.
+//
+// The timestamps are only as good as the interrupt that takes them: one that
+// waits for the audio callback to return stamps every edge during it late, by
+// up to the callback's length. GateInterrupt.cpp therefore runs the edge
+// interrupt at kGateIrqPriority, above the audio DMA's kAudioDmaIrqPriority
+// (NVIC preemption priorities, lower is more urgent); gate-sim models the
+// masking from the same two numbers.
+constexpr uint32_t kGateIrqPriority     = 0;
+constexpr uint32_t kAudioDmaIrqPriority = 1;
+
+class GateInput
+{
+  public:
+    void Init(float tick_freq, float sample_rate)
+    {
+        ticks_per_sample_ = tick_freq / sample_rate;
+        high_             = false;
+        edge_count_       = 0;
+        next_edge_        = 0;
+        // The firmware keeps this in DTCM, which isn't zeroed at startup.
+        queue_.Reset();
+    }
+
+    // Producer side: call from the pin interrupt with the new gate level.
+    inline void OnEdge(bool rising, uint32_t tick)
+    {
+        Edge edge = {tick, rising};
+        queue_.Push(edge);
+    }
+
+    // Consumer side: call at the top of the audio callback. The block being
+    // rendered covers the block_size samples of input time ending at `now`.
+    // The edge interrupt preempts the callback, so edges stamped after `now`
+    // can already be queued; they're left for the next block.
+    void BeginBlock(uint32_t now, size_t block_size)
+    {
+        uint32_t block_ticks = (uint32_t)(block_size * ticks_per_sample_);
+        uint32_t block_start = now - block_ticks;
+
+        edge_count_ = 0;
+        next_edge_  = 0;
+        Edge edge;
+        while(queue_.Peek(edge) && (int32_t)(edge.tick - now) <= 0)
+        {
+            queue_.Pop(edge);
+            high_ = edge.rising;
+            if(edge_count_ == kMaxEdgesPerBlock)
+                continue;
+            // Signed difference stays correct across tick wrap. Edges older
+            // than this block (callback jitter) land on sample 0.
+            int32_t since_start = (int32_t)(edge.tick - block_start);
+            size_t  offset      = 0;
+            if(since_start > 0)
+                offset = (size_t)((float)since_start / ticks_per_sample_);
+            if(offset >= block_size)
+                offset = block_size - 1;
+            offsets_[edge_count_] = {offset, edge.rising};
+            edge_count_++;
+        }
+    }
+
+    // Iterates the rising edges of the current block in time order. Returns
+    // false once there are no more.
+    bool NextRisingEdge(size_t &offset)
+    {
+        while(next_edge_ < edge_count_)
+        {
+            const BlockEdge &edge = offsets_[next_edge_++];
+            if(edge.rising)
+            {
+                offset = edge.offset;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Gate level after the last edge consumed by BeginBlock().
+    inline bool IsHigh() const { return high_; }
+
+  private:
+    static constexpr size_t kQueueSize        = 64;
+    static constexpr size_t kMaxEdgesPerBlock = 16;
+
+    struct Edge
+    {
+        uint32_t tick;
+        bool     rising;
+    };
+    struct BlockEdge
+    {
+        size_t offset;
+        bool   rising;
+    };
+
+    SpscQueue<Edge, kQueueSize> queue_;
+    BlockEdge                   offsets_[kMaxEdgesPerBlock];
+    size_t                      edge_count_, next_edge_;
+    float                       ticks_per_sample_;
+    bool                        high_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_GATE_INPUT_H
@@ -0,0 +1,98 @@
+#include "daisy_core.h"
+#include "stm32h7xx_hal.h"
+#include "sys/system.h"
+#include "GateInterrupt.h"
+
+using namespace daisy;
+
+namespace
+{
+struct GateLine
+{
+    daisybed::GateInput *gate;
+    GPIO_TypeDef        *port;
+    uint16_t             mask;
+    bool                 inverted;
+};
+
+// Indexed by EXTI line, which is the pin number within its port.
+GateLine gate_lines[16];
+
+GPIO_TypeDef *PortFor(const Pin &pin)
+{
+    return reinterpret_cast<GPIO_TypeDef *>(
+        GPIOA_BASE + (GPIOB_BASE - GPIOA_BASE) * static_cast<uint32_t>(pin.port));
+}
+
+IRQn_Type IrqFor(uint8_t line)
+{
+    if(line < 5)
+        return static_cast<IRQn_Type>(EXTI0_IRQn + line);
+    return line < 10 ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+void EnablePortClock(const Pin &pin)
+{
+    switch(pin.port)
+    {
+        case PORTA: __HAL_RCC_GPIOA_CLK_ENABLE(); break;
+        case PORTB: __HAL_RCC_GPIOB_CLK_ENABLE(); break;
+        case PORTC: __HAL_RCC_GPIOC_CLK_ENABLE(); break;
+        case PORTD: __HAL_RCC_GPIOD_CLK_ENABLE(); break;
+        case PORTE: __HAL_RCC_GPIOE_CLK_ENABLE(); break;
+        case PORTF: __HAL_RCC_GPIOF_CLK_ENABLE(); break;
+        case PORTG: __HAL_RCC_GPIOG_CLK_ENABLE(); break;
+        case PORTH: __HAL_RCC_GPIOH_CLK_ENABLE(); break;
+        case PORTI: __HAL_RCC_GPIOI_CLK_ENABLE(); break;
+        case PORTJ: __HAL_RCC_GPIOJ_CLK_ENABLE(); break;
+        case PORTK: __HAL_RCC_GPIOK_CLK_ENABLE(); break;
+        default: break;
+    }
+}
+
+} // namespace
+
+// Timestamp first, then sort out which line fired.
+void daisybed::ServiceGateInterrupt(uint8_t first_line, uint8_t last_line)
+{
+    uint32_t now = System::GetTick();
+    for(uint8_t line = first_line; line <= last_line && line < 16; line++)
+    {
+        GateLine &gl = gate_lines[line];
+        if(gl.gate == nullptr || !__HAL_GPIO_EXTI_GET_IT(gl.mask))
+            continue;
+        __HAL_GPIO_EXTI_CLEAR_IT(gl.mask);
+        bool level = HAL_GPIO_ReadPin(gl.port, gl.mask) == GPIO_PIN_SET;
+        gl.gate->OnEdge(level != gl.inverted, now);
+    }
+}
+
+void daisybed::StartGateInterrupt(GateInput &gate, Pin pin, bool inverted)
+{
+    if(pin.pin > 15)
+        return;
+
+    GateLine &gl = gate_lines[pin.pin];
+    gl.gate      = &gate;
+    gl.port      = PortFor(pin);
+    gl.mask      = static_cast<uint16_t>(1u << pin.pin);
+    gl.inverted  = inverted;
+
+    EnablePortClock(pin);
+    GPIO_InitTypeDef init = {};
+    init.Pin              = gl.mask;
+    init.Mode             = GPIO_MODE_IT_RISING_FALLING;
+    init.Pull             = inverted ? GPIO_PULLUP : GPIO_NOPULL;
+    init.Speed            = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(gl.port, &init);
+
+    // libDaisy's audio runs on SAI1 through DMA1 streams 0 and 1 at priority
+    // 0; step them down so the edge interrupt can preempt the callback.
+    HAL_NVIC_SetPriority(DMA1_Stream0_IRQn, daisybed::kAudioDmaIrqPriority, 0);
+    HAL_NVIC_SetPriority(DMA1_Stream1_IRQn, daisybed::kAudioDmaIrqPriority, 0);
+
+    // The handler itself is the firmware's; see ServiceGateInterrupt().
+    IRQn_Type irq = IrqFor(pin.pin);
+    HAL_NVIC_SetPriority(irq, daisybed::kGateIrqPriority, 0);
+    HAL_NVIC_EnableIRQ(irq);
+}
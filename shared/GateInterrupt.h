@@ -0,0 +1,39 @@
+#pragma once
+#ifndef DAISYBED_GATE_INTERRUPT_H
+#define DAISYBED_GATE_INTERRUPT_H
+
+#include "daisy_core.h"
+#include "GateInput.h"
+
+namespace daisybed
+{
+// Feeds a GateInput from a pin-change interrupt (EXTI) on the given pin,
+// timestamped with System::GetTick(). Patch SM gate inputs are inverted by
+// the input stage, so a falling pin is a rising gate by default.
+//
+// Init the GateInput with System::GetTickFreq() first. Only one pin can be
+// attached per EXTI line (i.e. per pin number).
+//
+// The EXTI interrupt preempts the audio callback, so an edge is timestamped
+// when it happens even mid-callback; the handler only reads the tick and
+// queues the edge, a fraction of a microsecond. libDaisy gives the audio DMA
+// the top priority, so this also moves SAI1's two DMA streams down a level
+// (see GateInput.h); call it after DaisyPatchSM::Init() has set them up.
+void StartGateInterrupt(GateInput &gate, daisy::Pin pin, bool inverted = true);
+
+// Timestamps and queues the edges pending on EXTI lines first..last.
+//
+// This file defines no interrupt handlers: the EXTI vectors are shared by
+// every pin with the same number, so the firmware owns them. It defines the
+// handler for the line group of each gate pin and calls this from it, e.g.
+// for a gate on pin 14:
+//   extern "C" void EXTI15_10_IRQHandler(void)
+//   {
+//       daisybed::ServiceGateInterrupt(10, 15);
+//   }
+// Lines with no gate attached are left alone for other users of the vector.
+void ServiceGateInterrupt(uint8_t first_line, uint8_t last_line);
+
+} // namespace daisybed
+
+#endif // DAISYBED_GATE_INTERRUPT_H
@@ -0,0 +1,271 @@
+#pragma once
+#ifndef DAISYBED_GRAIN_CLOUD_H
+#define DAISYBED_GRAIN_CLOUD_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace daisybed
+{
+// Granular pitch-shifter: a cloud of short windowed grains read out of one
+// shared capture buffer, each at its own playback rate. Where a
+// daisysp::PitchShifter is two fixed crossfading windows over its own 128 KB
+// of delay, the cloud spends one buffer on any number of grains, and the
+// jitter between them smears the result into a denser, less periodic shimmer.
+//
+// Grains are scheduled once per block in BeginBlock(): the density decides
+// how many start in this block, each at a random sample offset inside it,
+// with its pitch drawn from the two interval voices (weighted by their
+// gains), a few cents of detune and a random extra delay into the past.
+// Process() then runs sample by sample, so it can sit inside a feedback loop.
+//
+// The pool is fixed at MaxGrains and nothing allocates after Init(). The
+// grain budget caps how many grains may sound at once -- the CPU knob, since
+// each one costs two interpolated reads per sample. New grains are simply
+// not started while the cloud is at its budget, and the output gain follows
+// the overlap that is actually achievable, so shedding grains thins the
+// cloud rather than dropping its level.
+//
+// BufferSize must be a power of two. Grain length is limited to 1/8 and the
+// position jitter to 1/4 of it, so grains pitched up to about two octaves
+// and a tone never catch up with the write head.
+template <size_t BufferSize, int MaxGrains>
+class GrainCloud
+{
+  public:
+    void Init(float sample_rate, uint32_t seed = 1)
+    {
+        sample_rate_ = sample_rate;
+        Clear();
+
+        // Hann window, with a guard point so the interpolation at the very
+        // end needs no wrap.
+        for(size_t i = 0; i <= kWindowSize; i++)
+            window_[i] = 0.5f - 0.5f * cosf(kTwoPi * i / kWindowSize);
+
+        output_gain_ = 1.f;
+        rng_         = seed ? seed : 1;
+
+        budget_ = MaxGrains;
+        SetDensity(40.f);
+        SetGrainLength(0.12f);
+        SetJitter(0.05f);
+        SetDetune(6.f);
+        SetInterval(12.f, 1.f, 12.f, 0.f);
+    }
+
+    // Empties the capture buffer and stops every grain, keeping the settings.
+    void Clear()
+    {
+        for(size_t i = 0; i < BufferSize; i++)
+            buffer_[i] = 0.f;
+        write_ = 0;
+        for(int g = 0; g < MaxGrains; g++)
+            grains_[g].active = false;
+        active_count_ = 0;
+        launch_phase_ = 0.f;
+    }
+
+    // Grain starts per second.
+    inline void SetDensity(float grains_per_second) { density_ = grains_per_second; }
+
+    void SetGrainLength(float seconds)
+    {
+        float samples = seconds * sample_rate_;
+        if(samples < 64.f)
+            samples = 64.f;
+        if(samples > BufferSize / 8)
+            samples = BufferSize / 8;
+        length_ = samples;
+    }
+
+    // Largest random extra delay, in seconds, for a grain's start position.
+    void SetJitter(float seconds)
+    {
+        float samples = seconds * sample_rate_;
+        if(samples < 0.f)
+            samples = 0.f;
+        if(samples > BufferSize / 4)
+            samples = BufferSize / 4;
+        jitter_ = samples;
+    }
+
+    // Largest random detune of a grain, in cents either way.
+    inline void SetDetune(float cents) { detune_ = cents; }
+
+    // The two pitches a grain may take, as ShimmerVerb's interval voices. A
+    // grain picks one with probability proportional to its gain and plays at
+    // the summed gain, so a single voice is simply gain_second = 0.
+    void SetInterval(float semitones_first,
+                     float gain_first,
+                     float semitones_second,
+                     float gain_second)
+    {
+        semitones_first_  = semitones_first;
+        semitones_second_ = semitones_second;
+        gain_             = gain_first + gain_second;
+        second_weight_    = gain_ > 0.f ? gain_second / gain_ : 0.f;
+    }
+
+    // Most grains sounding at once, 1..MaxGrains. Grains already playing
+    // finish their window; the cap applies to new starts.
+    void SetGrainBudget(int grains)
+    {
+        budget_ = grains < 1 ? 1 : (grains > MaxGrains ? MaxGrains : grains);
+    }
+    inline int GetGrainBudget() const { return budget_; }
+    inline int GetActiveCount() const { return active_count_; }
+
+    // Schedules the grains that start during the next `size` samples.
+    void BeginBlock(size_t size)
+    {
+        launch_phase_ += density_ * size / sample_rate_;
+        while(launch_phase_ >= 1.f)
+        {
+            launch_phase_ -= 1.f;
+            if(active_count_ >= budget_)
+                continue;
+            Launch((size_t)(Uniform() * size));
+        }
+
+        // Hann grains at this density overlap `overlap` deep on average;
+        // normalise to unity, but never boost a sparse cloud.
+        float overlap = density_ * length_ / sample_rate_;
+        if(overlap > budget_)
+            overlap = budget_;
+        output_gain_ = overlap > 2.f ? 2.f / overlap : 1.f;
+    }
+
+    float Process(float in)
+    {
+        buffer_[write_] = in;
+
+        float out = 0.f;
+        for(int g = 0; g < MaxGrains; g++)
+        {
+            Grain &grain = grains_[g];
+            if(!grain.active)
+                continue;
+            if(grain.wait > 0)
+            {
+                grain.wait--;
+                continue;
+            }
+
+            float out_grain = ReadBuffer(grain.position) * ReadWindow(grain.phase);
+            out += out_grain * grain.gain;
+
+            grain.position += grain.rate;
+            if(grain.position >= BufferSize)
+                grain.position -= BufferSize;
+            grain.phase += grain.phase_increment;
+            if(grain.phase >= kWindowSize)
+            {
+                grain.active = false;
+                active_count_--;
+            }
+        }
+
+        write_ = (write_ + 1) & kMask;
+        return out * output_gain_;
+    }
+
+  private:
+    static constexpr size_t kMask       = BufferSize - 1;
+    static constexpr size_t kWindowSize = 1024;
+    static constexpr float  kTwoPi      = 6.2831853f;
+
+    struct Grain
+    {
+        bool   active;
+        size_t wait;     // samples until it starts sounding
+        float  position; // read head in the capture buffer
+        float  rate;     // playback rate, i.e. the pitch ratio
+        float  phase;    // window position, 0..kWindowSize
+        float  phase_increment;
+        float  gain;
+    };
+
+    // Starts a grain `offset` samples into the coming block.
+    void Launch(size_t offset)
+    {
+        Grain *grain = nullptr;
+        for(int g = 0; g < MaxGrains && grain == nullptr; g++)
+            if(!grains_[g].active)
+                grain = &grains_[g];
+        if(grain == nullptr)
+            return;
+
+        float semitones = Uniform() < second_weight_ ? semitones_second_
+                                                     : semitones_first_;
+        semitones += (2.f * Uniform() - 1.f) * detune_ * 0.01f;
+        float rate = exp2f(semitones / 12.f);
+
+        // A grain reading faster than the write head gains on it by
+        // (rate - 1) samples per sample; start it far enough back that it
+        // is still behind when its window closes.
+        float lead  = rate > 1.f ? (rate - 1.f) * length_ : 0.f;
+        float delay = lead + 2.f + Uniform() * jitter_;
+        if(delay > BufferSize - 4)
+            delay = BufferSize - 4;
+
+        float start = (float)((write_ + offset) & kMask) - delay;
+        if(start < 0.f)
+            start += BufferSize;
+
+        grain->active          = true;
+        grain->wait            = offset;
+        grain->position        = start;
+        grain->rate            = rate;
+        grain->phase           = 0.f;
+        grain->phase_increment = kWindowSize / length_;
+        grain->gain            = gain_;
+        active_count_++;
+    }
+
+    inline float ReadBuffer(float position) const
+    {
+        size_t index = (size_t)position;
+        float  frac  = position - index;
+        float  a     = buffer_[index & kMask];
+        float  b     = buffer_[(index + 1) & kMask];
+        return a + (b - a) * frac;
+    }
+
+    inline float ReadWindow(float phase) const
+    {
+        size_t index = (size_t)phase;
+        float  frac  = phase - index;
+        return window_[index] + (window_[index + 1] - window_[index]) * frac;
+    }
+
+    // Uniform in [0, 1). A private LCG rather than rand(), so a render (and
+    // a trace replay) is reproducible from the seed.
+    inline float Uniform()
+    {
+        rng_ = rng_ * 1664525u + 1013904223u;
+        return (rng_ >> 8) * (1.f / 16777216.f);
+    }
+
+    float sample_rate_;
+
+    float  buffer_[BufferSize];
+    size_t write_;
+    float  window_[kWindowSize + 1];
+
+    Grain    grains_[MaxGrains];
+    int      active_count_;
+    int      budget_;
+    float    launch_phase_;
+    uint32_t rng_;
+
+    float density_, length_, jitter_, detune_;
+    float semitones_first_, semitones_second_;
+    float gain_, second_weight_;
+    float output_gain_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_GRAIN_CLOUD_H
@@ -0,0 +1,141 @@
+#pragma once
+#ifndef DAISYBED_LATENCY_PROBE_H
+#define DAISYBED_LATENCY_PROBE_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "AudioConfig.h"
+
+namespace daisybed
+{
+// Histogram of latency measurements: 25 us bins up to ~25 ms, anything later
+// in the last bin. Fixed size, no allocation, cheap enough to fill from an
+// interrupt.
+class LatencyStats
+{
+  public:
+    static constexpr uint32_t kBinUs = 25;
+    static constexpr size_t   kBins  = 1024;
+
+    void Reset()
+    {
+        for(size_t b = 0; b < kBins; b++)
+            bins_[b] = 0;
+        count_  = 0;
+        sum_us_ = 0;
+        min_us_ = 0xFFFFFFFFu;
+        max_us_ = 0;
+    }
+
+    void Add(uint32_t us)
+    {
+        size_t bin = us / kBinUs;
+        bins_[bin < kBins ? bin : kBins - 1]++;
+        count_++;
+        sum_us_ += us;
+        if(us < min_us_)
+            min_us_ = us;
+        if(us > max_us_)
+            max_us_ = us;
+    }
+
+    inline uint32_t GetCount() const { return count_; }
+    inline uint32_t GetMinUs() const { return count_ ? min_us_ : 0; }
+    inline uint32_t GetMaxUs() const { return max_us_; }
+    inline float    GetMeanUs() const { return count_ ? (float)sum_us_ / count_ : 0.f; }
+
+    // Upper edge of the bin holding the given fraction (0..1) of the samples,
+    // so accurate to one bin.
+    uint32_t GetPercentileUs(float fraction) const
+    {
+        uint32_t target = (uint32_t)ceilf(fraction * count_);
+        uint32_t seen   = 0;
+        for(size_t b = 0; b < kBins; b++)
+        {
+            seen += bins_[b];
+            if(seen >= target && seen > 0)
+                return (uint32_t)(b + 1) * kBinUs;
+        }
+        return max_us_;
+    }
+
+  private:
+    uint32_t bins_[kBins];
+    uint32_t count_;
+    uint64_t sum_us_;
+    uint32_t min_us_, max_us_;
+};
+
+// Note-on to sound latency, measured on the running firmware.
+//
+// The MIDI side calls MarkArrival() with the time the test note's last byte
+// reached the input; that arms the probe. The audio callback then hands
+// every rendered block to ProcessBlock() with the time the callback started.
+// The first sample above the threshold ends the measurement. Its time at
+// the output is the callback start plus the config's output delay plus its
+// offset in the block. That last step is the model's, not a measurement: the
+// probe sees the rendered block, never the DAC, so it measures the MIDI and
+// scheduling side and takes the DMA and codec delay from the AudioConfig. A
+// disarmed probe costs one atomic load per block.
+//
+// The output must be silent (below the threshold) when a test note is sent,
+// or the measurement ends on whatever was already sounding.
+class LatencyProbe
+{
+  public:
+    void Init(const AudioConfig &config, float threshold = 0.001f)
+    {
+        sample_us_       = 1e6f / config.sample_rate;
+        output_delay_us_ = config.OutputDelayUs();
+        threshold_       = threshold;
+        arrival_us_      = 0;
+        armed_.store(false);
+        stats_.Reset();
+    }
+
+    // MIDI side (main loop).
+    void MarkArrival(uint32_t arrival_us)
+    {
+        arrival_us_ = arrival_us;
+        armed_.store(true, std::memory_order_release);
+    }
+    inline bool IsArmed() const { return armed_.load(std::memory_order_acquire); }
+    // Gives up on a note that never sounded (e.g. the loopback is unpatched).
+    inline void Disarm() { armed_.store(false, std::memory_order_release); }
+
+    // Audio callback, after rendering into `out`.
+    template <typename Out>
+    void ProcessBlock(uint32_t callback_us, const Out &out)
+    {
+        if(!armed_.load(std::memory_order_acquire))
+            return;
+        for(size_t i = 0; i < out.Size(); i++)
+        {
+            if(fabsf(out.left[i]) < threshold_)
+                continue;
+            uint32_t played_us
+                = callback_us + (uint32_t)(output_delay_us_ + i * sample_us_);
+            stats_.Add(played_us - arrival_us_);
+            armed_.store(false, std::memory_order_release);
+            return;
+        }
+    }
+
+    // Read from the main loop while disarmed; the audio side only writes to
+    // it while armed.
+    inline const LatencyStats &GetStats() const { return stats_; }
+
+  private:
+    float             sample_us_;
+    float             output_delay_us_;
+    float             threshold_;
+    uint32_t          arrival_us_;
+    std::atomic<bool> armed_{false};
+    LatencyStats      stats_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_LATENCY_PROBE_H
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef DAISYBED_LOAD_GOVERNOR_H
+#define DAISYBED_LOAD_GOVERNOR_H
+
+#include <stdint.h>
+
+namespace daisybed
+{
+// Turns a per-block CPU load reading (0..1 of the callback budget, e.g. from
+// daisy::CpuLoadMeter) into a degradation level. Level 0 is full quality; each
+// step up asks the firmware to shed something (voices, a shimmer shifter,
+// reverb modulation). What a level means is up to the firmware.
+//
+// Stepping up is fast: one step whenever load exceeds shed_above, at most once
+// per settle_blocks so the previous step has time to show up in the meter.
+// Stepping down is slow: load must stay below restore_below for hold_blocks
+// consecutive blocks. The gap between the two thresholds plus the hold time
+// keeps the level from oscillating around a single threshold.
+class LoadGovernor
+{
+  public:
+    void Init(int      max_level,
+              float    shed_above    = 0.85f,
+              float    restore_below = 0.6f,
+              uint32_t settle_blocks = 32,
+              uint32_t hold_blocks   = 2000)
+    {
+        max_level_     = max_level;
+        shed_above_    = shed_above;
+        restore_below_ = restore_below;
+        settle_blocks_ = settle_blocks;
+        hold_blocks_   = hold_blocks;
+        level_         = 0;
+        since_change_  = settle_blocks;
+        calm_blocks_   = 0;
+    }
+
+    // Call once per audio block; returns the (possibly updated) level.
+    int Update(float load)
+    {
+        if(since_change_ < settle_blocks_)
+            since_change_++;
+
+        if(load > shed_above_)
+        {
+            calm_blocks_ = 0;
+            if(level_ < max_level_ && since_change_ >= settle_blocks_)
+                Step(1);
+        }
+        else if(load < restore_below_)
+        {
+            if(level_ > 0 && ++calm_blocks_ >= hold_blocks_)
+            {
+                calm_blocks_ = 0;
+                Step(-1);
+            }
+        }
+        else
+        {
+            calm_blocks_ = 0;
+        }
+        return level_;
+    }
+
+    inline int GetLevel() const { return level_; }
+
+  private:
+    void Step(int direction)
+    {
+        level_ += direction;
+        since_change_ = 0;
+    }
+
+    int      max_level_, level_;
+    float    shed_above_, restore_below_;
+    uint32_t settle_blocks_, hold_blocks_;
+    uint32_t since_change_, calm_blocks_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_LOAD_GOVERNOR_H
@@ -0,0 +1,135 @@
+#pragma once
+#ifndef DAISYBED_MEMORY_PLAN_H
+#define DAISYBED_MEMORY_PLAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace daisybed
+{
+// Where a firmware's big and hot objects live, checked at compile time.
+//
+// The H750 has three memories worth planning for:
+//
+//   DTCM   128 KB  zero wait states, not reachable by DMA. Small state
+//                  touched every sample: engines without delay lines,
+//                  control scanners, governors, the gate queue.
+//   SRAM   512 KB  AXI SRAM behind the D-cache, where .bss goes by default.
+//                  Delay lines up to a few hundred KB.
+//   SDRAM   64 MB  external, behind the D-cache, but a cache miss costs tens
+//                  of cycles. Long delay lines and sample memory.
+//
+// The firmwares place statics with libDaisy's own section macros:
+// DTCM_MEM_SECTION for DTCM and DSY_SDRAM_BSS for SDRAM; anything else is
+// plain .bss, which libDaisy's linker script puts in AXI SRAM. Neither of the
+// two sections is zeroed at startup (constructors still run), so only place
+// objects whose Init() sets all of their state.
+//
+// Each firmware lists what it places in a constexpr table of Allocations
+// (projects/<name>/src/memory-plan.h) and static_asserts Fits() for every
+// region, so growing a delay line past its region fails the build instead of
+// the link, or a boot. The table uses sizeof() of the real types, so it stays
+// right as the engines change. Each region keeps a reserve for what the
+// table doesn't list: libDaisy's and DaisySP's own statics and the stack in
+// DTCM, the same plus the heap in SRAM.
+//
+// The host memory-plan tool prints every firmware's table with
+// ReportMemoryPlan(). The linker's own per-region totals come with each
+// firmware build (-Wl,--print-memory-usage).
+enum class MemoryRegion : uint8_t
+{
+    kDtcm,
+    kSram,
+    kSdram,
+    kNumRegions,
+};
+
+struct RegionSpec
+{
+    const char *name;
+    size_t      size;
+    size_t      reserve; // left for everything the plan doesn't list
+};
+
+static constexpr RegionSpec kRegionSpecs[] = {
+    {"DTCM", 128 * 1024, 32 * 1024},
+    {"SRAM", 512 * 1024, 64 * 1024},
+    {"SDRAM", 64 * 1024 * 1024, 0},
+};
+
+// One planned static object.
+struct Allocation
+{
+    const char  *name;
+    MemoryRegion region;
+    size_t       bytes;
+};
+
+constexpr const RegionSpec &GetRegionSpec(MemoryRegion region)
+{
+    return kRegionSpecs[static_cast<size_t>(region)];
+}
+
+constexpr size_t RegionBudget(MemoryRegion region)
+{
+    return GetRegionSpec(region).size - GetRegionSpec(region).reserve;
+}
+
+// Objects are at least word-aligned and the larger ones usually 8-byte
+// aligned; round each up so the total doesn't undercount.
+constexpr size_t AlignedBytes(size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+template <size_t N>
+constexpr size_t RegionBytes(const Allocation (&plan)[N], MemoryRegion region)
+{
+    size_t bytes = 0;
+    for(size_t i = 0; i < N; i++)
+        if(plan[i].region == region)
+            bytes += AlignedBytes(plan[i].bytes);
+    return bytes;
+}
+
+template <size_t N>
+constexpr bool Fits(const Allocation (&plan)[N], MemoryRegion region)
+{
+    return RegionBytes(plan, region) <= RegionBudget(region);
+}
+
+// Writes the plan as text, one line at a time, through print(const char *).
+template <size_t N, typename Print>
+void ReportMemoryPlan(const char *firmware, const Allocation (&plan)[N], Print print)
+{
+    char line[96];
+    snprintf(line, sizeof(line), "%s", firmware);
+    print(line);
+    for(size_t r = 0; r < static_cast<size_t>(MemoryRegion::kNumRegions); r++)
+    {
+        MemoryRegion region = static_cast<MemoryRegion>(r);
+        size_t       used   = RegionBytes(plan, region);
+        size_t       budget = RegionBudget(region);
+        snprintf(line,
+                 sizeof(line),
+                 "  %-5s %9zu / %9zu bytes (%5.1f%%)%s",
+                 GetRegionSpec(region).name,
+                 used,
+                 budget,
+                 100.0 * used / budget,
+                 used > budget ? "  OVER BUDGET" : "");
+        print(line);
+        for(size_t i = 0; i < N; i++)
+        {
+            if(plan[i].region != region)
+                continue;
+            snprintf(line, sizeof(line), "    %-24s %9zu", plan[i].name, plan[i].bytes);
+            print(line);
+        }
+    }
+}
+
+} // namespace daisybed
+
+#endif // DAISYBED_MEMORY_PLAN_H
@@ -0,0 +1,134 @@
+#pragma once
+#ifndef DAISYBED_METER_TAP_H
+#define DAISYBED_METER_TAP_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace daisybed
+{
+// What a MeterTap has seen since the last Read().
+struct MeterReading
+{
+    float    peak;   // largest |x|
+    float    rms;    // running RMS (not reset by Read)
+    uint32_t clips;  // samples at or above the clip level
+    uint32_t faults; // blocks with a NaN/Inf, since Init (not reset by Read)
+};
+
+// Level meter that sits between two DSP stages: cheap enough to leave in a
+// release build, so an engine can always tell where it is losing headroom
+// and when a feedback path has gone unstable.
+//
+// The stage loop passes each sample through Observe() (an abs, a max, a
+// multiply-add and a compare); EndBlock() folds the block in once per block.
+// NaN/Inf detection costs nothing per sample: either one poisons the block's
+// sum of squares, which EndBlock() tests once. The test looks at the bits,
+// so it still works under -ffast-math, where isnan() may be folded away.
+//
+// A faulted block makes EndBlock() return true; the owner then resets the
+// offending stage, since a NaN in a feedback loop never leaves on its own.
+class MeterTap
+{
+  public:
+    // rms_seconds: time constant of the running RMS. clip_level: |x| that
+    // counts as a clip (full scale by default).
+    void Init(float sample_rate, float rms_seconds = 0.3f, float clip_level = 1.f)
+    {
+        rms_coefficient_ = 1.f / (rms_seconds * sample_rate);
+        clip_level_      = clip_level;
+        block_peak_      = 0.f;
+        block_sum_       = 0.f;
+        block_clips_     = 0;
+        block_count_     = 0;
+        mean_square_     = 0.f;
+        peak_            = 0.f;
+        clips_           = 0;
+        faults_          = 0;
+    }
+
+    // Returns x, so a tap can wrap an expression in place.
+    inline float Observe(float x)
+    {
+        float magnitude = fabsf(x);
+        block_peak_     = magnitude > block_peak_ ? magnitude : block_peak_;
+        block_sum_ += x * x;
+        block_clips_ += magnitude >= clip_level_;
+        block_count_++;
+        return x;
+    }
+
+    // Once per block, after the stage ran. True if the block contained a
+    // NaN or Inf; the block is then left out of the levels.
+    bool EndBlock()
+    {
+        if(block_count_ == 0)
+            return false;
+
+        bool fault = !IsFinite(block_sum_);
+        if(fault)
+        {
+            faults_++;
+        }
+        else
+        {
+            // One-pole on the block's mean square. n * k stands in for
+            // 1 - exp(-n * k), which is close for any sane block size.
+            float coefficient = block_count_ * rms_coefficient_;
+            if(coefficient > 1.f)
+                coefficient = 1.f;
+            mean_square_ += coefficient * (block_sum_ / block_count_ - mean_square_);
+            if(block_peak_ > peak_)
+                peak_ = block_peak_;
+            clips_ += block_clips_;
+        }
+
+        block_peak_  = 0.f;
+        block_sum_   = 0.f;
+        block_clips_ = 0;
+        block_count_ = 0;
+        return fault;
+    }
+
+    // Peak and clip count since the last Read(), which restarts them.
+    MeterReading Read()
+    {
+        MeterReading reading = {peak_, sqrtf(mean_square_), clips_, faults_};
+        peak_  = 0.f;
+        clips_ = 0;
+        return reading;
+    }
+
+    inline float    GetPeak() const { return peak_; }
+    inline float    GetRms() const { return sqrtf(mean_square_); }
+    inline uint32_t GetClips() const { return clips_; }
+    inline uint32_t GetFaults() const { return faults_; }
+
+  private:
+    static inline bool IsFinite(float f)
+    {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return (bits & 0x7F800000u) != 0x7F800000u;
+    }
+
+    float rms_coefficient_;
+    float clip_level_;
+
+    // Current block
+    float    block_peak_;
+    float    block_sum_;
+    uint32_t block_clips_;
+    uint32_t block_count_;
+
+    float    mean_square_;
+    float    peak_;
+    uint32_t clips_;
+    uint32_t faults_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_METER_TAP_H
@@ -0,0 +1,202 @@
+#pragma once
+#ifndef DAISYBED_MOD_MATRIX_H
+#define DAISYBED_MOD_MATRIX_H
+
+#include <math.h>
+#include <stddef.h>
+
+namespace daisybed
+{
+// Control-rate modulation matrix: sources, registered destinations and a
+// sparse table of routes between them, evaluated once per block.
+//
+// A source is any control-rate value the caller writes each block with
+// SetSource(): an LFO or envelope stepped at control rate, a CV jack, a MIDI
+// CC, the last note's velocity. A destination is a parameter with a base
+// value (usually its knob), a range and a one-pole smoothing coefficient.
+// Each route adds depth * source to one destination.
+//
+// Process() sums the routes into their destinations, clamps each to its
+// range, smooths it and turns the block's movement into a Ramp the engine
+// can read per sample. The cost is one multiply-add per route plus a few
+// operations per destination that is routed or still moving, never sources
+// times destinations; an unrouted parameter sitting at its base costs a
+// flag test.
+//
+// Destinations and sources are numbered in the order they were added, so a
+// caller can add them in the order of its own enum. Set up routes from the
+// same context that calls Process() (or before audio starts); nothing here
+// is synchronised.
+template <int MaxSources, int MaxDestinations, int MaxRoutes>
+class ModMatrix
+{
+  public:
+    // A destination's value across the last block, for sample i of it:
+    // `start` is where the block began and At(size - 1) where Process()
+    // left it.
+    struct Ramp
+    {
+        float start;
+        float step;
+
+        inline float At(size_t i) const { return start + step * (float)(i + 1); }
+    };
+
+    void Init()
+    {
+        num_sources_      = 0;
+        num_destinations_ = 0;
+        num_routes_       = 0;
+    }
+
+    // Returns the new source's index, or -1 when the matrix is full.
+    int AddSource()
+    {
+        if(num_sources_ >= MaxSources)
+            return -1;
+        sources_[num_sources_] = 0.f;
+        return num_sources_++;
+    }
+
+    // `smoothing` is the one-pole coefficient applied per block: 1 follows
+    // the target at once, 0.2 settles within a few tens of blocks. Returns the
+    // new destination's index, or -1 when the matrix is full.
+    int AddDestination(float base, float min, float max, float smoothing = 1.f)
+    {
+        if(num_destinations_ >= MaxDestinations)
+            return -1;
+        Destination &destination = destinations_[num_destinations_];
+        destination.min          = min;
+        destination.max          = max;
+        destination.smoothing    = smoothing;
+        destination.base         = Clamp(destination, base);
+        destination.value        = destination.base;
+        destination.routes       = 0;
+        destination.settled      = true;
+        destination.ramp         = {destination.value, 0.f};
+        return num_destinations_++;
+    }
+
+    // Returns the route's index, or -1 when the table is full or an index is
+    // out of range.
+    int AddRoute(int source, int destination, float depth)
+    {
+        if(num_routes_ >= MaxRoutes || source < 0 || source >= num_sources_
+           || destination < 0 || destination >= num_destinations_)
+            return -1;
+        routes_[num_routes_] = {source, destination, depth};
+        destinations_[destination].routes++;
+        return num_routes_++;
+    }
+
+    inline void SetRouteDepth(int route, float depth) { routes_[route].depth = depth; }
+
+    void ClearRoutes()
+    {
+        for(int d = 0; d < num_destinations_; d++)
+        {
+            destinations_[d].routes  = 0;
+            destinations_[d].settled = false;
+        }
+        num_routes_ = 0;
+    }
+
+    inline void SetSource(int source, float value) { sources_[source] = value; }
+
+    void SetBase(int destination, float base)
+    {
+        Destination &d = destinations_[destination];
+        base           = Clamp(d, base);
+        if(base != d.base)
+        {
+            d.base    = base;
+            d.settled = false;
+        }
+    }
+
+    // Evaluates every route and moves each destination one block of `size`
+    // samples toward its modulated target.
+    void Process(size_t size)
+    {
+        for(int r = 0; r < num_routes_; r++)
+            destinations_[routes_[r].destination].modulation = 0.f;
+        for(int r = 0; r < num_routes_; r++)
+        {
+            const Route &route = routes_[r];
+            destinations_[route.destination].modulation
+                += route.depth * sources_[route.source];
+        }
+
+        float per_sample = size > 0 ? 1.f / (float)size : 0.f;
+        for(int i = 0; i < num_destinations_; i++)
+        {
+            Destination &d = destinations_[i];
+            if(d.routes == 0 && d.settled)
+            {
+                d.ramp.start = d.value;
+                d.ramp.step  = 0.f;
+                continue;
+            }
+
+            float target = d.routes > 0 ? Clamp(d, d.base + d.modulation) : d.base;
+            float from   = d.value;
+            // A coefficient of 1 lands on the target, not a rounding off it.
+            d.value = d.smoothing >= 1.f ? target
+                                         : d.value + d.smoothing * (target - d.value);
+            // Land exactly, so an unrouted destination can go idle.
+            if(fabsf(target - d.value) < kSettleThreshold)
+                d.value = target;
+            d.settled    = d.value == target;
+            d.ramp.start = from;
+            d.ramp.step  = (d.value - from) * per_sample;
+        }
+    }
+
+    // Where the destination ended the last block.
+    inline float GetValue(int destination) const { return destinations_[destination].value; }
+
+    inline const Ramp &GetRamp(int destination) const
+    {
+        return destinations_[destination].ramp;
+    }
+
+    inline int GetRouteCount() const { return num_routes_; }
+
+  private:
+    static constexpr float kSettleThreshold = 1e-6f;
+
+    struct Route
+    {
+        int   source;
+        int   destination;
+        float depth;
+    };
+
+    struct Destination
+    {
+        float base;
+        float min, max;
+        float smoothing;
+        float value;
+        float modulation; // sum of this block's routes
+        int   routes;
+        bool  settled;
+        Ramp  ramp;
+    };
+
+    static inline float Clamp(const Destination &d, float value)
+    {
+        return value < d.min ? d.min : (value > d.max ? d.max : value);
+    }
+
+    float       sources_[MaxSources];
+    Destination destinations_[MaxDestinations];
+    Route       routes_[MaxRoutes];
+    int         num_sources_;
+    int         num_destinations_;
+    int         num_routes_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_MOD_MATRIX_H
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef DAISYBED_MOD_SOURCES_H
+#define DAISYBED_MOD_SOURCES_H
+
+#include <math.h>
+#include <stddef.h>
+
+namespace daisybed
+{
+// Control-rate modulation sources for a ModMatrix. Each is stepped once per
+// block by the block's size and returns its value at the end of it, so it
+// costs a few operations (and at most one sinf/expf) a block whatever the
+// block size; the matrix ramps its destinations across the block.
+
+// Sine LFO, -1..1.
+class ControlLfo
+{
+  public:
+    void Init(float sample_rate, float freq)
+    {
+        sample_rate_ = sample_rate;
+        phase_       = 0.f;
+        SetFreq(freq);
+    }
+
+    inline void SetFreq(float freq) { increment_ = freq / sample_rate_; }
+
+    float Process(size_t size)
+    {
+        phase_ += increment_ * (float)size;
+        phase_ -= floorf(phase_);
+        return sinf(kTwoPi * phase_);
+    }
+
+  private:
+    static constexpr float kTwoPi = 6.2831853f;
+
+    float sample_rate_;
+    float phase_;
+    float increment_;
+};
+
+// Attack/decay envelope, 0..peak: a linear attack, then an exponential decay
+// to zero. Trigger() restarts the attack from wherever the envelope is, so a
+// retrigger doesn't snap back to zero.
+class ControlEnvelope
+{
+  public:
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        value_       = 0.f;
+        peak_        = 0.f;
+        attacking_   = false;
+        SetTimes(0.01f, 0.5f);
+    }
+
+    // Seconds: the attack from 0 to the peak, the decay to about 1/e of it.
+    inline void SetTimes(float attack, float decay)
+    {
+        attack_ = attack > 1e-4f ? attack : 1e-4f;
+        decay_  = decay > 1e-4f ? decay : 1e-4f;
+    }
+
+    inline void Trigger(float peak)
+    {
+        peak_      = peak;
+        attacking_ = true;
+    }
+
+    float Process(size_t size)
+    {
+        float block = (float)size / sample_rate_;
+        if(attacking_)
+        {
+            value_ += peak_ * block / attack_;
+            if(value_ >= peak_)
+            {
+                value_     = peak_;
+                attacking_ = false;
+            }
+        }
+        else if(value_ > 0.f)
+        {
+            value_ *= expf(-block / decay_);
+            if(value_ < kSilence)
+                value_ = 0.f;
+        }
+        return value_;
+    }
+
+  private:
+    static constexpr float kSilence = 1e-4f;
+
+    float sample_rate_;
+    float attack_, decay_;
+    float value_;
+    float peak_;
+    bool  attacking_;
+};
+
+// Envelope follower: one block's peak level, smoothed with separate attack
+// and release times. 0 for silence, about 1 for a full-scale signal.
+class ControlFollower
+{
+  public:
+    void Init(float sample_rate, float attack, float release)
+    {
+        sample_rate_ = sample_rate;
+        value_       = 0.f;
+        attack_      = attack;
+        release_     = release;
+    }
+
+    float Process(float peak, size_t size)
+    {
+        float time = peak > value_ ? attack_ : release_;
+        value_ += (1.f - expf(-(float)size / (time * sample_rate_))) * (peak - value_);
+        return value_;
+    }
+
+  private:
+    float sample_rate_;
+    float attack_, release_;
+    float value_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_MOD_SOURCES_H
@@ -0,0 +1,248 @@
+#pragma once
+#ifndef DAISYBED_MULTI_TAP_DELAY_H
+#define DAISYBED_MULTI_TAP_DELAY_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace daisybed
+{
+// Sparse multi-tap delay for early reflections: one mono write buffer read by
+// up to MaxTaps integer taps, each with its own gain and pan into a stereo
+// output.
+//
+// Where forty daisysp::DelayLines would each write their own buffer every
+// sample, this writes once and reads forty times. Process() runs a block at
+// a time and tap by tap: the taps are kept sorted by delay, and each one
+// reads a contiguous run of the buffer (split in two where it wraps) into
+// the outputs, so the inner loop is a plain multiply-add over sequential
+// memory.
+//
+// SetRoom() lays out a reflection pattern for a room size at control rate.
+// The pattern only changes when the size crosses one of kRoomSteps steps,
+// and a change crossfades from the old taps to the new over one block, so
+// turning the size knob doesn't click.
+//
+// BufferSize must be a power of two. Delays are limited to BufferSize minus
+// one block (GetMaxDelay()), so a block is written in full before any tap
+// reads it. A room whose pattern would reach past that is scaled down as a
+// whole, keeping its shape, rather than having its late taps piled up at
+// the limit.
+template <size_t BufferSize, int MaxTaps>
+class MultiTapDelay
+{
+    static_assert((BufferSize & (BufferSize - 1)) == 0,
+                  "MultiTapDelay buffer size must be a power of two");
+
+  public:
+    static constexpr size_t kMaxBlock  = 64;
+    static constexpr int    kRoomSteps = 32;
+
+    struct Tap
+    {
+        uint32_t delay; // samples
+        float    gain_left, gain_right;
+    };
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        Clear();
+        tap_count_[0] = tap_count_[1] = 0;
+        current_                      = 0;
+        fade_pending_                 = false;
+        room_step_                    = -1;
+        room_taps_                    = 0;
+    }
+
+    // Empties the buffer; the taps are kept.
+    void Clear()
+    {
+        for(size_t i = 0; i < BufferSize; i++)
+            buffer_[i] = 0.f;
+        write_ = 0;
+    }
+
+    static constexpr uint32_t GetMaxDelay() { return BufferSize - kMaxBlock; }
+
+    // Replaces the taps (any order; they're sorted here). Crossfades from the
+    // current set over the next block.
+    void SetTaps(const Tap *taps, int count)
+    {
+        // A change still pending is simply overwritten.
+        int next = 1 - current_;
+        count = count < 0 ? 0 : (count > MaxTaps ? MaxTaps : count);
+        for(int t = 0; t < count; t++)
+        {
+            Tap tap = taps[t];
+            if(tap.delay > GetMaxDelay())
+                tap.delay = GetMaxDelay();
+            // Insertion sort by delay: at most MaxTaps, at control rate.
+            int at = t;
+            for(; at > 0 && taps_[next][at - 1].delay > tap.delay; at--)
+                taps_[next][at] = taps_[next][at - 1];
+            taps_[next][at] = tap;
+        }
+        tap_count_[next] = count;
+        fade_pending_    = true;
+    }
+
+    // Early reflections for a room of `size` (0..1): `count` taps from 2..10
+    // ms out to 10..50 ms, denser and quieter with time, scattered across
+    // the stereo field. The same size always gives the same pattern. Cheap
+    // to call every block.
+    void SetRoom(float size, int count = MaxTaps)
+    {
+        size     = size < 0.f ? 0.f : (size > 1.f ? 1.f : size);
+        int step = (int)(size * (kRoomSteps - 1) + 0.5f);
+        if(step == room_step_ && count == room_taps_)
+            return;
+        room_step_ = step;
+        room_taps_ = count;
+        size       = (float)step / (kRoomSteps - 1);
+
+        // Bigger rooms: later first reflection, longer spread.
+        float max_delay = (float)GetMaxDelay();
+        float first     = (0.002f + 0.008f * size) * sample_rate_;
+        float last      = first + (0.008f + 0.032f * size) * sample_rate_;
+        if(last > max_delay)
+        {
+            // Too big for the buffer: shrink the room rather than clamp
+            // its tail, so the spacing (and 1/distance gains) stay its own.
+            first *= max_delay / last;
+            last = max_delay;
+        }
+
+        Tap      taps[MaxTaps];
+        uint32_t rng    = 0x5EEDu + (uint32_t)step;
+        float    energy = 0.f;
+        count           = count < 0 ? 0 : (count > MaxTaps ? MaxTaps : count);
+        for(int t = 0; t < count; t++)
+        {
+            // Reflections arrive at a rate growing with t^2, so their
+            // arrival times go as the cube root of their index.
+            float position = cbrtf((t + Uniform(rng)) / count);
+            float delay    = first + (last - first) * position;
+            // 1/distance spreading, with a few phase-inverted bounces.
+            float gain = first / delay;
+            if(Uniform(rng) < 0.3f)
+                gain = -gain;
+            // Equal-power pan.
+            float angle = Uniform(rng) * kHalfPi;
+
+            taps[t].delay      = (uint32_t)(delay + 0.5f);
+            taps[t].gain_left  = gain * cosf(angle);
+            taps[t].gain_right = gain * sinf(angle);
+            energy += gain * gain;
+        }
+
+        // Same overall level whatever the size and tap count.
+        float normalise = energy > 0.f ? sqrtf(0.5f / energy) : 0.f;
+        for(int t = 0; t < count; t++)
+        {
+            taps[t].gain_left *= normalise;
+            taps[t].gain_right *= normalise;
+        }
+        SetTaps(taps, count);
+    }
+
+    inline int GetTapCount() const
+    {
+        return fade_pending_ ? tap_count_[1 - current_] : tap_count_[current_];
+    }
+
+    // Writes `size` (at most kMaxBlock) samples of `in`, then sums every tap
+    // into `out_left` / `out_right`, which are overwritten.
+    void Process(const float *in, float *out_left, float *out_right, size_t size)
+    {
+        if(size > kMaxBlock)
+            size = kMaxBlock;
+
+        size_t start = write_;
+        size_t first = BufferSize - start < size ? BufferSize - start : size;
+        for(size_t i = 0; i < first; i++)
+            buffer_[start + i] = in[i];
+        for(size_t i = first; i < size; i++)
+            buffer_[i - first] = in[i];
+        write_ = (write_ + size) & kMask;
+
+        if(!fade_pending_)
+        {
+            SumTaps(current_, start, out_left, out_right, size);
+            return;
+        }
+
+        // Linear crossfade from the old taps to the new ones.
+        float new_left[kMaxBlock], new_right[kMaxBlock];
+        int   next = 1 - current_;
+        SumTaps(current_, start, out_left, out_right, size);
+        SumTaps(next, start, new_left, new_right, size);
+        float step = 1.f / size;
+        for(size_t i = 0; i < size; i++)
+        {
+            float fade   = (i + 1) * step;
+            out_left[i]  = out_left[i] + (new_left[i] - out_left[i]) * fade;
+            out_right[i] = out_right[i] + (new_right[i] - out_right[i]) * fade;
+        }
+        current_      = next;
+        fade_pending_ = false;
+    }
+
+  private:
+    static constexpr size_t kMask   = BufferSize - 1;
+    static constexpr float  kHalfPi = 1.5707963f;
+
+    // One tap set over the block that was just written at `start`.
+    void SumTaps(int set, size_t start, float *out_left, float *out_right, size_t size)
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            out_left[i]  = 0.f;
+            out_right[i] = 0.f;
+        }
+        for(int t = 0; t < tap_count_[set]; t++)
+        {
+            const Tap   &tap  = taps_[set][t];
+            size_t       read = (start - tap.delay) & kMask;
+            size_t       run  = BufferSize - read < size ? BufferSize - read : size;
+            const float *src  = buffer_ + read;
+            for(size_t i = 0; i < run; i++)
+            {
+                out_left[i] += src[i] * tap.gain_left;
+                out_right[i] += src[i] * tap.gain_right;
+            }
+            for(size_t i = run; i < size; i++)
+            {
+                out_left[i] += buffer_[i - run] * tap.gain_left;
+                out_right[i] += buffer_[i - run] * tap.gain_right;
+            }
+        }
+    }
+
+    // Uniform in [0, 1) from a local LCG, so a pattern depends only on its
+    // room step.
+    static inline float Uniform(uint32_t &state)
+    {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) * (1.f / 16777216.f);
+    }
+
+    float sample_rate_;
+
+    float  buffer_[BufferSize];
+    size_t write_;
+
+    // Two tap sets: the current one and, while a change is pending, the next.
+    Tap  taps_[2][MaxTaps];
+    int  tap_count_[2];
+    int  current_;
+    bool fade_pending_;
+
+    int room_step_;
+    int room_taps_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_MULTI_TAP_DELAY_H
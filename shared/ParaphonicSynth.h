@@ -0,0 +1,203 @@
+#pragma once
+#ifndef DAISYBED_PARAPHONIC_SYNTH_H
+#define DAISYBED_PARAPHONIC_SYNTH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "daisysp.h"
+#include "MeterTap.h"
+#include "PitchCv.h"
+
+namespace daisybed
+{
+// Per-block inputs of the awful-paraphonic-synth engine: raw Patch SM ADC
+// readings for CV_1..CV_5 and the sample offsets of this block's gate
+// triggers, in time order.
+struct ParaphonicControls
+{
+    static constexpr size_t kMaxTriggers = 16;
+
+    float  coarse_knob;   // CV_1
+    float  attack_knob;   // CV_2
+    float  cutoff_knob;   // CV_3
+    float  release_knob;  // CV_4
+    float  voct_raw;      // CV_5
+    size_t triggers[kMaxTriggers];
+    size_t trigger_count;
+};
+
+// The awful-paraphonic-synth voice engine without the Patch SM: eight
+// round-robin saw voices summed into one Svf lowpass, each trigger taking the
+// pitch of the coarse knob plus the calibrated V/Oct input.
+//
+// MeterTaps watch the voice sum and the filter output; a NaN or Inf resets
+// the stage it came out of.
+class ParaphonicSynth
+{
+  public:
+    static const size_t NUM_VOICES = 8;
+
+    enum Meter
+    {
+        kMeterVoices,
+        kMeterFilter,
+        kNumMeters,
+    };
+
+    // kConfig record ids for the V/Oct calibration in a trace.
+    static const uint8_t kConfigCalibrationOffset = 0;
+    static const uint8_t kConfigCalibrationScale  = 1;
+
+    void Init(float sample_rate, const PitchCalibration &calibration)
+    {
+        sample_rate_ = sample_rate;
+
+        // Initialize all voices
+        for(size_t v = 0; v < NUM_VOICES; v++)
+        {
+            voices_[v].Init(sample_rate);
+        }
+
+        InitFilter();
+        for(int meter = 0; meter < kNumMeters; meter++)
+        {
+            meters_[meter].Init(sample_rate);
+        }
+
+        pitch_cv_.Init(sample_rate, calibration);
+        active_voice_index_ = 0;
+    }
+
+    inline PitchCv &GetPitchCv() { return pitch_cv_; }
+
+    inline MeterTap &GetMeter(int meter) { return meters_[meter]; }
+    static const char *GetMeterName(int meter)
+    {
+        static const char *const kNames[kNumMeters] = {"voices", "filter"};
+        return kNames[meter];
+    }
+
+    template <typename Out>
+    void ProcessBlock(const ParaphonicControls &controls, const Out &out)
+    {
+        // Pitch for any gate rising edge in this block: coarse knob spans 8
+        // octaves above C0, plus the calibrated V/Oct input.
+        float coarse = daisysp::fmap(controls.coarse_knob, 0.f, 8.f);
+        float voct   = pitch_cv_.Update(controls.voct_raw);
+        float volts  = daisysp::fclamp(coarse + voct, 0.f, 127.f / 12.f);
+        float freq   = pitch_cv_.VoltsToFrequency(volts);
+
+        float filter_cutoff = daisysp::fmap(controls.cutoff_knob, 0.f, 3000.f);
+        float release_time  = daisysp::fmap(controls.release_knob, 0.01f, 2.f);
+        float attack_time   = daisysp::fmap(controls.attack_knob, 0.01f, 1.f);
+
+        // Apply envelope times to *all* voices
+        for(size_t v = 0; v < NUM_VOICES; v++)
+        {
+            voices_[v].envelope.SetTime(daisysp::ADENV_SEG_ATTACK, attack_time);
+            voices_[v].envelope.SetTime(daisysp::ADENV_SEG_DECAY, release_time);
+        }
+
+        // Update filter freq
+        svf_.SetFreq(filter_cutoff);
+
+        size_t next_trigger = 0;
+        for(size_t i = 0; i < out.Size(); i++)
+        {
+            // On a gate rising edge, set the frequency of the active voice
+            // and then trigger it at the exact sample the edge arrived. then
+            // move to the next voice
+            while(next_trigger < controls.trigger_count
+                  && controls.triggers[next_trigger] == i)
+            {
+                voices_[active_voice_index_].Trigger(freq);
+
+                // naive Round-robin voice steal
+                active_voice_index_ = (active_voice_index_ + 1) % NUM_VOICES;
+                next_trigger++;
+            }
+
+            float mix = 0.f;
+            // Sum all voices
+            for(size_t v = 0; v < NUM_VOICES; v++)
+            {
+                mix += voices_[v].Process();
+            }
+
+            // Process sum through the single filter
+            svf_.Process(meters_[kMeterVoices].Observe(mix));
+            float filtered = meters_[kMeterFilter].Observe(svf_.Low());
+
+            out.left[i]  = filtered;
+            out.right[i] = filtered;
+        }
+
+        if(meters_[kMeterVoices].EndBlock())
+        {
+            for(size_t v = 0; v < NUM_VOICES; v++)
+            {
+                voices_[v].Init(sample_rate_);
+            }
+        }
+        if(meters_[kMeterFilter].EndBlock())
+        {
+            InitFilter();
+            svf_.SetFreq(filter_cutoff);
+        }
+    }
+
+  private:
+    void InitFilter()
+    {
+        svf_.Init(sample_rate_);
+        svf_.SetFreq(1000.f);
+        svf_.SetRes(0.7f);
+    }
+
+    // Small Voice abstraction
+    struct Voice
+    {
+        daisysp::Oscillator oscillator;
+        daisysp::AdEnv      envelope;
+
+        void Init(float sample_rate)
+        {
+            oscillator.Init(sample_rate);
+            oscillator.SetWaveform(oscillator.WAVE_POLYBLEP_SAW);
+            oscillator.SetFreq(220);
+            oscillator.SetAmp(0.0f); // amplitude will come from envelope
+            envelope.Init(sample_rate);
+            envelope.SetTime(daisysp::ADENV_SEG_ATTACK, 0.f);
+            envelope.SetTime(daisysp::ADENV_SEG_DECAY, 0.35f);
+            envelope.SetMin(0.0f);
+            envelope.SetMax(1.f);
+            envelope.SetCurve(0.f); // linear
+        }
+
+        // Trigger the envelope and set a new freq
+        void Trigger(float freq)
+        {
+            oscillator.SetFreq(freq);
+            envelope.Trigger();
+        }
+
+        float Process()
+        {
+            float env_sig = envelope.Process();
+            // Scale oscillator amplitude by envelope.
+            oscillator.SetAmp(env_sig * 0.2f);
+            return oscillator.Process();
+        }
+    };
+
+    float        sample_rate_;
+    Voice        voices_[NUM_VOICES];
+    size_t       active_voice_index_;
+    daisysp::Svf svf_; // Single filter on the sum of voices
+    PitchCv      pitch_cv_;
+    MeterTap     meters_[kNumMeters];
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_PARAPHONIC_SYNTH_H
@@ -0,0 +1,143 @@
+#pragma once
+#ifndef DAISYBED_PITCH_CV_H
+#define DAISYBED_PITCH_CV_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace daisybed
+{
+// 2^x from a 256-segment table over one octave plus an exponent-bit shift for
+// whole octaves. Linear interpolation keeps the error under 0.002 cents, and
+// it is a handful of instructions per call, so it can run per sample for
+// glide and through-zero FM.
+class Exp2Table
+{
+  public:
+    void Init()
+    {
+        for(size_t i = 0; i <= kSize; i++)
+            table_[i] = exp2f((float)i / kSize);
+    }
+
+    inline float Exp2(float x) const
+    {
+        float   whole = floorf(x);
+        float   pos   = (x - whole) * kSize;
+        int32_t idx   = (int32_t)pos;
+        if(idx >= (int32_t)kSize) // x a hair below an integer rounds up
+            idx = kSize - 1;
+        float frac = pos - (float)idx;
+        float y = table_[idx] + (table_[idx + 1] - table_[idx]) * frac;
+        return ScaleByPowerOfTwo(y, (int32_t)whole);
+    }
+
+  private:
+    static constexpr size_t kSize = 256;
+
+    // y * 2^n for y in [1, 2), by adding n to the exponent field. Callers stay
+    // well inside the normal range (audio frequencies), so no checks.
+    static inline float ScaleByPowerOfTwo(float y, int32_t n)
+    {
+        uint32_t bits;
+        memcpy(&bits, &y, sizeof(bits));
+        bits += (uint32_t)n << 23;
+        memcpy(&y, &bits, sizeof(y));
+        return y;
+    }
+
+    float table_[kSize + 1];
+};
+
+// Per-unit two-point calibration for a V/Oct input: volts = (raw - offset) *
+// scale. Plain data so it can be kept in daisy::PersistentStorage.
+struct PitchCalibration
+{
+    float offset;
+    float scale;
+
+    // Patch SM CV inputs read -1..1 for -5..+5 V.
+    static PitchCalibration Default() { return {0.f, 5.f}; }
+
+    // Derive from two raw readings taken with known voltages patched in
+    // (e.g. 1 V and 3 V). Leaves the calibration untouched if the readings
+    // are too close together to be meaningful.
+    bool Calibrate(float raw_low, float volts_low, float raw_high, float volts_high)
+    {
+        float span = raw_high - raw_low;
+        if(fabsf(span) < 1e-3f)
+            return false;
+        scale  = (volts_high - volts_low) / span;
+        offset = raw_low - volts_low / scale;
+        return true;
+    }
+
+    inline float ToVolts(float raw) const { return (raw - offset) * scale; }
+
+    bool operator==(const PitchCalibration &rhs) const
+    {
+        return offset == rhs.offset && scale == rhs.scale;
+    }
+    bool operator!=(const PitchCalibration &rhs) const { return !(*this == rhs); }
+};
+
+// V/Oct input pipeline: calibrated ADC reading in, frequency or oscillator
+// phase increment out.
+//
+// Update() takes one fresh ADC reading per audio block, read in the callback
+// itself rather than from a control scan, and uses it alone: a voice takes
+// its pitch once, at its trigger, so anything averaged across blocks would
+// hold a stepped note flat for its whole length. Noise filtering belongs
+// inside the block; the Patch SM's ADC already averages 32 conversions per
+// reading. Conversion goes straight from volts to phase increment through the
+// Exp2 table, with no MIDI-note detour.
+class PitchCv
+{
+  public:
+    static constexpr float kC0Hz = 8.175799f; // MIDI note 0, i.e. 0 V
+
+    void Init(float sample_rate, const PitchCalibration &calibration)
+    {
+        exp2_.Init();
+        calibration_     = calibration;
+        inv_sample_rate_ = 1.f / sample_rate;
+        volts_           = 0.f;
+    }
+
+    inline void SetCalibration(const PitchCalibration &calibration)
+    {
+        calibration_ = calibration;
+    }
+    inline const PitchCalibration &GetCalibration() const { return calibration_; }
+
+    // Block rate: feed this block's raw ADC reading, get the pitch in volts.
+    inline float Update(float raw)
+    {
+        volts_ = calibration_.ToVolts(raw);
+        return volts_;
+    }
+
+    inline float GetVolts() const { return volts_; }
+
+    // Audio rate safe: 0 V is kC0Hz, +1 V per octave.
+    inline float VoltsToFrequency(float volts) const
+    {
+        return kC0Hz * exp2_.Exp2(volts);
+    }
+    // Cycles per sample, for oscillators that take a phase increment.
+    inline float VoltsToPhaseIncrement(float volts) const
+    {
+        return VoltsToFrequency(volts) * inv_sample_rate_;
+    }
+
+  private:
+    Exp2Table        exp2_;
+    PitchCalibration calibration_;
+    float            inv_sample_rate_;
+    float            volts_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_PITCH_CV_H
@@ -0,0 +1,338 @@
+#pragma once
+#ifndef DAISYBED_PRESET_STORE_H
+#define DAISYBED_PRESET_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace daisybed
+{
+// Versioned snapshot storage in NOR flash, written a step at a time from the
+// main loop so a save holds the CPU for one flash operation at a time.
+//
+// The store owns `num_sectors` erase sectors from `address`, cut into slots
+// of SlotSize bytes. A save goes to the slot after the newest one, round the
+// whole region, so every sector is erased equally often: with eight 4 KB
+// sectors and 256-byte slots a sector is erased once per 128 saves. Each
+// slot holds a header (magic, sequence number, payload size and version) and
+// a CRC-32 over both, and Init() takes the valid slot with the highest
+// sequence. The previous snapshot is never erased by the save that replaces
+// it -- a sector is only erased when the save after the newest slot starts a
+// new one -- so a power cut at any point leaves either the old snapshot or
+// the new one, never neither. Slots holding a torn write are skipped.
+//
+// BeginSave() copies the payload and returns at once; Step() then performs
+// the save one short flash operation at a time -- starting a sector erase,
+// polling whether it has finished, a page program, or reading back the slot
+// to verify it -- and returns true while there is more to do. The store never
+// waits out a sector erase (45 ms typical, ~300 ms worst case) itself: with a
+// flash that erases in the background, each Step() while it runs is one
+// status read. A flash may also finish the erase inside StartErase(), as
+// QspiFlash does for now, and that step then holds the main loop for the
+// whole erase. Run Step() from a periodic scheduler task. The header's page is programmed last. A save that fails
+// to verify is retried in the next slot.
+//
+// The flash is injected, as the Scheduler's clock is: QspiFlash.h on the
+// board, a file on the host (host/src/FileFlash.h). A Flash provides:
+//   static constexpr size_t kSectorSize, kPageSize;
+//   bool StartErase(uint32_t address);  // may return before it's done
+//   bool IsBusy();                      // true while that erase runs
+//   bool Program(uint32_t address, const uint8_t *data, size_t size); // a page
+//   void Read(uint32_t address, uint8_t *data, size_t size);
+// Program() and Read() are only called once IsBusy() has returned false.
+//
+// Nothing here touches the audio thread. Capture a snapshot at the top of
+// an audio block and hand it to the main loop, and hand a loaded one back
+// the same way, so the engine sees every preset whole (see basic-monosynth).
+template <typename Flash, size_t SlotSize = 256>
+class PresetStore
+{
+    static_assert(SlotSize % Flash::kPageSize == 0,
+                  "PresetStore slots must be whole flash pages");
+    static_assert(Flash::kSectorSize % SlotSize == 0,
+                  "PresetStore slots must tile a flash sector");
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t sequence;
+        uint16_t size;
+        uint16_t version;
+        uint32_t crc; // over the header with crc = 0, then the payload
+    };
+
+  public:
+    static constexpr size_t kMaxPayload = SlotSize - sizeof(Header);
+
+    struct Stats
+    {
+        uint32_t saves;    // verified
+        uint32_t failures; // erase, program or verify that went wrong
+        uint32_t erases;
+        uint32_t sequence; // of the newest snapshot, 0 if none
+    };
+
+    // Scans the region for the newest valid snapshot. `num_sectors` must be
+    // at least two.
+    void Init(Flash *flash, uint32_t address, uint32_t num_sectors)
+    {
+        flash_           = flash;
+        address_         = address;
+        num_slots_       = num_sectors * kSlotsPerSector;
+        state_           = State::kIdle;
+        stats_           = Stats();
+        newest_slot_     = kNoSlot;
+        newest_sequence_ = 0;
+        newest_size_     = 0;
+        newest_version_  = 0;
+
+        for(uint32_t slot = 0; slot < num_slots_; slot++)
+        {
+            Header header;
+            if(!ReadValid(slot, header))
+                continue;
+            if(newest_slot_ == kNoSlot || (int32_t)(header.sequence - newest_sequence_) > 0)
+            {
+                newest_slot_     = slot;
+                newest_sequence_ = header.sequence;
+                newest_size_     = header.size;
+                newest_version_  = header.version;
+            }
+        }
+        stats_.sequence = newest_sequence_;
+    }
+
+    inline bool HasSnapshot() const { return newest_slot_ != kNoSlot; }
+
+    // Copies the newest snapshot into `out` if it has this version and size.
+    template <typename T>
+    bool Load(T &out, uint16_t version)
+    {
+        static_assert(sizeof(T) <= kMaxPayload, "snapshot larger than a slot");
+        if(newest_slot_ == kNoSlot || newest_version_ != version
+           || newest_size_ != sizeof(T))
+            return false;
+        flash_->Read(SlotAddress(newest_slot_) + sizeof(Header),
+                     reinterpret_cast<uint8_t *>(&out),
+                     sizeof(T));
+        return true;
+    }
+
+    // Starts saving a snapshot. Returns false while an earlier save is still
+    // in progress, or if the payload is too large.
+    bool BeginSave(const void *payload, size_t size, uint16_t version)
+    {
+        if(state_ != State::kIdle || size > kMaxPayload)
+            return false;
+
+        Header header = {kMagic, newest_sequence_ + 1, (uint16_t)size, version, 0};
+        memset(slot_, 0xFF, SlotSize);
+        memcpy(slot_, &header, sizeof(header));
+        memcpy(slot_ + sizeof(header), payload, size);
+        header.crc = Crc32(slot_, sizeof(header) + size);
+        memcpy(slot_, &header, sizeof(header));
+
+        retries_ = 0;
+        target_  = newest_slot_ == kNoSlot ? 0 : Next(newest_slot_);
+        return Prepare();
+    }
+
+    template <typename T>
+    bool BeginSave(const T &snapshot, uint16_t version)
+    {
+        static_assert(sizeof(T) <= kMaxPayload, "snapshot larger than a slot");
+        return BeginSave(&snapshot, sizeof(T), version);
+    }
+
+    inline bool IsBusy() const { return state_ != State::kIdle; }
+
+    // One flash operation of the save in progress. Returns true while there
+    // is more to do.
+    bool Step()
+    {
+        switch(state_)
+        {
+            case State::kErase:
+                stats_.erases++;
+                if(!flash_->StartErase(SlotAddress(target_)))
+                    return Retry();
+                state_ = State::kErasing;
+                return true;
+
+            case State::kErasing:
+                // A failed erase shows up as a failed verify.
+                if(flash_->IsBusy())
+                    return true;
+                page_  = 0;
+                state_ = State::kProgram;
+                return true;
+
+            case State::kProgram:
+            {
+                // Every page after the header's first, the header's last, so
+                // a torn save never even looks like a snapshot.
+                size_t page   = (page_ + 1) % kPagesPerSlot;
+                size_t offset = page * Flash::kPageSize;
+                if(!flash_->Program(SlotAddress(target_) + offset,
+                                    slot_ + offset,
+                                    Flash::kPageSize))
+                    return Retry();
+                if(++page_ == kPagesPerSlot)
+                    state_ = State::kVerify;
+                return true;
+            }
+
+            case State::kVerify:
+            {
+                uint8_t chunk[32];
+                for(size_t offset = 0; offset < SlotSize; offset += sizeof(chunk))
+                {
+                    flash_->Read(SlotAddress(target_) + offset, chunk, sizeof(chunk));
+                    if(memcmp(chunk, slot_ + offset, sizeof(chunk)) != 0)
+                        return Retry();
+                }
+                Header header;
+                memcpy(&header, slot_, sizeof(header));
+                newest_slot_     = target_;
+                newest_sequence_ = header.sequence;
+                newest_size_     = header.size;
+                newest_version_  = header.version;
+                stats_.saves++;
+                stats_.sequence = newest_sequence_;
+                state_          = State::kIdle;
+                return false;
+            }
+
+            case State::kIdle:
+            default: return false;
+        }
+    }
+
+    inline const Stats &GetStats() const { return stats_; }
+
+  private:
+    enum class State : uint8_t
+    {
+        kIdle,
+        kErase,
+        kErasing,
+        kProgram,
+        kVerify,
+    };
+
+    static constexpr uint32_t kMagic          = 0x53504244; // "DBPS"
+    static constexpr uint32_t kNoSlot         = 0xFFFFFFFF;
+    static constexpr uint32_t kSlotsPerSector = Flash::kSectorSize / SlotSize;
+    static constexpr size_t   kPagesPerSlot   = SlotSize / Flash::kPageSize;
+    static constexpr int      kMaxRetries     = 2;
+
+    inline uint32_t SlotAddress(uint32_t slot) const
+    {
+        return address_ + slot * (uint32_t)SlotSize;
+    }
+
+    inline uint32_t Next(uint32_t slot) const { return slot + 1 < num_slots_ ? slot + 1 : 0; }
+
+    // Picks the work for target_: a slot that opens a sector is erased first;
+    // otherwise the first blank slot from there on is programmed as it is.
+    // Never erases the sector holding the newest snapshot.
+    bool Prepare()
+    {
+        for(;;)
+        {
+            if(target_ % kSlotsPerSector == 0)
+            {
+                if(newest_slot_ != kNoSlot
+                   && target_ / kSlotsPerSector == newest_slot_ / kSlotsPerSector)
+                {
+                    stats_.failures++;
+                    state_ = State::kIdle;
+                    return false;
+                }
+                state_ = State::kErase;
+                return true;
+            }
+            if(IsBlank(target_))
+            {
+                page_  = 0;
+                state_ = State::kProgram;
+                return true;
+            }
+            target_ = Next(target_);
+        }
+    }
+
+    bool Retry()
+    {
+        stats_.failures++;
+        if(retries_++ >= kMaxRetries)
+        {
+            state_ = State::kIdle;
+            return false;
+        }
+        target_ = Next(target_);
+        return Prepare();
+    }
+
+    bool IsBlank(uint32_t slot)
+    {
+        uint8_t chunk[32];
+        for(size_t offset = 0; offset < SlotSize; offset += sizeof(chunk))
+        {
+            flash_->Read(SlotAddress(slot) + offset, chunk, sizeof(chunk));
+            for(size_t i = 0; i < sizeof(chunk); i++)
+                if(chunk[i] != 0xFF)
+                    return false;
+        }
+        return true;
+    }
+
+    // Reads a slot into slot_ and checks its header and CRC.
+    bool ReadValid(uint32_t slot, Header &header)
+    {
+        flash_->Read(SlotAddress(slot), slot_, SlotSize);
+        memcpy(&header, slot_, sizeof(header));
+        if(header.magic != kMagic || header.size > kMaxPayload)
+            return false;
+        uint32_t crc = header.crc;
+        header.crc   = 0;
+        memcpy(slot_, &header, sizeof(header));
+        header.crc = crc;
+        return Crc32(slot_, sizeof(header) + header.size) == crc;
+    }
+
+    // CRC-32 (IEEE), bit by bit: a few hundred bytes, once per save or slot.
+    static uint32_t Crc32(const uint8_t *data, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFF;
+        for(size_t i = 0; i < size; i++)
+        {
+            crc ^= data[i];
+            for(int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+    Flash   *flash_;
+    uint32_t address_;
+    uint32_t num_slots_;
+
+    State    state_;
+    uint32_t target_;
+    size_t   page_;
+    int      retries_;
+    uint8_t  slot_[SlotSize];
+
+    uint32_t newest_slot_;
+    uint32_t newest_sequence_;
+    uint16_t newest_size_;
+    uint16_t newest_version_;
+
+    Stats stats_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_PRESET_STORE_H
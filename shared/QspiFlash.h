@@ -0,0 +1,75 @@
+#pragma once
+#ifndef DAISYBED_QSPI_FLASH_H
+#define DAISYBED_QSPI_FLASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "daisy_core.h"
+#include "per/qspi.h"
+#include "stm32h7xx_hal.h"
+
+namespace daisybed
+{
+// PresetStore flash on the Daisy's 8 MB QSPI NOR chip (IS25LP064: 4 KB
+// sectors, 256-byte pages), through libDaisy's QSPIHandle. Addresses are
+// offsets into the chip.
+//
+// StartErase() waits out the chip's sector erase (45 ms typical, up to ~300
+// ms) through QSPIHandle::Erase, so IsBusy() is always false; a program
+// waits for a page (under 1 ms). Both wait with interrupts enabled, so the
+// audio callback keeps running as long as nothing it touches lives in QSPI;
+// the main loop stalls for the whole erase, MIDI included. Starting the
+// erase and polling the chip's WIP bit instead needs the QUADSPI peripheral
+// driven outside libDaisy, out of and back into memory-mapped mode, which
+// hasn't been tried on a board; PresetStore already steps through an erase
+// that way when the flash supports it.
+//
+// Reads go through the memory-mapped window, which sits behind the D-cache,
+// so every erase and program invalidates the lines it changed.
+class QspiFlash
+{
+  public:
+    static constexpr size_t kSectorSize = 4096;
+    static constexpr size_t kPageSize   = 256;
+
+    explicit QspiFlash(daisy::QSPIHandle &qspi) : qspi_(qspi) {}
+
+    // Erases the sector at `address` and returns once the chip is done.
+    bool StartErase(uint32_t address)
+    {
+        bool ok = qspi_.Erase(address, address + kSectorSize)
+                  == daisy::QSPIHandle::Result::OK;
+        Invalidate(address, kSectorSize);
+        return ok;
+    }
+
+    inline bool IsBusy() { return false; }
+
+    bool Program(uint32_t address, const uint8_t *data, size_t size)
+    {
+        bool ok = qspi_.Write(address, size, const_cast<uint8_t *>(data))
+                  == daisy::QSPIHandle::Result::OK;
+        Invalidate(address, size);
+        return ok;
+    }
+
+    void Read(uint32_t address, uint8_t *data, size_t size)
+    {
+        memcpy(data, qspi_.GetData(address), size);
+    }
+
+  private:
+    // Sectors and pages are both whole cache lines.
+    void Invalidate(uint32_t address, size_t size)
+    {
+        SCB_InvalidateDCache_by_Addr(static_cast<uint32_t *>(qspi_.GetData(address)),
+                                     (int32_t)size);
+    }
+
+    daisy::QSPIHandle &qspi_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_QSPI_FLASH_H
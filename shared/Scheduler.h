@@ -0,0 +1,237 @@
+#pragma once
+#ifndef DAISYBED_SCHEDULER_H
+#define DAISYBED_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace daisybed
+{
+// Cooperative main-loop scheduler. Everything outside the audio callback
+// (MIDI polling, LEDs, trace draining, saving settings) runs as a short task
+// instead of spinning in main(); when nothing is due the core sleeps.
+//
+//   periodic task  released every period_us, starting one period after Add
+//   event task     released by Signal(), which is safe to call from an ISR
+//
+// Each release has a deadline (periodic: one period unless given). Due tasks
+// run earliest-deadline-first, each to completion, and the scheduler records
+// per task how late it started and whether it finished past its deadline. A
+// periodic task that falls more than a period behind skips the releases it
+// missed rather than running back to back, and each skipped one counts as a
+// miss.
+//
+// The clock is injected so the same code runs against a simulated clock on
+// the host (host/src/scheduler-sim.cpp). A Clock provides:
+//   uint32_t NowUs();
+//   template <typename Pending> void Idle(uint32_t wake_us, Pending pending);
+// Idle() may return early (any interrupt will do) but must not sleep if
+// pending() is true; see DaisyClock.h for the hardware one.
+template <typename Clock, size_t MaxTasks = 8>
+class Scheduler
+{
+  public:
+    typedef void (*TaskFunction)(void *context);
+
+    static const int kInvalidTask = -1;
+
+    struct TaskStats
+    {
+        uint32_t runs;
+        uint32_t misses;            // finished past the deadline, or skipped
+        uint32_t max_lateness_us;   // release -> start
+        uint32_t max_runtime_us;    // start -> finish
+        uint64_t total_lateness_us; // for the mean
+    };
+
+    void Init(Clock *clock)
+    {
+        clock_      = clock;
+        task_count_ = 0;
+    }
+
+    int AddPeriodic(TaskFunction function,
+                    void        *context,
+                    uint32_t     period_us,
+                    uint32_t     deadline_us = 0)
+    {
+        int id = Add(function, context, deadline_us ? deadline_us : period_us);
+        if(id != kInvalidTask)
+        {
+            tasks_[id].period_us  = period_us;
+            tasks_[id].release_us = clock_->NowUs() + period_us;
+        }
+        return id;
+    }
+
+    int AddEvent(TaskFunction function, void *context, uint32_t deadline_us)
+    {
+        return Add(function, context, deadline_us);
+    }
+
+    // Releases an event task. Safe from interrupts; signalling a task that is
+    // already pending keeps the earlier release time.
+    void Signal(int id)
+    {
+        Task &task = tasks_[id];
+        if(task.signalled.load(std::memory_order_acquire))
+            return;
+        task.release_us = clock_->NowUs();
+        task.signalled.store(true, std::memory_order_release);
+    }
+
+    // Runs every task that is due; if none was, sleeps until the next
+    // periodic release or an event, whichever comes first.
+    void RunOnce()
+    {
+        bool ran = false;
+        int  id;
+        while((id = NextDue(clock_->NowUs())) != kInvalidTask)
+        {
+            RunTask(tasks_[id]);
+            ran = true;
+        }
+        if(!ran)
+            clock_->Idle(NextWake(), [this] { return AnySignalled(); });
+    }
+
+    void Run()
+    {
+        for(;;)
+            RunOnce();
+    }
+
+    inline const TaskStats &GetStats(int id) const { return tasks_[id].stats; }
+
+    void ResetStats()
+    {
+        for(size_t i = 0; i < task_count_; i++)
+            tasks_[i].stats = TaskStats();
+    }
+
+  private:
+    struct Task
+    {
+        TaskFunction      function;
+        void             *context;
+        uint32_t          period_us; // 0 for event tasks
+        uint32_t          deadline_us;
+        volatile uint32_t release_us;
+        std::atomic<bool> signalled;
+        TaskStats         stats;
+    };
+
+    // Wrap-safe "a is at or after b" for the 32-bit microsecond clock.
+    static inline bool AtOrAfter(uint32_t a, uint32_t b)
+    {
+        return (int32_t)(a - b) >= 0;
+    }
+
+    int Add(TaskFunction function, void *context, uint32_t deadline_us)
+    {
+        if(task_count_ >= MaxTasks)
+            return kInvalidTask;
+        Task &task       = tasks_[task_count_];
+        task.function    = function;
+        task.context     = context;
+        task.period_us   = 0;
+        task.deadline_us = deadline_us;
+        task.release_us  = 0;
+        task.signalled.store(false);
+        task.stats = TaskStats();
+        return (int)task_count_++;
+    }
+
+    inline bool IsDue(const Task &task, uint32_t now) const
+    {
+        if(task.period_us == 0)
+            return task.signalled.load(std::memory_order_acquire);
+        return AtOrAfter(now, task.release_us);
+    }
+
+    // Earliest absolute deadline among the due tasks.
+    int NextDue(uint32_t now) const
+    {
+        int      best = kInvalidTask;
+        uint32_t best_deadline = 0;
+        for(size_t i = 0; i < task_count_; i++)
+        {
+            const Task &task = tasks_[i];
+            if(!IsDue(task, now))
+                continue;
+            uint32_t deadline = task.release_us + task.deadline_us;
+            if(best == kInvalidTask || !AtOrAfter(deadline, best_deadline))
+            {
+                best          = (int)i;
+                best_deadline = deadline;
+            }
+        }
+        return best;
+    }
+
+    void RunTask(Task &task)
+    {
+        uint32_t release = task.release_us;
+        if(task.period_us == 0)
+            task.signalled.store(false, std::memory_order_release);
+
+        uint32_t start = clock_->NowUs();
+        task.function(task.context);
+        uint32_t finish = clock_->NowUs();
+
+        TaskStats &stats = task.stats;
+        uint32_t   late  = start - release;
+        stats.runs++;
+        stats.total_lateness_us += late;
+        if(late > stats.max_lateness_us)
+            stats.max_lateness_us = late;
+        if(finish - start > stats.max_runtime_us)
+            stats.max_runtime_us = finish - start;
+        if(finish - release > task.deadline_us)
+            stats.misses++;
+
+        if(task.period_us != 0)
+        {
+            uint32_t next = release + task.period_us;
+            if(AtOrAfter(finish, next + task.period_us))
+            {
+                // More than a period behind: drop the missed releases.
+                uint32_t skipped = (finish - next) / task.period_us;
+                stats.misses += skipped;
+                next += skipped * task.period_us;
+            }
+            task.release_us = next;
+        }
+    }
+
+    uint32_t NextWake() const
+    {
+        uint32_t now  = clock_->NowUs();
+        uint32_t wake = now + 0x7FFFFFFFu;
+        for(size_t i = 0; i < task_count_; i++)
+        {
+            const Task &task = tasks_[i];
+            if(task.period_us != 0 && !AtOrAfter(task.release_us, wake))
+                wake = task.release_us;
+        }
+        return wake;
+    }
+
+    bool AnySignalled() const
+    {
+        for(size_t i = 0; i < task_count_; i++)
+            if(tasks_[i].period_us == 0
+               && tasks_[i].signalled.load(std::memory_order_acquire))
+                return true;
+        return false;
+    }
+
+    Clock *clock_      = nullptr;
+    Task   tasks_[MaxTasks];
+    size_t task_count_ = 0;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_SCHEDULER_H
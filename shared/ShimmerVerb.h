@@ -0,0 +1,453 @@
+#pragma once
+#ifndef DAISYBED_SHIMMER_VERB_H
+#define DAISYBED_SHIMMER_VERB_H
+
+#include <math.h>
+#include <stdint.h>
+#include "daisysp.h"
+#include "DattorroPlate.h"
+#include "GrainCloud.h"
+#include "MeterTap.h"
+#include "ModMatrix.h"
+#include "ModSources.h"
+#include "MultiTapDelay.h"
+
+// Shimmer voice: two daisysp::PitchShifters (default), or one GrainCloud
+// with -DDAISYBED_GRAIN_SHIMMER=ON (see shared/cmake/daisybed.cmake).
+#ifndef DAISYBED_GRAIN_SHIMMER
+#define DAISYBED_GRAIN_SHIMMER 0
+#endif
+
+namespace daisybed
+{
+// Per-block control inputs of the cinematic-verb engine: the raw Patch SM ADC
+// readings, knobs on CV_1..CV_4 and their CV jacks on CV_5..CV_8.
+struct ShimmerVerbControls
+{
+    static constexpr int kNumAdc = 8;
+
+    float adc[kNumAdc];
+};
+
+// The cinematic-verb signal path, hardware-free so the firmware and the host
+// tools run the same code: early reflections from a MultiTapDelay, then a
+// DattorroPlate whose tail is pitch-shifted upward and fed back into its
+// input, then an equal-power dry/wet mix.
+//
+// The reflections feed the plate and go straight into the wet signal too, so
+// the room's size is heard before the tail smears it. K1 spaces them out
+// along with the decay.
+//
+//   K1 + CV_5 -> Size + Tone     (bigger space => longer decay + darker tail,
+//                                 later and wider early reflections)
+//   K2 + CV_6 -> Shimmer amount  (how much pitched tail is fed back)
+//   K3 + CV_7 -> Shimmer interval, stepped: +7 | +12 | +12&+19 | +24
+//   K4 + CV_8 -> Dry / Wet mix (equal-power)
+//
+// Each knob is the base of a ModMatrix destination and its CV jack a source
+// routed to it at full depth, so the sum is clamped and smoothed in one
+// place. The shimmer amount is read per sample from its ramp.
+//
+// Motion (SetMotion(), the Patch SM toggle) adds two more sources: a slow
+// LFO drifting the size, and a follower on the input ducking the mix so the
+// tail blooms in the gaps between phrases. Off, their routes sit at depth 0.
+//
+// Quality levels (from a LoadGovernor):
+//   1 -> shimmer runs on the first pitch-shifter only
+//        (grain shimmer: the grain budget is halved)
+//   2 -> plate tank modulation is frozen as well
+//
+// Built with DAISYBED_GRAIN_SHIMMER the two pitch-shifters are replaced by a
+// GrainCloud: one 128 KB capture buffer instead of two, and a denser,
+// detuned cloud in place of the two fixed windows.
+//
+// MeterTaps watch the shimmer feedback (before the tanh, so a "clip" there is
+// the limiter working), the plate output and the final mix. A NaN or Inf in
+// any of them clears the plate and the shimmer loop.
+class ShimmerVerb
+{
+  public:
+    enum Meter
+    {
+        kMeterShimmer,
+        kMeterPlate,
+        kMeterOutput,
+        kNumMeters,
+    };
+
+    // kConfig record id for the motion toggle in a trace (value 0 or 1).
+    static const uint8_t kConfigMotion = 0;
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+
+        early_.Init(sample_rate);
+        early_.SetRoom(0.5f);
+        reverb_.Init(sample_rate);
+
+#if DAISYBED_GRAIN_SHIMMER
+        grains_.Init(sample_rate);
+#else
+        shifter_first_.Init(sample_rate);
+        shifter_second_.Init(sample_rate);
+        // A touch of internal modulation keeps the shimmer voices from
+        // sounding static.
+        shifter_first_.SetFun(0.1f);
+        shifter_second_.SetFun(0.1f);
+#endif
+
+        shimmer_dc_blocker_.Init(sample_rate);
+
+        second_shifter_enabled_ = true;
+        second_shifter_level_   = 1.f;
+        previous_wet_left_      = 0.f;
+        previous_wet_right_     = 0.f;
+
+        // Knobs as destinations in kMod* order, each CV jack routed to its
+        // knob's. Smoothed but for the interval, which is stepped.
+        modulation_.Init();
+        modulation_.AddDestination(0.6f, 0.f, 1.f, 0.2f);  // kModSize
+        modulation_.AddDestination(0.f, 0.f, 1.f, 0.2f);   // kModShimmer
+        modulation_.AddDestination(0.375f, 0.f, 1.f, 1.f); // kModInterval
+        modulation_.AddDestination(0.4f, 0.f, 1.f, 0.2f);  // kModMix
+        for(int knob = 0; knob < kNumMod; knob++)
+        {
+            modulation_.AddRoute(modulation_.AddSource(), knob, 1.f);
+        }
+        // Then the motion sources, kSourceDrift and kSourceInput.
+        drift_.Init(sample_rate, kDriftHz);
+        follower_.Init(sample_rate, 0.01f, 0.4f);
+        drift_route_ = modulation_.AddRoute(modulation_.AddSource(), kModSize, 0.f);
+        duck_route_  = modulation_.AddRoute(modulation_.AddSource(), kModMix, 0.f);
+        motion_      = false;
+
+        for(int meter = 0; meter < kNumMeters; meter++)
+        {
+            meters_[meter].Init(sample_rate);
+        }
+
+        interval_step_ = 1; // Default: octave up.
+        for(int step = 0; step < kNumIntervals; step++)
+        {
+            intervals_[step] = DefaultInterval(step);
+        }
+    }
+
+    // Overrides the feedback gains of the two pitch-shifters for one K3 step
+    // (0: fifth, 1: octave, 2: octave + fifth, 3: two octaves). For tuning
+    // runs on the host; Init() restores the stock table.
+    void SetIntervalGains(int step, float gain_first, float gain_second)
+    {
+        if(step < 0 || step >= kNumIntervals)
+            return;
+        intervals_[step].gain_first  = gain_first;
+        intervals_[step].gain_second = gain_second;
+    }
+
+    void SetQualityLevel(int level)
+    {
+        reverb_.SetModulation(level < 2);
+#if DAISYBED_GRAIN_SHIMMER
+        int budget = kMaxGrains;
+        if(level >= 1)
+            budget /= 2;
+        grains_.SetGrainBudget(budget);
+#else
+        // Not cleared on the way back: that would be 128 KB of writes in
+        // the callback just as the load has dropped. ProcessBlock() fades
+        // the voice in instead (see kShifterFadeSamples).
+        second_shifter_enabled_ = level < 1;
+#endif
+    }
+
+    // Motion on: the size drifts with a slow LFO and the input's level ducks
+    // the wet/dry mix. Off (the default), the knobs and CV alone set them.
+    void SetMotion(bool on)
+    {
+        motion_ = on;
+        modulation_.SetRouteDepth(drift_route_, on ? kDriftDepth : 0.f);
+        modulation_.SetRouteDepth(duck_route_, on ? -kDuckDepth : 0.f);
+    }
+
+    // Wet/dry mix after smoothing, 0..1 (the firmware drives its LED with it).
+    inline float GetMix() const { return modulation_.GetValue(kModMix); }
+
+    inline MeterTap &GetMeter(int meter) { return meters_[meter]; }
+    static const char *GetMeterName(int meter)
+    {
+        static const char *const kNames[kNumMeters] = {"shimmer", "plate", "output"};
+        return kNames[meter];
+    }
+
+    template <typename In, typename Out>
+    void ProcessBlock(const ShimmerVerbControls &controls,
+                      const In                  &in,
+                      const Out                 &out)
+    {
+        for(int knob = 0; knob < kNumMod; knob++)
+        {
+            modulation_.SetBase(knob, controls.adc[knob]);
+            modulation_.SetSource(knob, controls.adc[knob + kNumMod]);
+        }
+        // The input's peak only matters to the ducking route.
+        float peak = 0.f;
+        if(motion_)
+        {
+            for(size_t i = 0; i < in.Size(); i++)
+            {
+                peak = fmaxf(peak, fmaxf(fabsf(in.left[i]), fabsf(in.right[i])));
+            }
+        }
+        modulation_.SetSource(kSourceDrift, drift_.Process(in.Size()));
+        modulation_.SetSource(kSourceInput, follower_.Process(peak, in.Size()));
+        modulation_.Process(in.Size());
+
+        // K1: bigger => longer tail (more decay) and darker (less brightness).
+        float size = modulation_.GetValue(kModSize);
+        reverb_.SetDecay(daisysp::fmap(size, 0.4f, 0.9f));
+        reverb_.SetBrightness(daisysp::fmap(1.f - size, 0.2f, 0.95f));
+        // Only changes the reflections when K1 crosses a room step.
+        early_.SetRoom(size);
+
+        // K2: shimmer feedback amount, per sample.
+        const Modulation::Ramp &shimmer_ramp = modulation_.GetRamp(kModShimmer);
+
+        // K3: shimmer interval (stepped).
+        const Interval &interval
+            = intervals_[QuantizeInterval(modulation_.GetValue(kModInterval))];
+        float           gain_first  = interval.gain_first;
+        float           gain_second = interval.gain_second;
+#if DAISYBED_GRAIN_SHIMMER
+        grains_.SetInterval(interval.semitones_first,
+                            gain_first,
+                            interval.semitones_second,
+                            gain_second);
+        grains_.BeginBlock(in.Size());
+#else
+        if(second_shifter_enabled_)
+        {
+            second_shifter_level_ += (float)in.Size() / kShifterFadeSamples;
+            if(second_shifter_level_ > 1.f)
+                second_shifter_level_ = 1.f;
+        }
+        else
+        {
+            second_shifter_level_ = 0.f;
+        }
+        // Shedding the upper voice of a stacked interval keeps the level on
+        // the first; bringing it back crossfades.
+        gain_first += gain_second * (1.f - second_shifter_level_);
+        gain_second *= second_shifter_level_;
+        shifter_first_.SetTransposition(interval.semitones_first);
+        shifter_second_.SetTransposition(interval.semitones_second);
+#endif
+
+        // K4: equal-power dry/wet gains.
+        float mix      = modulation_.GetValue(kModMix);
+        float dry_gain = cosf(mix * kHalfPi);
+        float wet_gain = sinf(mix * kHalfPi);
+
+        // The reflections run a chunk at a time, ahead of the per-sample
+        // plate and shimmer loop.
+        for(size_t offset = 0; offset < in.Size(); offset += kEarlyChunk)
+        {
+            size_t chunk = in.Size() - offset;
+            if(chunk > kEarlyChunk)
+                chunk = kEarlyChunk;
+
+            float early_in[kEarlyChunk], early_left[kEarlyChunk],
+                early_right[kEarlyChunk];
+            for(size_t i = 0; i < chunk; i++)
+            {
+                early_in[i]
+                    = 0.5f * (in.left[offset + i] + in.right[offset + i]);
+            }
+            early_.Process(early_in, early_left, early_right, chunk);
+
+            for(size_t i = 0; i < chunk; i++)
+            {
+                size_t sample    = offset + i;
+                float  dry_left  = in.left[sample];
+                float  dry_right = in.right[sample];
+
+                // Pitch-shift the previous (mono) tail upward for the shimmer
+                // feedback.
+                float tail = 0.5f * (previous_wet_left_ + previous_wet_right_);
+#if DAISYBED_GRAIN_SHIMMER
+                float mixed_shift = grains_.Process(tail);
+#else
+                float shifted_first = shifter_first_.Process(tail);
+                float shifted_second
+                    = second_shifter_enabled_ ? shifter_second_.Process(tail) : 0.f;
+                float mixed_shift
+                    = shifted_first * gain_first + shifted_second * gain_second;
+#endif
+                float shimmer = meters_[kMeterShimmer].Observe(
+                    kMaxShimmer * shimmer_ramp.At(sample) * mixed_shift);
+                // Soft-limit + DC-block so the feedback loop blooms instead of
+                // blowing up.
+                shimmer = shimmer_dc_blocker_.Process(tanhf(shimmer));
+
+                float wet_left, wet_right;
+                reverb_.Process(dry_left + shimmer + early_left[i],
+                                dry_right + shimmer + early_right[i],
+                                wet_left,
+                                wet_right);
+
+                meters_[kMeterPlate].Observe(wet_left);
+                meters_[kMeterPlate].Observe(wet_right);
+
+                previous_wet_left_  = wet_left;
+                previous_wet_right_ = wet_right;
+
+                wet_left += kEarlyMix * early_left[i];
+                wet_right += kEarlyMix * early_right[i];
+
+                out.left[sample] = meters_[kMeterOutput].Observe(
+                    dry_left * dry_gain + wet_left * wet_gain);
+                out.right[sample] = meters_[kMeterOutput].Observe(
+                    dry_right * dry_gain + wet_right * wet_gain);
+            }
+        }
+
+        // Evaluate every tap (each restarts its block), then reset once.
+        bool fault = false;
+        for(int meter = 0; meter < kNumMeters; meter++)
+        {
+            fault |= meters_[meter].EndBlock();
+        }
+        if(fault)
+        {
+            ClearTail();
+        }
+    }
+
+  private:
+    static constexpr float kHalfPi             = 1.5707963f;
+    static constexpr int   kNumIntervals       = 4;
+    static constexpr int   kMaxGrains          = 16;
+    static constexpr int   kNumReflections     = 40;
+    static constexpr float kEarlyMix           = 0.5f;
+    static constexpr float kMaxShimmer         = 0.85f;
+    // Motion: the size drifts +-0.08 about once every 14 s, and a
+    // full-scale input pulls the mix down by up to 0.5.
+    static constexpr float kDriftHz            = 0.07f;
+    static constexpr float kDriftDepth         = 0.08f;
+    static constexpr float kDuckDepth          = 0.5f;
+    // daisysp's SHIFT_BUFFER_SIZE. A re-enabled second shifter fades in over
+    // this long, by which time what was left in its buffer while it was off
+    // has been overwritten.
+    static constexpr float kShifterFadeSamples = 16384.f;
+
+    // Modulation destinations, one per knob, in the order Init() adds them.
+    // Unpatched CV jacks read ~0, so each knob alone still spans its range.
+    enum
+    {
+        kModSize,
+        kModShimmer,
+        kModInterval,
+        kModMix,
+        kNumMod,
+    };
+    // Sources: the four CV jacks in kMod* order, then the motion sources.
+    enum
+    {
+        kSourceDrift = kNumMod,
+        kSourceInput,
+        kNumSources,
+    };
+    using Modulation = ModMatrix<kNumSources, kNumMod, kNumSources>;
+
+    // 4096 samples holds ~84 ms at 48 kHz, room for the 50 ms K1 spreads
+    // the largest room over; 2048 would squeeze everything past ~78% of K1.
+    using EarlyReflections = MultiTapDelay<4096, kNumReflections>;
+    static constexpr size_t kEarlyChunk = EarlyReflections::kMaxBlock;
+
+    // Recovery from a NaN/Inf: the plate and the shimmer loop feed each other,
+    // so both start again from silence. Settings are kept.
+    void ClearTail()
+    {
+        early_.Clear();
+        reverb_.Clear();
+#if DAISYBED_GRAIN_SHIMMER
+        grains_.Clear();
+#else
+        shifter_first_.Init(sample_rate_);
+        shifter_first_.SetFun(0.1f);
+        shifter_second_.Init(sample_rate_);
+        shifter_second_.SetFun(0.1f);
+#endif
+        shimmer_dc_blocker_.Init(sample_rate_);
+        previous_wet_left_  = 0.f;
+        previous_wet_right_ = 0.f;
+    }
+
+    // A little hysteresis around each edge keeps CV noise from flipping the
+    // interval mid-tail.
+    int QuantizeInterval(float control)
+    {
+        static const float kStepEdges[3] = {0.25f, 0.5f, 0.75f};
+        const float        kHysteresis   = 0.02f;
+        for(int edge = 0; edge < 3; edge++)
+        {
+            if(interval_step_ <= edge && control > kStepEdges[edge] + kHysteresis)
+                interval_step_ = edge + 1;
+            else if(interval_step_ > edge
+                    && control < kStepEdges[edge] - kHysteresis)
+                interval_step_ = edge;
+        }
+        return interval_step_;
+    }
+
+    struct Interval
+    {
+        float semitones_first, gain_first;
+        float semitones_second, gain_second;
+    };
+
+    static Interval DefaultInterval(int step_index)
+    {
+        switch(step_index)
+        {
+            case 0: return {7.f, 1.f, 7.f, 0.f};       // Fifth up: harmonic, pad-like
+            case 2: return {12.f, 0.8f, 19.f, 0.8f};   // Octave + fifth: lush cinematic stack
+            case 3: return {24.f, 1.f, 24.f, 0.f};     // Two octaves up: glassy, airy sparkle
+            case 1:                                    // Octave up: classic shimmer
+            default: return {12.f, 1.f, 12.f, 0.f};
+        }
+    }
+
+    float sample_rate_;
+
+    EarlyReflections early_;
+    DattorroPlate    reverb_;
+#if DAISYBED_GRAIN_SHIMMER
+    // 32768 samples is ~0.68 s at 48 kHz, enough for a two-octave grain of
+    // the longest length plus full position jitter.
+    GrainCloud<32768, kMaxGrains> grains_;
+#else
+    daisysp::PitchShifter shifter_first_;
+    daisysp::PitchShifter shifter_second_;
+#endif
+    daisysp::DcBlock shimmer_dc_blocker_;
+    bool             second_shifter_enabled_;
+    float            second_shifter_level_; // 0..1, see kShifterFadeSamples
+
+    float previous_wet_left_, previous_wet_right_;
+
+    Modulation      modulation_;
+    ControlLfo      drift_;
+    ControlFollower follower_;
+    int             drift_route_, duck_route_;
+    bool            motion_;
+
+    int      interval_step_;
+    Interval intervals_[kNumIntervals];
+
+    MeterTap meters_[kNumMeters];
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_SHIMMER_VERB_H
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef DAISYBED_SIMPLE_REVERB_H
+#define DAISYBED_SIMPLE_REVERB_H
+
+#include "daisysp.h"
+#include "Denormals.h"
+
+namespace daisybed
+{
+// Simple Schroeder Reverb implementation
+class SimpleReverb {
+private:
+    static const int NUM_COMBS = 8;
+    static const int NUM_ALLPASS = 4;
+
+    // Larger delay lines for longer reverb tail
+    daisysp::DelayLine<float, 8192> combDelays[NUM_COMBS];     // Doubled buffer size
+    daisysp::DelayLine<float, 4096> allpassDelays[NUM_ALLPASS]; // Doubled buffer size
+
+    // Higher feedback coefficients for longer decay
+    float combFeedback[NUM_COMBS] = {0.95f, 0.94f, 0.93f, 0.92f, 0.91f, 0.90f, 0.89f, 0.88f};
+    float allpassFeedback = 0.85f;  // Increased from 0.8
+
+    // Longer delay lengths (still using prime numbers)
+    int combLengths[NUM_COMBS] = {7919, 8147, 8423, 8699, 8969, 9241, 9511, 9767};
+    int allpassLengths[NUM_ALLPASS] = {2371, 3079, 3677, 4177};
+
+    float mix = 0.5f;
+    float feedback = 0.85f;
+    // Per-comb feedback taper applied by SetFeedback: comb i gets
+    // feedback * (combTaperBase - i * combTaperStep).
+    float combTaperBase = 0.88f;
+    float combTaperStep = 0.01f;
+    float denormalOffset = kDenormalOffset;
+
+public:
+    void Init(float sampleRate) {
+        for(int i = 0; i < NUM_COMBS; i++) {
+            combDelays[i].Init();
+            combDelays[i].SetDelay(static_cast<size_t>(combLengths[i]));
+        }
+        for(int i = 0; i < NUM_ALLPASS; i++) {
+            allpassDelays[i].Init();
+            allpassDelays[i].SetDelay(static_cast<size_t>(allpassLengths[i]));
+        }
+    }
+
+    void SetMix(float newMix) { mix = newMix; }
+    void SetFeedback(float newFeedback) {
+        feedback = newFeedback;
+        for(int i = 0; i < NUM_COMBS; i++) {
+            combFeedback[i] = feedback * (combTaperBase - i * combTaperStep);  // Higher base feedback
+        }
+    }
+    void SetCombTaper(float base, float step) {
+        combTaperBase = base;
+        combTaperStep = step;
+        SetFeedback(feedback);
+    }
+    // Tiny DC in the comb feedback keeps the tail out of subnormals.
+    void SetDenormalOffset(bool on) { denormalOffset = on ? kDenormalOffset : 0.0f; }
+
+    float Process(float in) {
+        float combOut = 0.0f;
+
+        // Parallel comb filters
+        for(int i = 0; i < NUM_COMBS; i++) {
+            float delay = combDelays[i].Read();
+            combDelays[i].Write(in + delay * combFeedback[i] + denormalOffset);
+            combOut += delay;
+        }
+        combOut *= 0.16f;  // Adjusted scaling for 6 combs
+
+        // Series allpass filters
+        float allpassOut = combOut;
+        for(int i = 0; i < NUM_ALLPASS; i++) {
+            float delay = allpassDelays[i].Read();
+            float temp = allpassOut + delay * allpassFeedback;
+            allpassDelays[i].Write(temp);
+            allpassOut = delay - temp * allpassFeedback;
+        }
+
+        // Mix dry and wet with slight emphasis on wet signal
+        return in * (1.0f - mix) + allpassOut * (mix * 1.2f);
+    }
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_SIMPLE_REVERB_H
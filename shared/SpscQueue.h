@@ -0,0 +1,90 @@
+#pragma once
+#ifndef DAISYBED_SPSC_QUEUE_H
+#define DAISYBED_SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace daisybed
+{
+// Lock-free single-producer / single-consumer ring buffer for handing small
+// records between an interrupt and the main loop (or between the main loop
+// and the audio callback). Each side only ever writes its own index, so no
+// critical sections are needed on a single core or across two host threads.
+//
+// Capacity must be a power of two; one slot is always left empty.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+  public:
+    SpscQueue() : head_(0), tail_(0) {}
+
+    // Empties the queue. Only while neither side can run, e.g. from an
+    // Init() before the interrupt that feeds it is enabled.
+    void Reset()
+    {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    // Producer side. Returns false (and drops the item) when full.
+    bool Push(const T &item)
+    {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t next = (head + 1) & kMask;
+        if(next == tail_.load(std::memory_order_acquire))
+            return false;
+        items_[head] = item;
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool Pop(T &item)
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if(tail == head_.load(std::memory_order_acquire))
+            return false;
+        item = items_[tail];
+        tail_.store((tail + 1) & kMask, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: look at the oldest item without removing it.
+    bool Peek(T &item) const
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if(tail == head_.load(std::memory_order_acquire))
+            return false;
+        item = items_[tail];
+        return true;
+    }
+
+    inline bool IsEmpty() const
+    {
+        return head_.load(std::memory_order_acquire)
+               == tail_.load(std::memory_order_acquire);
+    }
+
+    inline size_t Size() const
+    {
+        return (head_.load(std::memory_order_acquire)
+                - tail_.load(std::memory_order_acquire))
+               & kMask;
+    }
+
+  private:
+    static constexpr uint32_t kMask = Capacity - 1;
+
+    T                     items_[Capacity];
+    std::atomic<uint32_t> head_;
+    std::atomic<uint32_t> tail_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_SPSC_QUEUE_H
@@ -0,0 +1,477 @@
+#pragma once
+#ifndef DAISYBED_SYNTH_ENGINE_H
+#define DAISYBED_SYNTH_ENGINE_H
+
+#include <stdint.h>
+#include "daisysp.h"
+#include "knob.h"
+#include "MeterTap.h"
+#include "ModMatrix.h"
+#include "ModSources.h"
+#include "VoiceBank.h"
+#include "SimpleReverb.h"
+#include "WavetableOsc.h"
+
+namespace daisybed
+{
+// Per-block control inputs of the basic-monosynth engine, as read from the Pod.
+struct SynthControls {
+    float knob1;
+    float knob2;
+    int32_t encoderIncrement;
+    bool button1Rising;
+    bool button2Rising;
+};
+
+// The engine's sounding parameters, as PresetStore saves them. Bump VERSION
+// whenever the fields change; a snapshot of another version is not loaded.
+struct SynthSnapshot {
+    enum Field {
+        ATTACK,
+        RELEASE,
+        CUTOFF,
+        RESONANCE,
+        REVERB_FEEDBACK,
+        REVERB_MIX,
+        WAVEFORM,
+        NUM_FIELDS
+    };
+    static const uint16_t VERSION = 1;
+
+    float values[NUM_FIELDS];
+};
+
+// The basic-monosynth engine without the Pod: MIDI-driven VoiceBank into an
+// Svf lowpass and the Schroeder reverb, with the two-knob/two-button mode
+// layer on top. The firmware owns the hardware (LEDs, MIDI transport) and
+// feeds this once per block; the host tools drive the very same code.
+//
+// MeterTaps sit between the stages. A NaN or Inf resets the stage it came
+// out of: the voices are silenced, the filter or reverb state is cleared.
+//
+// The knobs don't set their parameters directly: each sets the base of a
+// ModMatrix destination, and the matrix applies them once per block. Two
+// control-rate sources are routed to the cutoff: a 5 Hz LFO whose depth
+// follows the mod wheel (CC 1), and a filter envelope, triggered by each
+// note at its velocity and timed by the AD knobs, whose depth follows
+// CC 74. With both controllers at zero the knobs alone set the sound.
+class SynthEngine {
+public:
+    static const int NUM_VOICES = 10;
+    // Under CPU pressure each quality level takes two voices off the ceiling.
+    static const int MIN_VOICES = 4;
+    static const int VOICES_PER_LEVEL = 2;
+    static const int MAX_QUALITY_LEVEL = (NUM_VOICES - MIN_VOICES) / VOICES_PER_LEVEL;
+
+    // Mode tracking
+    enum Mode {
+        MODE_DEFAULT,
+        MODE_FILTER,
+        MODE_AD,
+        MODE_REVERB
+    };
+
+    // Modulation sources and destinations, in the order Init() adds them.
+    enum ModSource {
+        MOD_LFO,
+        MOD_ENVELOPE,
+        NUM_MOD_SOURCES
+    };
+    enum ModDestination {
+        MOD_ATTACK,
+        MOD_RELEASE,
+        MOD_CUTOFF,
+        MOD_RESONANCE,
+        MOD_REVERB_FEEDBACK,
+        MOD_REVERB_MIX,
+        NUM_MOD_DESTINATIONS
+    };
+
+    enum Meter {
+        METER_VOICES,   // voice sum after the headroom scale
+        METER_FILTER,   // lowpass output, before the safety clamp
+        METER_OUTPUT,   // after the reverb
+        NUM_METERS
+    };
+
+    void Init(float sampleRate) {
+        this->sampleRate = sampleRate;
+
+        // Initialize all oscillators
+        filter.Init(sampleRate);
+
+        // Initialize reverb
+        reverb.Init(sampleRate);
+        reverb.SetFeedback(0.7f);  // Higher initial feedback
+        reverb.SetMix(0.4f);  // Higher initial mix
+
+        // Initialize oscillators and envelopes for each voice
+        voices.Init(sampleRate);
+
+        // Initialize controls
+        controls.Init();
+
+        // Set up filter
+        filterFreq = 200.0f;  // Svf's own default until the cutoff knob moves
+        filterRes = 0.4f;  // Set a moderate fixed resonance
+        filter.SetRes(filterRes);
+        attackTime = 0.005f;
+        releaseTime = 0.35f;
+
+        for(int m = 0; m < NUM_METERS; m++) {
+            meters[m].Init(sampleRate);
+        }
+
+        // Destinations start where the code above left each parameter, so
+        // nothing is applied until a knob or a source moves it. Smoothing is
+        // off: the knobs are already deadbanded, and the Svf and reverb take
+        // their settings per block anyway.
+        modulation.Init();
+        modulation.AddSource();  // MOD_LFO
+        modulation.AddSource();  // MOD_ENVELOPE
+        applied[MOD_ATTACK] = attackTime;
+        applied[MOD_RELEASE] = releaseTime;
+        applied[MOD_CUTOFF] = filterFreq;
+        applied[MOD_RESONANCE] = filterRes;
+        applied[MOD_REVERB_FEEDBACK] = 0.7f;
+        applied[MOD_REVERB_MIX] = 0.4f;
+        static const float RANGES[NUM_MOD_DESTINATIONS][2] = {
+            {0.001f, 1.0f}, {0.1f, 1.0f}, {200.0f, 10000.0f},
+            {0.1f, 0.95f}, {0.4f, 0.95f}, {0.1f, 0.9f}
+        };
+        for(int d = 0; d < NUM_MOD_DESTINATIONS; d++) {
+            modulation.AddDestination(applied[d], RANGES[d][0], RANGES[d][1]);
+        }
+        lfoRoute = modulation.AddRoute(MOD_LFO, MOD_CUTOFF, 0.0f);
+        envelopeRoute = modulation.AddRoute(MOD_ENVELOPE, MOD_CUTOFF, 0.0f);
+        lfo.Init(sampleRate, LFO_FREQ);
+        filterEnvelope.Init(sampleRate);
+        modWheel = 0.0f;
+        envelopeAmount = 0.0f;
+
+        currentMode = MODE_DEFAULT;
+        currentWaveform = 0;
+    }
+
+    // Raw MIDI channel message; note on/off, CC 1 and CC 74 are used, the
+    // rest is ignored.
+    void HandleMidi(uint8_t status, uint8_t data0, uint8_t data1) {
+        switch(status & 0xF0) {
+            case 0x90:
+                if(data1 == 0) {
+                    // Note-off message in disguise
+                    voices.NoteOff(data0);
+                    return;
+                }
+                voices.NoteOn(data0, data1 / 127.0f);
+                filterEnvelope.Trigger(data1 / 127.0f);
+                break;
+
+            case 0x80:
+                voices.NoteOff(data0);
+                break;
+
+            case 0xB0:
+                if(data0 == 1) {
+                    modWheel = data1 / 127.0f;
+                } else if(data0 == 74) {
+                    envelopeAmount = data1 / 127.0f;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void SetQualityLevel(int level) {
+        voices.SetVoiceLimit(NUM_VOICES - level * VOICES_PER_LEVEL);
+    }
+
+    // Applies one block of control input. Returns true when the mode changed,
+    // so the firmware knows to refresh its LEDs.
+    bool ProcessControls(const SynthControls &in) {
+        // Handle encoder for waveform selection
+        int32_t inc = in.encoderIncrement;
+        if(inc != 0) {
+            currentWaveform = (currentWaveform + inc) % NUM_WAVEFORMS;
+            if(currentWaveform < 0) currentWaveform = NUM_WAVEFORMS - 1;
+
+            // Set all oscillators to the same waveform
+            voices.SetWaveform(waveform(currentWaveform));
+        }
+
+        // Handle mode switching
+        bool modeChanged = false;
+        if(in.button1Rising) {
+            if(currentMode == MODE_FILTER) {
+                currentMode = MODE_DEFAULT;
+            } else {
+                currentMode = MODE_FILTER;
+            }
+            controls.ResetMode(currentMode);
+            modeChanged = true;
+        }
+
+        if(in.button2Rising) {
+            if(currentMode == MODE_AD) {
+                currentMode = MODE_REVERB;
+            } else if(currentMode == MODE_REVERB) {
+                currentMode = MODE_DEFAULT;
+            } else {
+                currentMode = MODE_AD;
+            }
+            controls.ResetMode(currentMode);
+            modeChanged = true;
+        }
+
+        switch(currentMode) {
+            case MODE_AD:
+                if (controls.attackKnob.Update(in.knob1)) {
+                    attackTime = controls.attackKnob.GetValue();
+                    modulation.SetBase(MOD_ATTACK, attackTime);
+                }
+
+                if (controls.releaseKnob.Update(in.knob2)) {
+                    releaseTime = controls.releaseKnob.GetValue();
+                    modulation.SetBase(MOD_RELEASE, releaseTime);
+                }
+                break;
+
+            case MODE_FILTER:
+                if (controls.cutoffKnob.Update(in.knob1)) {
+                    filterFreq = controls.cutoffKnob.GetValue();
+                    modulation.SetBase(MOD_CUTOFF, filterFreq);
+                }
+
+                if (controls.resonanceKnob.Update(in.knob2)) {
+                    filterRes = controls.resonanceKnob.GetValue();
+                    modulation.SetBase(MOD_RESONANCE, filterRes);
+                }
+                break;
+
+            case MODE_REVERB:
+                if (controls.reverbFeedbackKnob.Update(in.knob1)) {
+                    modulation.SetBase(MOD_REVERB_FEEDBACK,
+                                       controls.reverbFeedbackKnob.GetValue());
+                }
+
+                if (controls.reverbMixKnob.Update(in.knob2)) {
+                    modulation.SetBase(MOD_REVERB_MIX, controls.reverbMixKnob.GetValue());
+                }
+                break;
+
+            case MODE_DEFAULT:
+                break;
+        }
+        return modeChanged;
+    }
+
+    // Renders one block, the same mono signal on every output channel.
+    template <typename Out>
+    void ProcessBlock(const Out &out) {
+        processModulation(out.Size());
+
+        for(size_t i = 0; i < out.Size(); i++)
+        {
+            float signal = voices.Process();
+
+            // Scale final mix to prevent clipping
+            signal *= (0.7f / NUM_VOICES);  // Reduced further for reverb headroom
+            meters[METER_VOICES].Observe(signal);
+
+            filter.Process(signal);
+            float filtered = meters[METER_FILTER].Observe(filter.Low());
+
+            // Add safety clipping
+            filtered = daisysp::fclamp(filtered, -1.0f, 1.0f);
+
+            // Process reverb
+            float processed = meters[METER_OUTPUT].Observe(reverb.Process(filtered));
+
+            out.left[i] = processed;
+            out.right[i] = processed;
+        }
+        checkMeters();
+    }
+
+    Mode GetMode() const { return currentMode; }
+
+    // What is sounding now: untouched parameters hold their Init() values,
+    // not their knobs' defaults.
+    void GetSnapshot(SynthSnapshot &out) const {
+        out.values[SynthSnapshot::ATTACK] = attackTime;
+        out.values[SynthSnapshot::RELEASE] = releaseTime;
+        out.values[SynthSnapshot::CUTOFF] = filterFreq;
+        out.values[SynthSnapshot::RESONANCE] = filterRes;
+        out.values[SynthSnapshot::REVERB_FEEDBACK] = controls.reverbFeedbackKnob.GetValue();
+        out.values[SynthSnapshot::REVERB_MIX] = controls.reverbMixKnob.GetValue();
+        out.values[SynthSnapshot::WAVEFORM] = (float)currentWaveform;
+    }
+
+    // Applies a whole snapshot between two blocks (the next block takes it
+    // up). The knobs take the loaded values and have to catch them before
+    // they move anything again.
+    void ApplySnapshot(const SynthSnapshot &in) {
+        attackTime = in.values[SynthSnapshot::ATTACK];
+        releaseTime = in.values[SynthSnapshot::RELEASE];
+        filterFreq = in.values[SynthSnapshot::CUTOFF];
+        filterRes = in.values[SynthSnapshot::RESONANCE];
+        modulation.SetBase(MOD_ATTACK, attackTime);
+        modulation.SetBase(MOD_RELEASE, releaseTime);
+        modulation.SetBase(MOD_CUTOFF, filterFreq);
+        modulation.SetBase(MOD_RESONANCE, filterRes);
+        modulation.SetBase(MOD_REVERB_FEEDBACK, in.values[SynthSnapshot::REVERB_FEEDBACK]);
+        modulation.SetBase(MOD_REVERB_MIX, in.values[SynthSnapshot::REVERB_MIX]);
+
+        controls.attackKnob.SetValue(attackTime);
+        controls.releaseKnob.SetValue(releaseTime);
+        controls.cutoffKnob.SetValue(filterFreq);
+        controls.resonanceKnob.SetValue(filterRes);
+        controls.reverbFeedbackKnob.SetValue(in.values[SynthSnapshot::REVERB_FEEDBACK]);
+        controls.reverbMixKnob.SetValue(in.values[SynthSnapshot::REVERB_MIX]);
+
+        int waveformIndex = (int)in.values[SynthSnapshot::WAVEFORM];
+        if(waveformIndex >= 0 && waveformIndex < NUM_WAVEFORMS) {
+            currentWaveform = waveformIndex;
+            voices.SetWaveform(waveform(currentWaveform));
+        }
+    }
+
+    MeterTap &GetMeter(int meter) { return meters[meter]; }
+    static const char *GetMeterName(int meter) {
+        static const char *const NAMES[NUM_METERS] = {"voices", "filter", "output"};
+        return NAMES[meter];
+    }
+
+    VoiceBank<NUM_VOICES> voices;
+
+private:
+    static constexpr float LFO_FREQ = 5.0f;
+    // Full mod wheel swings the cutoff +-1.5 kHz; full CC 74 and velocity
+    // open it 6 kHz at the envelope's peak.
+    static constexpr float LFO_CUTOFF_DEPTH = 1500.0f;
+    static constexpr float ENVELOPE_CUTOFF_DEPTH = 6000.0f;
+
+    // Steps the sources one block, runs the matrix and hands the parameters
+    // that moved to the voices, filter and reverb.
+    void processModulation(size_t size) {
+        modulation.SetRouteDepth(lfoRoute, modWheel * LFO_CUTOFF_DEPTH);
+        modulation.SetRouteDepth(envelopeRoute, envelopeAmount * ENVELOPE_CUTOFF_DEPTH);
+        modulation.SetSource(MOD_LFO, lfo.Process(size));
+        filterEnvelope.SetTimes(applied[MOD_ATTACK], applied[MOD_RELEASE]);
+        modulation.SetSource(MOD_ENVELOPE, filterEnvelope.Process(size));
+        modulation.Process(size);
+
+        for(int d = 0; d < NUM_MOD_DESTINATIONS; d++) {
+            float value = modulation.GetValue(d);
+            if(value == applied[d]) {
+                continue;
+            }
+            applied[d] = value;
+            switch(d) {
+                case MOD_ATTACK: voices.SetAttack(value); break;
+                case MOD_RELEASE: voices.SetDecay(value); break;
+                case MOD_CUTOFF: filter.SetFreq(value); break;
+                case MOD_RESONANCE: filter.SetRes(value); break;
+                case MOD_REVERB_FEEDBACK: reverb.SetFeedback(value); break;
+                case MOD_REVERB_MIX: reverb.SetMix(value); break;
+            }
+        }
+    }
+
+    // Resets whichever stage put out a NaN or Inf this block. The clamp keeps
+    // a dead filter from reaching the reverb, but the filter itself would
+    // never recover.
+    void checkMeters() {
+        if(meters[METER_VOICES].EndBlock()) {
+            for(int v = 0; v < NUM_VOICES; v++) {
+                voices.voices[v].Clear();
+            }
+        }
+        if(meters[METER_FILTER].EndBlock()) {
+            filter.Init(sampleRate);
+            filter.SetFreq(applied[MOD_CUTOFF]);
+            filter.SetRes(applied[MOD_RESONANCE]);
+        }
+        if(meters[METER_OUTPUT].EndBlock()) {
+            reverb.Init(sampleRate);  // clears the delay lines, keeps the settings
+        }
+    }
+
+    // Waveform selection
+    static const int NUM_WAVEFORMS = 4;
+    static uint8_t waveform(int index) {
+        static const uint8_t WAVEFORMS[NUM_WAVEFORMS] = {
+            WavetableOsc::WAVE_SAW,
+            WavetableOsc::WAVE_SQUARE,
+            WavetableOsc::WAVE_TRI,
+            WavetableOsc::WAVE_SIN
+        };
+        return WAVEFORMS[index];
+    }
+
+    // Control parameters with knobs
+    struct Controls {
+        Knob attackKnob;
+        Knob releaseKnob;
+        Knob cutoffKnob;
+        Knob resonanceKnob;
+        Knob reverbFeedbackKnob;
+        Knob reverbMixKnob;
+
+        void Init() {
+            attackKnob.Init(0.005f, 0.001f, 1.0f);
+            releaseKnob.Init(0.15f, 0.1f, 1.0f);
+            cutoffKnob.Init(2000.0f, 200.0f, 10000.0f);
+            resonanceKnob.Init(0.4f, 0.1f, 0.95f);
+            reverbFeedbackKnob.Init(0.7f, 0.4f, 0.95f);  // Higher default and min feedback
+            reverbMixKnob.Init(0.4f, 0.1f, 0.9f);  // Higher default mix and range
+        }
+
+        void ResetMode(Mode mode) {
+            switch(mode) {
+                case MODE_AD:
+                    attackKnob.Reset();
+                    releaseKnob.Reset();
+                    break;
+                case MODE_FILTER:
+                    cutoffKnob.Reset();
+                    resonanceKnob.Reset();
+                    break;
+                case MODE_REVERB:
+                    reverbFeedbackKnob.Reset();
+                    reverbMixKnob.Reset();
+                    break;
+                default:
+                    break;
+            }
+        }
+    };
+
+    float sampleRate = 48000.0f;
+    // The knobs' values (what a snapshot saves); applied[] holds what the
+    // voices, filter and reverb run with after modulation.
+    float attackTime = 0.005f;  // Voice::Init()'s envelope times
+    float releaseTime = 0.35f;
+    daisysp::Svf filter;
+    float filterFreq = 200.0f;
+    float filterRes = 0.4f;
+    ModMatrix<NUM_MOD_SOURCES, NUM_MOD_DESTINATIONS, 2> modulation;
+    float applied[NUM_MOD_DESTINATIONS];
+    int lfoRoute = -1;
+    int envelopeRoute = -1;
+    ControlLfo lfo;
+    ControlEnvelope filterEnvelope;
+    float modWheel = 0.0f;
+    float envelopeAmount = 0.0f;
+    SimpleReverb reverb;
+    MeterTap meters[NUM_METERS];
+    Controls controls;
+    Mode currentMode = MODE_DEFAULT;
+    int currentWaveform = 0;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_SYNTH_ENGINE_H
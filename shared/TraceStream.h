@@ -0,0 +1,347 @@
+#pragma once
+#ifndef DAISYBED_TRACE_STREAM_H
+#define DAISYBED_TRACE_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "MeterTap.h"
+#include "SpscQueue.h"
+
+// Capture is compiled in only when the firmware is configured with
+// -DDAISYBED_TRACE=ON (see shared/cmake/daisybed.cmake); otherwise every
+// recorder call folds away.
+#ifndef DAISYBED_TRACE
+#define DAISYBED_TRACE 0
+#endif
+
+namespace daisybed
+{
+// Compact timestamped stream of everything an audio callback consumes, so a
+// host harness can feed the exact same inputs back into the same engine code.
+//
+// The stream is a flat sequence of 12-byte little-endian records. Time is the
+// audio block index; replay applies every record for block N before rendering
+// block N. A kHeader record always comes first, and is sent again about once
+// a second along with every knob reading and the level, so a reader that
+// attaches late can start from there (see TraceRecorder::SyncDue()).
+enum class TraceKind : uint8_t
+{
+    kHeader   = 1, // id: TraceFirmware, aux: block size, value: sample rate
+    kMidi     = 2, // value: status | data0 << 8 | data1 << 16
+    kKnob     = 3, // id: knob / ADC index, value: float bits (sent on change)
+    kEncoder  = 4, // value: int32 increment
+    kButton   = 5, // id: button index, value: 1 on a rising edge
+    kGate     = 6, // aux: sample offset in the block, value: 1 rising, 0 falling
+    kLevel    = 7, // value: LoadGovernor level in effect for the block
+    kConfig   = 8, // id: firmware-defined setting, value: float bits
+    kOverflow = 9, // value: records dropped since the last one that got through
+    // Output of the engine's MeterTaps, ~20 times a second (not replayed):
+    kMeterPeak = 10, // id: meter, aux: clips (saturating), value: peak float bits
+    kMeterRms  = 11, // id: meter, aux: faults (saturating), value: rms float bits
+};
+
+enum class TraceFirmware : uint8_t
+{
+    kBasicMonosynth  = 1,
+    kCinematicVerb   = 2,
+    kAwfulParaphonic = 3,
+};
+
+struct TraceRecord
+{
+    uint32_t block;
+    uint8_t  kind;
+    uint8_t  id;
+    uint16_t aux;
+    uint32_t value;
+
+    inline TraceKind Kind() const { return static_cast<TraceKind>(kind); }
+    inline float     AsFloat() const
+    {
+        float f;
+        memcpy(&f, &value, sizeof(f));
+        return f;
+    }
+};
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord must stay 12 bytes");
+
+// Device side. The audio callback records into a lock-free queue; the main
+// loop drains it through whatever transport the firmware has (USB CDC).
+//
+// Without DAISYBED_TRACE the recorder has no storage and every call is
+// empty, so a production build carries none of its ~12 KB.
+class TraceRecorder
+{
+  public:
+    static constexpr bool   kEnabled  = DAISYBED_TRACE != 0;
+    static constexpr size_t kMaxKnobs = 16;
+
+#if DAISYBED_TRACE
+    void Init(TraceFirmware firmware, float sample_rate, size_t block_size)
+    {
+        firmware_    = firmware;
+        sample_rate_ = sample_rate;
+        block_size_  = block_size;
+        block_       = 0;
+        dropped_     = 0;
+        tx_len_      = 0;
+        last_level_  = 0; // replay starts at level 0 too
+        meter_period_
+            = block_size ? (uint32_t)(sample_rate / (kMeterRate * block_size)) : 1;
+        if(meter_period_ == 0)
+            meter_period_ = 1;
+        sync_period_ = meter_period_ * (uint32_t)kMeterRate;
+        sync_due_    = false;
+        ForgetKnobs();
+        PutHeader();
+    }
+
+    // Audio callback: call once at the very top, before recording anything
+    // for this block. About once a second this re-sends the header and makes
+    // the next Knob() and Level() calls send their values even if unchanged.
+    inline void BeginBlock(uint32_t block)
+    {
+        block_    = block;
+        sync_due_ = block != 0 && block % sync_period_ == 0;
+        if(sync_due_)
+        {
+            PutHeader();
+            ForgetKnobs();
+            last_level_ = -1;
+        }
+    }
+
+    // True on the blocks that re-sent the header. A firmware traces its
+    // kConfig settings again on these, so a late reader gets them too.
+    inline bool SyncDue() const { return sync_due_; }
+#else
+    inline void Init(TraceFirmware, float, size_t) {}
+    inline void BeginBlock(uint32_t) {}
+    inline bool SyncDue() const { return false; }
+#endif
+
+#if DAISYBED_TRACE
+    inline void Midi(uint8_t status, uint8_t data0, uint8_t data1)
+    {
+        Put(TraceKind::kMidi,
+            0,
+            0,
+            status | (uint32_t)data0 << 8 | (uint32_t)data1 << 16);
+    }
+    inline void Knob(uint8_t index, float value)
+    {
+        uint32_t bits = FloatBits(value);
+        if(index >= kMaxKnobs || bits == last_knob_[index])
+            return;
+        last_knob_[index] = bits;
+        Put(TraceKind::kKnob, index, 0, bits);
+    }
+    inline void Encoder(int32_t increment)
+    {
+        if(increment != 0)
+            Put(TraceKind::kEncoder, 0, 0, (uint32_t)increment);
+    }
+    inline void Button(uint8_t index, bool rising_edge)
+    {
+        if(rising_edge)
+            Put(TraceKind::kButton, index, 0, 1);
+    }
+    inline void Gate(size_t offset, bool rising)
+    {
+        Put(TraceKind::kGate, 0, (uint16_t)offset, rising ? 1 : 0);
+    }
+    inline void Level(int level)
+    {
+        if(level != last_level_)
+        {
+            last_level_ = level;
+            Put(TraceKind::kLevel, 0, 0, (uint32_t)level);
+        }
+    }
+    inline void Config(uint8_t id, float value)
+    {
+        Put(TraceKind::kConfig, id, 0, FloatBits(value));
+    }
+
+    // True on the blocks whose meter readings should be sent, so the caller
+    // only Read()s its taps (restarting their peaks) when they go out.
+    inline bool MeterDue() const { return block_ % meter_period_ == 0; }
+    inline void Meter(uint8_t index, const MeterReading &reading)
+    {
+        Put(TraceKind::kMeterPeak, index, Saturate16(reading.clips), FloatBits(reading.peak));
+        Put(TraceKind::kMeterRms, index, Saturate16(reading.faults), FloatBits(reading.rms));
+    }
+
+    // Main loop: moves queued records out through `write(const uint8_t *,
+    // size_t) -> bool`. A chunk the transport refuses is retried next call.
+    template <typename Writer>
+    void Drain(Writer &&write)
+    {
+        while(true)
+        {
+            TraceRecord record;
+            while(tx_len_ + sizeof(record) <= kTxBytes && queue_.Pop(record))
+            {
+                memcpy(tx_ + tx_len_, &record, sizeof(record));
+                tx_len_ += sizeof(record);
+            }
+            if(tx_len_ == 0 || !write(tx_, tx_len_))
+                return;
+            tx_len_ = 0;
+        }
+    }
+
+  private:
+    static constexpr size_t kQueueSize = 1024;
+    static constexpr size_t kTxBytes   = 32 * sizeof(TraceRecord);
+    static constexpr float  kMeterRate = 20.f; // meter readings per second
+
+    static inline uint16_t Saturate16(uint32_t count)
+    {
+        return count > 0xFFFFu ? 0xFFFFu : (uint16_t)count;
+    }
+
+    static inline uint32_t FloatBits(float f)
+    {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    inline void PutHeader()
+    {
+        Put(TraceKind::kHeader,
+            static_cast<uint8_t>(firmware_),
+            (uint16_t)block_size_,
+            FloatBits(sample_rate_));
+    }
+
+    inline void ForgetKnobs()
+    {
+        for(size_t i = 0; i < kMaxKnobs; i++)
+            last_knob_[i] = 0xFFFFFFFFu; // NaN pattern: next reading always sent
+    }
+
+    inline void Put(TraceKind kind, uint8_t id, uint16_t aux, uint32_t value)
+    {
+        if(dropped_ != 0)
+        {
+            TraceRecord overflow
+                = {block_, static_cast<uint8_t>(TraceKind::kOverflow), 0, 0, dropped_};
+            if(!queue_.Push(overflow))
+            {
+                dropped_++;
+                return;
+            }
+            dropped_ = 0;
+        }
+        TraceRecord record = {block_, static_cast<uint8_t>(kind), id, aux, value};
+        if(!queue_.Push(record))
+            dropped_++;
+    }
+
+    SpscQueue<TraceRecord, kQueueSize> queue_;
+    TraceFirmware                      firmware_;
+    float                              sample_rate_  = 0.f;
+    size_t                             block_size_   = 0;
+    uint32_t                           block_        = 0;
+    uint32_t                           dropped_      = 0;
+    uint32_t                           meter_period_ = 1;
+    uint32_t                           sync_period_  = 1;
+    bool                               sync_due_     = false;
+    uint32_t                           last_knob_[kMaxKnobs];
+    int                                last_level_ = 0;
+    uint8_t                            tx_[kTxBytes];
+    size_t                             tx_len_ = 0;
+};
+#else
+    inline void Midi(uint8_t, uint8_t, uint8_t) {}
+    inline void Knob(uint8_t, float) {}
+    inline void Encoder(int32_t) {}
+    inline void Button(uint8_t, bool) {}
+    inline void Gate(size_t, bool) {}
+    inline void Level(int) {}
+    inline void Config(uint8_t, float) {}
+    inline bool MeterDue() const { return false; }
+    inline void Meter(uint8_t, const MeterReading &) {}
+    template <typename Writer>
+    inline void Drain(Writer &&)
+    {
+    }
+};
+#endif
+
+// Host side: walks a captured stream held in memory.
+class TraceReader
+{
+  public:
+    // Starts at the first header record, skipping whatever a late reader
+    // caught before it. Returns false if there is none.
+    bool Init(const uint8_t *data, size_t size)
+    {
+        data_  = data;
+        count_ = size / sizeof(TraceRecord);
+        next_  = 0;
+        TraceRecord header;
+        while(Peek(header) && header.Kind() != TraceKind::kHeader)
+            next_++;
+        if(next_ >= count_)
+            return false;
+        firmware_    = static_cast<TraceFirmware>(header.id);
+        block_size_  = header.aux;
+        sample_rate_ = header.AsFloat();
+        first_block_ = header.block;
+        next_++;
+        return true;
+    }
+
+    // Block the stream starts at: 0 for a capture from boot, otherwise that
+    // of the resync a late reader started from. Only a capture from boot
+    // replays bit-exactly; one from a resync starts from the engine's
+    // defaults plus the re-sent knobs and settings, not its real state.
+    inline uint32_t GetFirstBlock() const { return first_block_; }
+
+    inline TraceFirmware GetFirmware() const { return firmware_; }
+    inline size_t        GetBlockSize() const { return block_size_; }
+    inline float         GetSampleRate() const { return sample_rate_; }
+
+    // Block index of the last record, i.e. how many blocks a replay needs.
+    uint32_t GetLastBlock() const
+    {
+        if(count_ == 0)
+            return 0;
+        TraceRecord last;
+        memcpy(&last, data_ + (count_ - 1) * sizeof(last), sizeof(last));
+        return last.block;
+    }
+
+    // Next record belonging to `block`; false once the block is exhausted.
+    bool NextInBlock(uint32_t block, TraceRecord &record)
+    {
+        if(!Peek(record) || record.block > block)
+            return false;
+        next_++;
+        return true;
+    }
+
+  private:
+    bool Peek(TraceRecord &record) const
+    {
+        if(next_ >= count_)
+            return false;
+        memcpy(&record, data_ + next_ * sizeof(record), sizeof(record));
+        return true;
+    }
+
+    const uint8_t *data_  = nullptr;
+    size_t         count_ = 0, next_ = 0;
+    TraceFirmware  firmware_;
+    size_t         block_size_  = 0;
+    float          sample_rate_ = 0.f;
+    uint32_t       first_block_ = 0;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_TRACE_STREAM_H
@@ -1,8 +1,6 @@
-#include "daisy_pod.h"
 #include "Voice.h"
 #include "daisysp.h"
 
-using namespace daisy;
 using namespace daisysp;
 
 Voice::Voice() : 
@@ -26,12 +24,13 @@ void Voice::Init(float sampleRate) {
     env.SetCurve(0);                       // Linear curve
     
     // Set initial waveform
-    osc.SetWaveform(Oscillator::WAVE_POLYBLEP_SAW);
+    osc.SetWaveform(daisybed::WavetableOsc::WAVE_SAW);
 }
 
 void Voice::SetNote(int note, float vel) {
     midiNote = note;
     active = true;
+    releasing = false;  // retriggered mid-release: held again, not shed first
     velocity = vel;
     age = 0;
     osc.SetFreq(mtof(note));
@@ -44,11 +43,14 @@ void Voice::Release() {
 }
 
 void Voice::Clear() {
+    active = false;
     releasing = false;
     midiNote = -1;
 }
 
 bool Voice::IsActive() const { return active || releasing; }
+bool Voice::IsReleasing() const { return releasing; }
+float Voice::GetLevel() const { return env.GetValue(); }
 int Voice::GetNote() const { return midiNote; }
 uint32_t Voice::GetAge() const { return age; }
 void Voice::IncrementAge() { age++; }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #pragma once
 
-#include "daisy_pod.h"
+#include <stdint.h>
 #include "daisysp.h"
+#include "WavetableOsc.h"
 
-using namespace daisy;
 using namespace daisysp;
 
 class Voice {
@@ -14,11 +14,13 @@ public:
     void Release();
     void Clear();
     bool IsActive() const;
+    bool IsReleasing() const;
+    float GetLevel() const;
     int GetNote() const;
     uint32_t GetAge() const;
     void IncrementAge();
 
-    Oscillator osc;
+    daisybed::WavetableOsc osc;   // band-limited tables, see WavetableData.cpp
     AdEnv env;
 
 private:
@@ -0,0 +1,182 @@
+#pragma once
+#ifndef DAISYBED_VOICE_BANK_H
+#define DAISYBED_VOICE_BANK_H
+
+#include "Voice.h"
+
+namespace daisybed
+{
+// Fixed pool of Voices with note allocation and oldest-voice stealing.
+//
+// The voice limit is the ceiling on simultaneously sounding voices. It
+// defaults to the full pool; lowering it (e.g. from a LoadGovernor) sheds the
+// quietest releasing voices first, and idle voices cost nothing in Process().
+template <int NumVoices>
+class VoiceBank {
+public:
+    void Init(float sampleRate) {
+        for(int v = 0; v < NumVoices; v++) {
+            voices[v].Init(sampleRate);
+        }
+        limit = NumVoices;
+    }
+
+    void NoteOn(int note, float velocity) {
+        int voice = findAvailableVoice(note);
+        if(voice == -1) return; // Note is already playing
+
+        voices[voice].SetNote(note, velocity);
+
+        // Increment age of other voices
+        for(int i = 0; i < NumVoices; i++) {
+            if(i != voice && voices[i].IsActive()) {
+                voices[i].IncrementAge();
+            }
+        }
+    }
+
+    void NoteOff(int note) {
+        for(int i = 0; i < NumVoices; i++) {
+            if(voices[i].GetNote() == note && voices[i].IsActive()) {
+                voices[i].Release();
+            }
+        }
+    }
+
+    // Sum of all sounding voices for one sample, unscaled.
+    float Process() {
+        float signal = 0.0f;
+        for(int v = 0; v < NumVoices; v++) {
+            if(!voices[v].IsActive()) continue;
+
+            float envValue = voices[v].env.Process();
+            signal += voices[v].osc.Process() * envValue;
+
+            // The AD envelope finishes on its own whether or not the key is
+            // still held; free the voice once it has.
+            if(!voices[v].env.IsRunning()) {
+                voices[v].Clear();
+            }
+        }
+        return signal;
+    }
+
+    // Block-at-a-time variant of Process() for voices [first, last), added
+    // into `out`. Voice-major, so each voice's state stays in registers for
+    // the whole block, and disjoint voice ranges can be rendered from
+    // different threads.
+    void ProcessVoices(int first, int last, float *out, size_t size) {
+        for(int v = first; v < last; v++) {
+            if(!voices[v].IsActive()) continue;
+
+            for(size_t i = 0; i < size; i++) {
+                float envValue = voices[v].env.Process();
+                out[i] += voices[v].osc.Process() * envValue;
+            }
+            if(!voices[v].env.IsRunning()) {
+                voices[v].Clear();
+            }
+        }
+    }
+
+    void SetWaveform(uint8_t waveform) {
+        for(int v = 0; v < NumVoices; v++) {
+            voices[v].osc.SetWaveform(waveform);
+        }
+    }
+    void SetAttack(float seconds) {
+        for(int v = 0; v < NumVoices; v++) {
+            voices[v].env.SetTime(ADENV_SEG_ATTACK, seconds);
+        }
+    }
+    void SetDecay(float seconds) {
+        for(int v = 0; v < NumVoices; v++) {
+            voices[v].env.SetTime(ADENV_SEG_DECAY, seconds);
+        }
+    }
+
+    // Clamp the number of sounding voices, shedding the excess immediately.
+    void SetVoiceLimit(int newLimit) {
+        limit = newLimit < 1 ? 1 : (newLimit > NumVoices ? NumVoices : newLimit);
+        while(GetActiveCount() > limit) {
+            voices[findQuietestVoice()].Clear();
+        }
+    }
+    int GetVoiceLimit() const { return limit; }
+
+    int GetActiveCount() const {
+        int count = 0;
+        for(int v = 0; v < NumVoices; v++) {
+            if(voices[v].IsActive()) count++;
+        }
+        return count;
+    }
+
+    Voice voices[NumVoices];
+
+private:
+    // Find oldest sounding voice to steal
+    int findOldestVoice() const {
+        int oldestIdx = -1;
+        uint32_t oldestAge = 0;
+
+        for(int i = 0; i < NumVoices; i++) {
+            if(voices[i].IsActive() && (oldestIdx < 0 || voices[i].GetAge() > oldestAge)) {
+                oldestAge = voices[i].GetAge();
+                oldestIdx = i;
+            }
+        }
+        return oldestIdx < 0 ? 0 : oldestIdx;
+    }
+
+    // Releasing voices are shed before held ones; within each group the one
+    // with the lowest envelope level goes first.
+    int findQuietestVoice() const {
+        int quietestIdx = -1;
+        for(int i = 0; i < NumVoices; i++) {
+            if(!voices[i].IsActive()) continue;
+            if(quietestIdx < 0) {
+                quietestIdx = i;
+                continue;
+            }
+            const Voice &best = voices[quietestIdx];
+            if(voices[i].IsReleasing() != best.IsReleasing()) {
+                if(voices[i].IsReleasing()) quietestIdx = i;
+            } else if(voices[i].GetLevel() < best.GetLevel()) {
+                quietestIdx = i;
+            }
+        }
+        return quietestIdx < 0 ? 0 : quietestIdx;
+    }
+
+    // Find available voice or steal if needed
+    int findAvailableVoice(int noteNumber) const {
+        // First, check if this note is already playing (prevent retriggering)
+        for(int i = 0; i < NumVoices; i++) {
+            if(voices[i].GetNote() == noteNumber && voices[i].IsActive()) {
+                return -1;
+            }
+        }
+
+        // At the ceiling: steal rather than waking another voice
+        if(GetActiveCount() >= limit) {
+            return findOldestVoice();
+        }
+
+        // Then, look for an inactive voice
+        for(int i = 0; i < NumVoices; i++) {
+            if(!voices[i].IsActive()) {
+                return i;
+            }
+        }
+
+        // If all voices are active, steal the oldest one
+        return findOldestVoice();
+    }
+
+    int limit = NumVoices;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_VOICE_BANK_H
@@ -0,0 +1,1121 @@
+// Generated by host/src/wavetable-gen.cpp; do not edit. Rewrite it with
+// `cmake --build host/build --target wavetables`.
+//
+// 512-sample int16 tables plus a guard sample each: 12825 samples,
+// 25650 bytes of flash.
+
+#include "WavetableOsc.h"
+
+namespace daisybed
+{
+const WavetableShape kWavetableShapes[WavetableOsc::WAVE_LAST] = {
+    {0, 8}, // saw
+    {4104, 8}, // square
+    {8208, 8}, // triangle
+    {12312, 1}, // sine
+};
+
+const int16_t kWavetableData[12825] = {
+    // saw, level 0: harmonics 1..255
+    0, 109, 217, 327, 435, 546, 652, 764, 870, 982, 1087, 1201,
+    1305, 1419, 1522, 1637, 1739, 1855, 1957, 2074, 2174, 2292, 2392, 2510,
+    2609, 2729, 2827, 2947, 3044, 3165, 3261, 3383, 3479, 3602, 3696, 3820,
+    3914, 4038, 4131, 4257, 4348, 4475, 4566, 4693, 4783, 4912, 5001, 5130,
+    5218, 5348, 5435, 5566, 5653, 5785, 5870, 6003, 6087, 6221, 6305, 6440,
+    6522, 6658, 6740, 6876, 6957, 7095, 7174, 7313, 7392, 7532, 7609, 7750,
+    7826, 7968, 8044, 8187, 8261, 8405, 8478, 8623, 8696, 8842, 8913, 9060,
+    9130, 9279, 9347, 9497, 9565, 9716, 9782, 9934, 9999, 10152, 10217, 10371,
+    10434, 10589, 10651, 10808, 10868, 11026, 11085, 11245, 11303, 11463, 11520, 11682,
+    11737, 11900, 11954, 12119, 12171, 12337, 12388, 12556, 12606, 12775, 12823, 12993,
+    13040, 13212, 13257, 13431, 13474, 13649, 13691, 13868, 13908, 14087, 14125, 14305,
+    14342, 14524, 14559, 14743, 14776, 14962, 14993, 15180, 15209, 15399, 15426, 15618,
+    15643, 15837, 15860, 16056, 16077, 16275, 16293, 16494, 16510, 16713, 16727, 16932,
+    16943, 17151, 17160, 17370, 17376, 17590, 17593, 17809, 17809, 18028, 18025, 18248,
+    18242, 18467, 18458, 18687, 18674, 18906, 18890, 19126, 19106, 19346, 19322, 19566,
+    19538, 19786, 19754, 20006, 19969, 20226, 20185, 20446, 20400, 20667, 20615, 20887,
+    20830, 21108, 21045, 21329, 21260, 21550, 21474, 21771, 21688, 21993, 21902, 22215,
+    22116, 22437, 22329, 22660, 22542, 22882, 22755, 23106, 22967, 23330, 23179, 23554,
+    23390, 23779, 23600, 24005, 23809, 24232, 24018, 24459, 24225, 24688, 24431, 24919,
+    24635, 25151, 24838, 25386, 25037, 25624, 25234, 25865, 25426, 26111, 25612, 26364,
+    25791, 26627, 25958, 26902, 26109, 27199, 26233, 27530, 26310, 27926, 26295, 28462,
+    26054, 29404, 24958, 32767, 0, -32767, -24958, -29404, -26054, -28462, -26295, -27926,
+    -26310, -27530, -26233, -27199, -26109, -26902, -25958, -26627, -25791, -26364, -25612, -26111,
+    -25426, -25865, -25234, -25624, -25037, -25386, -24838, -25151, -24635, -24919, -24431, -24688,
+    -24225, -24459, -24018, -24232, -23809, -24005, -23600, -23779, -23390, -23554, -23179, -23330,
+    -22967, -23106, -22755, -22882, -22542, -22660, -22329, -22437, -22116, -22215, -21902, -21993,
+    -21688, -21771, -21474, -21550, -21260, -21329, -21045, -21108, -20830, -20887, -20615, -20667,
+    -20400, -20446, -20185, -20226, -19969, -20006, -19754, -19786, -19538, -19566, -19322, -19346,
+    -19106, -19126, -18890, -18906, -18674, -18687, -18458, -18467, -18242, -18248, -18025, -18028,
+    -17809, -17809, -17593, -17590, -17376, -17370, -17160, -17151, -16943, -16932, -16727, -16713,
+    -16510, -16494, -16293, -16275, -16077, -16056, -15860, -15837, -15643, -15618, -15426, -15399,
+    -15209, -15180, -14993, -14962, -14776, -14743, -14559, -14524, -14342, -14305, -14125, -14087,
+    -13908, -13868, -13691, -13649, -13474, -13431, -13257, -13212, -13040, -12993, -12823, -12775,
+    -12606, -12556, -12388, -12337, -12171, -12119, -11954, -11900, -11737, -11682, -11520, -11463,
+    -11303, -11245, -11085, -11026, -10868, -10808, -10651, -10589, -10434, -10371, -10217, -10152,
+    -9999, -9934, -9782, -9716, -9565, -9497, -9347, -9279, -9130, -9060, -8913, -8842,
+    -8696, -8623, -8478, -8405, -8261, -8187, -8044, -7968, -7826, -7750, -7609, -7532,
+    -7392, -7313, -7174, -7095, -6957, -6876, -6740, -6658, -6522, -6440, -6305, -6221,
+    -6087, -6003, -5870, -5785, -5653, -5566, -5435, -5348, -5218, -5130, -5001, -4912,
+    -4783, -4693, -4566, -4475, -4348, -4257, -4131, -4038, -3914, -3820, -3696, -3602,
+    -3479, -3383, -3261, -3165, -3044, -2947, -2827, -2729, -2609, -2510, -2392, -2292,
+    -2174, -2074, -1957, -1855, -1739, -1637, -1522, -1419, -1305, -1201, -1087, -982,
+    -870, -764, -652, -546, -435, -327, -217, -109, 0,
+    // saw, level 1: harmonics 1..127
+    0, 179, 219, 257, 434, 614, 656, 693, 868, 1050, 1094, 1129,
+    1302, 1486, 1531, 1564, 1736, 1921, 1968, 2000, 2170, 2357, 2406, 2436,
+    2604, 2793, 2843, 2871, 3038, 3228, 3281, 3307, 3472, 3664, 3718, 3743,
+    3906, 4100, 4156, 4178, 4340, 4536, 4593, 4614, 4774, 4971, 5031, 5050,
+    5207, 5407, 5468, 5486, 5641, 5843, 5906, 5921, 6075, 6278, 6343, 6357,
+    6509, 6714, 6781, 6793, 6943, 7150, 7219, 7228, 7376, 7586, 7657, 7664,
+    7810, 8021, 8094, 8100, 8243, 8457, 8532, 8535, 8677, 8893, 8970, 8971,
+    9111, 9328, 9408, 9407, 9544, 9764, 9846, 9843, 9977, 10200, 10284, 10278,
+    10411, 10636, 10722, 10714, 10844, 11071, 11161, 11150, 11277, 11507, 11599, 11585,
+    11710, 11943, 12037, 12021, 12143, 12378, 12476, 12457, 12576, 12814, 12915, 12892,
+    13008, 13250, 13353, 13328, 13441, 13686, 13792, 13764, 13873, 14121, 14231, 14199,
+    14305, 14557, 14671, 14635, 14737, 14993, 15110, 15071, 15169, 15429, 15550, 15506,
+    15601, 15864, 15990, 15942, 16032, 16300, 16430, 16378, 16463, 16736, 16871, 16813,
+    16894, 17172, 17311, 17249, 17324, 17607, 17753, 17685, 17754, 18043, 18194, 18120,
+    18184, 18479, 18636, 18556, 18613, 18915, 19079, 18992, 19041, 19351, 19523, 19427,
+    19469, 19786, 19967, 19863, 19896, 20222, 20412, 20298, 20322, 20658, 20858, 20734,
+    20746, 21094, 21305, 21169, 21170, 21530, 21754, 21605, 21592, 21966, 22205, 22040,
+    22011, 22402, 22658, 22475, 22428, 22838, 23114, 22910, 22842, 23275, 23573, 23345,
+    23251, 23711, 24038, 23780, 23655, 24148, 24509, 24215, 24051, 24585, 24989, 24648,
+    24436, 25023, 25484, 25081, 24804, 25463, 25998, 25512, 25145, 25905, 26548, 25939,
+    25440, 26352, 27162, 26358, 25643, 26815, 27916, 26749, 25619, 27333, 29076, 27005,
+    24740, 28295, 32658, 24156, 0, -24156, -32658, -28295, -24740, -27005, -29076, -27333,
+    -25619, -26749, -27916, -26815, -25643, -26358, -27162, -26352, -25440, -25939, -26548, -25905,
+    -25145, -25512, -25998, -25463, -24804, -25081, -25484, -25023, -24436, -24648, -24989, -24585,
+    -24051, -24215, -24509, -24148, -23655, -23780, -24038, -23711, -23251, -23345, -23573, -23275,
+    -22842, -22910, -23114, -22838, -22428, -22475, -22658, -22402, -22011, -22040, -22205, -21966,
+    -21592, -21605, -21754, -21530, -21170, -21169, -21305, -21094, -20746, -20734, -20858, -20658,
+    -20322, -20298, -20412, -20222, -19896, -19863, -19967, -19786, -19469, -19427, -19523, -19351,
+    -19041, -18992, -19079, -18915, -18613, -18556, -18636, -18479, -18184, -18120, -18194, -18043,
+    -17754, -17685, -17753, -17607, -17324, -17249, -17311, -17172, -16894, -16813, -16871, -16736,
+    -16463, -16378, -16430, -16300, -16032, -15942, -15990, -15864, -15601, -15506, -15550, -15429,
+    -15169, -15071, -15110, -14993, -14737, -14635, -14671, -14557, -14305, -14199, -14231, -14121,
+    -13873, -13764, -13792, -13686, -13441, -13328, -13353, -13250, -13008, -12892, -12915, -12814,
+    -12576, -12457, -12476, -12378, -12143, -12021, -12037, -11943, -11710, -11585, -11599, -11507,
+    -11277, -11150, -11161, -11071, -10844, -10714, -10722, -10636, -10411, -10278, -10284, -10200,
+    -9977, -9843, -9846, -9764, -9544, -9407, -9408, -9328, -9111, -8971, -8970, -8893,
+    -8677, -8535, -8532, -8457, -8243, -8100, -8094, -8021, -7810, -7664, -7657, -7586,
+    -7376, -7228, -7219, -7150, -6943, -6793, -6781, -6714, -6509, -6357, -6343, -6278,
+    -6075, -5921, -5906, -5843, -5641, -5486, -5468, -5407, -5207, -5050, -5031, -4971,
+    -4774, -4614, -4593, -4536, -4340, -4178, -4156, -4100, -3906, -3743, -3718, -3664,
+    -3472, -3307, -3281, -3228, -3038, -2871, -2843, -2793, -2604, -2436, -2406, -2357,
+    -2170, -2000, -1968, -1921, -1736, -1564, -1531, -1486, -1302, -1129, -1094, -1050,
+    -868, -693, -656, -614, -434, -257, -219, -179, 0,
+    // saw, level 2: harmonics 1..63
+    0, 207, 358, 427, 439, 449, 514, 659, 865, 1074, 1229, 1304,
+    1317, 1325, 1385, 1526, 1729, 1940, 2100, 2180, 2196, 2201, 2257, 2393,
+    2594, 2807, 2972, 3056, 3074, 3078, 3128, 3259, 3458, 3673, 3843, 3933,
+    3952, 3954, 3999, 4125, 4322, 4540, 4715, 4809, 4831, 4831, 4871, 4992,
+    5186, 5406, 5586, 5686, 5710, 5707, 5742, 5858, 6050, 6272, 6458, 6563,
+    6589, 6584, 6613, 6723, 6914, 7138, 7329, 7440, 7468, 7461, 7485, 7589,
+    7777, 8004, 8201, 8317, 8348, 8338, 8356, 8454, 8640, 8869, 9072, 9195,
+    9228, 9216, 9228, 9320, 9502, 9734, 9944, 10073, 10109, 10094, 10099, 10184,
+    10364, 10599, 10815, 10951, 10990, 10972, 10970, 11048, 11225, 11463, 11687, 11830,
+    11872, 11851, 11841, 11912, 12086, 12327, 12558, 12709, 12755, 12731, 12713, 12775,
+    12945, 13190, 13430, 13590, 13639, 13611, 13584, 13637, 13804, 14052, 14301, 14471,
+    14524, 14492, 14455, 14498, 14661, 14913, 15173, 15353, 15410, 15374, 15326, 15359,
+    15516, 15773, 16045, 16236, 16299, 16257, 16197, 16217, 16370, 16632, 16916, 17121,
+    17189, 17142, 17068, 17074, 17221, 17489, 17788, 18008, 18083, 18029, 17939, 17928,
+    18068, 18344, 18660, 18898, 18980, 18918, 18810, 18780, 18912, 19195, 19533, 19791,
+    19882, 19811, 19680, 19627, 19749, 20043, 20405, 20689, 20791, 20709, 20550, 20469,
+    20579, 20885, 21278, 21594, 21709, 21613, 21420, 21303, 21398, 21720, 22152, 22508,
+    22640, 22526, 22288, 22125, 22200, 22543, 23027, 23437, 23593, 23454, 23155, 22928,
+    22976, 23348, 23905, 24391, 24580, 24406, 24018, 23697, 23704, 24120, 24788, 25392,
+    25631, 25402, 24872, 24401, 24341, 24830, 25686, 26493, 26822, 26492, 25699, 24940,
+    24751, 25388, 26640, 27887, 28420, 27848, 26391, 24864, 24306, 25415, 28038, 31004,
+    32439, 30459, 23977, 13266, 0, -13266, -23977, -30459, -32439, -31004, -28038, -25415,
+    -24306, -24864, -26391, -27848, -28420, -27887, -26640, -25388, -24751, -24940, -25699, -26492,
+    -26822, -26493, -25686, -24830, -24341, -24401, -24872, -25402, -25631, -25392, -24788, -24120,
+    -23704, -23697, -24018, -24406, -24580, -24391, -23905, -23348, -22976, -22928, -23155, -23454,
+    -23593, -23437, -23027, -22543, -22200, -22125, -22288, -22526, -22640, -22508, -22152, -21720,
+    -21398, -21303, -21420, -21613, -21709, -21594, -21278, -20885, -20579, -20469, -20550, -20709,
+    -20791, -20689, -20405, -20043, -19749, -19627, -19680, -19811, -19882, -19791, -19533, -19195,
+    -18912, -18780, -18810, -18918, -18980, -18898, -18660, -18344, -18068, -17928, -17939, -18029,
+    -18083, -18008, -17788, -17489, -17221, -17074, -17068, -17142, -17189, -17121, -16916, -16632,
+    -16370, -16217, -16197, -16257, -16299, -16236, -16045, -15773, -15516, -15359, -15326, -15374,
+    -15410, -15353, -15173, -14913, -14661, -14498, -14455, -14492, -14524, -14471, -14301, -14052,
+    -13804, -13637, -13584, -13611, -13639, -13590, -13430, -13190, -12945, -12775, -12713, -12731,
+    -12755, -12709, -12558, -12327, -12086, -11912, -11841, -11851, -11872, -11830, -11687, -11463,
+    -11225, -11048, -10970, -10972, -10990, -10951, -10815, -10599, -10364, -10184, -10099, -10094,
+    -10109, -10073, -9944, -9734, -9502, -9320, -9228, -9216, -9228, -9195, -9072, -8869,
+    -8640, -8454, -8356, -8338, -8348, -8317, -8201, -8004, -7777, -7589, -7485, -7461,
+    -7468, -7440, -7329, -7138, -6914, -6723, -6613, -6584, -6589, -6563, -6458, -6272,
+    -6050, -5858, -5742, -5707, -5710, -5686, -5586, -5406, -5186, -4992, -4871, -4831,
+    -4831, -4809, -4715, -4540, -4322, -4125, -3999, -3954, -3952, -3933, -3843, -3673,
+    -3458, -3259, -3128, -3078, -3074, -3056, -2972, -2807, -2594, -2393, -2257, -2201,
+    -2196, -2180, -2100, -1940, -1729, -1526, -1385, -1325, -1317, -1304, -1229, -1074,
+    -865, -659, -514, -449, -439, -427, -358, -207, 0,
+    // saw, level 3: harmonics 1..31
+    0, 215, 415, 585, 717, 808, 860, 881, 885, 887, 902, 945,
+    1025, 1147, 1309, 1502, 1716, 1933, 2138, 2317, 2460, 2562, 2622, 2650,
+    2655, 2655, 2664, 2698, 2768, 2879, 3032, 3220, 3430, 3650, 3861, 4050,
+    4203, 4315, 4385, 4419, 4426, 4424, 4427, 4452, 4511, 4611, 4754, 4936,
+    5144, 5366, 5584, 5782, 5946, 6070, 6149, 6189, 6199, 6194, 6191, 6206,
+    6253, 6342, 6475, 6650, 6856, 7080, 7305, 7513, 7690, 7825, 7914, 7961,
+    7974, 7966, 7956, 7961, 7996, 8072, 8195, 8362, 8566, 8792, 9024, 9243,
+    9433, 9581, 9682, 9736, 9752, 9742, 9724, 9717, 9738, 9800, 9911, 10071,
+    10272, 10501, 10741, 10972, 11176, 11340, 11453, 11516, 11534, 11521, 11494, 11474,
+    11480, 11526, 11624, 11774, 11972, 12205, 12454, 12699, 12920, 13100, 13228, 13301,
+    13322, 13306, 13269, 13234, 13221, 13250, 13331, 13471, 13665, 13902, 14162, 14424,
+    14665, 14865, 15010, 15094, 15120, 15099, 15050, 14997, 14962, 14968, 15031, 15158,
+    15348, 15589, 15862, 16145, 16410, 16635, 16801, 16899, 16930, 16904, 16841, 16764,
+    16702, 16680, 16719, 16830, 17014, 17261, 17551, 17860, 18156, 18413, 18607, 18724,
+    18762, 18729, 18645, 18538, 18440, 18382, 18388, 18477, 18653, 18908, 19222, 19566,
+    19905, 20206, 20437, 20580, 20627, 20585, 20474, 20324, 20175, 20063, 20024, 20082,
+    20246, 20513, 20861, 21257, 21660, 22026, 22314, 22496, 22557, 22500, 22346, 22130,
+    21900, 21706, 21594, 21601, 21747, 22033, 22437, 22920, 23430, 23906, 24291, 24541,
+    24627, 24544, 24312, 23977, 23599, 23249, 23000, 22911, 23022, 23345, 23862, 24523,
+    25254, 25965, 26562, 26962, 27103, 26959, 26544, 25914, 25162, 24409, 23790, 23432,
+    23442, 23880, 24756, 26011, 27524, 29114, 30555, 31600, 32000, 31534, 30031, 27397,
+    23620, 18783, 13059, 6697, 0, -6697, -13059, -18783, -23620, -27397, -30031, -31534,
+    -32000, -31600, -30555, -29114, -27524, -26011, -24756, -23880, -23442, -23432, -23790, -24409,
+    -25162, -25914, -26544, -26959, -27103, -26962, -26562, -25965, -25254, -24523, -23862, -23345,
+    -23022, -22911, -23000, -23249, -23599, -23977, -24312, -24544, -24627, -24541, -24291, -23906,
+    -23430, -22920, -22437, -22033, -21747, -21601, -21594, -21706, -21900, -22130, -22346, -22500,
+    -22557, -22496, -22314, -22026, -21660, -21257, -20861, -20513, -20246, -20082, -20024, -20063,
+    -20175, -20324, -20474, -20585, -20627, -20580, -20437, -20206, -19905, -19566, -19222, -18908,
+    -18653, -18477, -18388, -18382, -18440, -18538, -18645, -18729, -18762, -18724, -18607, -18413,
+    -18156, -17860, -17551, -17261, -17014, -16830, -16719, -16680, -16702, -16764, -16841, -16904,
+    -16930, -16899, -16801, -16635, -16410, -16145, -15862, -15589, -15348, -15158, -15031, -14968,
+    -14962, -14997, -15050, -15099, -15120, -15094, -15010, -14865, -14665, -14424, -14162, -13902,
+    -13665, -13471, -13331, -13250, -13221, -13234, -13269, -13306, -13322, -13301, -13228, -13100,
+    -12920, -12699, -12454, -12205, -11972, -11774, -11624, -11526, -11480, -11474, -11494, -11521,
+    -11534, -11516, -11453, -11340, -11176, -10972, -10741, -10501, -10272, -10071, -9911, -9800,
+    -9738, -9717, -9724, -9742, -9752, -9736, -9682, -9581, -9433, -9243, -9024, -8792,
+    -8566, -8362, -8195, -8072, -7996, -7961, -7956, -7966, -7974, -7961, -7914, -7825,
+    -7690, -7513, -7305, -7080, -6856, -6650, -6475, -6342, -6253, -6206, -6191, -6194,
+    -6199, -6189, -6149, -6070, -5946, -5782, -5584, -5366, -5144, -4936, -4754, -4611,
+    -4511, -4452, -4427, -4424, -4426, -4419, -4385, -4315, -4203, -4050, -3861, -3650,
+    -3430, -3220, -3032, -2879, -2768, -2698, -2664, -2655, -2655, -2650, -2622, -2562,
+    -2460, -2317, -2138, -1933, -1716, -1502, -1309, -1147, -1025, -945, -902, -887,
+    -885, -881, -860, -808, -717, -585, -415, -215, 0,
+    // saw, level 4: harmonics 1..15
+    0, 217, 430, 636, 831, 1011, 1174, 1319, 1444, 1547, 1631, 1695,
+    1741, 1771, 1788, 1796, 1797, 1797, 1798, 1806, 1822, 1851, 1896, 1959,
+    2042, 2145, 2269, 2414, 2577, 2758, 2953, 3160, 3376, 3595, 3814, 4030,
+    4239, 4436, 4618, 4784, 4930, 5056, 5160, 5244, 5307, 5351, 5378, 5393,
+    5396, 5394, 5389, 5385, 5388, 5400, 5425, 5466, 5526, 5606, 5708, 5832,
+    5978, 6144, 6329, 6529, 6742, 6964, 7190, 7417, 7640, 7856, 8060, 8248,
+    8419, 8568, 8696, 8801, 8883, 8943, 8982, 9004, 9010, 9005, 8992, 8977,
+    8963, 8955, 8957, 8973, 9007, 9062, 9138, 9239, 9364, 9513, 9685, 9877,
+    10087, 10312, 10546, 10786, 11028, 11265, 11494, 11710, 11910, 12089, 12245, 12376,
+    12481, 12560, 12614, 12644, 12654, 12645, 12624, 12593, 12559, 12526, 12499, 12484,
+    12485, 12506, 12550, 12621, 12719, 12846, 13001, 13183, 13390, 13618, 13863, 14121,
+    14386, 14653, 14915, 15169, 15407, 15625, 15820, 15986, 16123, 16228, 16302, 16345,
+    16358, 16346, 16311, 16260, 16197, 16128, 16061, 16001, 15954, 15926, 15924, 15951,
+    16010, 16104, 16235, 16402, 16603, 16836, 17098, 17382, 17683, 17995, 18309, 18620,
+    18919, 19199, 19454, 19677, 19864, 20012, 20117, 20180, 20200, 20181, 20125, 20039,
+    19927, 19799, 19662, 19524, 19395, 19284, 19199, 19148, 19138, 19174, 19261, 19400,
+    19591, 19834, 20126, 20460, 20830, 21228, 21644, 22067, 22486, 22890, 23267, 23606,
+    23898, 24134, 24307, 24412, 24448, 24413, 24310, 24144, 23922, 23654, 23353, 23030,
+    22702, 22384, 22092, 21843, 21652, 21533, 21500, 21561, 21726, 21998, 22378, 22863,
+    23447, 24119, 24864, 25664, 26499, 27342, 28169, 28949, 29653, 30251, 30714, 31010,
+    31115, 31003, 30652, 30046, 29171, 28020, 26588, 24880, 22902, 20669, 18198, 15514,
+    12645, 9622, 6482, 3261, 0, -3261, -6482, -9622, -12645, -15514, -18198, -20669,
+    -22902, -24880, -26588, -28020, -29171, -30046, -30652, -31003, -31115, -31010, -30714, -30251,
+    -29653, -28949, -28169, -27342, -26499, -25664, -24864, -24119, -23447, -22863, -22378, -21998,
+    -21726, -21561, -21500, -21533, -21652, -21843, -22092, -22384, -22702, -23030, -23353, -23654,
+    -23922, -24144, -24310, -24413, -24448, -24412, -24307, -24134, -23898, -23606, -23267, -22890,
+    -22486, -22067, -21644, -21228, -20830, -20460, -20126, -19834, -19591, -19400, -19261, -19174,
+    -19138, -19148, -19199, -19284, -19395, -19524, -19662, -19799, -19927, -20039, -20125, -20181,
+    -20200, -20180, -20117, -20012, -19864, -19677, -19454, -19199, -18919, -18620, -18309, -17995,
+    -17683, -17382, -17098, -16836, -16603, -16402, -16235, -16104, -16010, -15951, -15924, -15926,
+    -15954, -16001, -16061, -16128, -16197, -16260, -16311, -16346, -16358, -16345, -16302, -16228,
+    -16123, -15986, -15820, -15625, -15407, -15169, -14915, -14653, -14386, -14121, -13863, -13618,
+    -13390, -13183, -13001, -12846, -12719, -12621, -12550, -12506, -12485, -12484, -12499, -12526,
+    -12559, -12593, -12624, -12645, -12654, -12644, -12614, -12560, -12481, -12376, -12245, -12089,
+    -11910, -11710, -11494, -11265, -11028, -10786, -10546, -10312, -10087, -9877, -9685, -9513,
+    -9364, -9239, -9138, -9062, -9007, -8973, -8957, -8955, -8963, -8977, -8992, -9005,
+    -9010, -9004, -8982, -8943, -8883, -8801, -8696, -8568, -8419, -8248, -8060, -7856,
+    -7640, -7417, -7190, -6964, -6742, -6529, -6329, -6144, -5978, -5832, -5708, -5606,
+    -5526, -5466, -5425, -5400, -5388, -5385, -5389, -5394, -5396, -5393, -5378, -5351,
+    -5307, -5244, -5160, -5056, -4930, -4784, -4618, -4436, -4239, -4030, -3814, -3595,
+    -3376, -3160, -2953, -2758, -2577, -2414, -2269, -2145, -2042, -1959, -1896, -1851,
+    -1822, -1806, -1798, -1797, -1797, -1796, -1788, -1771, -1741, -1695, -1631, -1547,
+    -1444, -1319, -1174, -1011, -831, -636, -430, -217, 0,
+    // saw, level 5: harmonics 1..7
+    0, 218, 434, 649, 862, 1070, 1275, 1474, 1666, 1853, 2032, 2203,
+    2365, 2518, 2663, 2797, 2922, 3036, 3141, 3236, 3320, 3395, 3460, 3516,
+    3564, 3603, 3635, 3660, 3678, 3691, 3699, 3703, 3705, 3704, 3702, 3699,
+    3697, 3697, 3700, 3706, 3716, 3731, 3752, 3780, 3816, 3859, 3912, 3973,
+    4044, 4125, 4216, 4318, 4430, 4552, 4685, 4829, 4982, 5145, 5318, 5499,
+    5689, 5886, 6090, 6300, 6516, 6736, 6959, 7185, 7413, 7641, 7869, 8095,
+    8319, 8539, 8756, 8966, 9171, 9369, 9558, 9740, 9912, 10074, 10225, 10367,
+    10496, 10615, 10722, 10817, 10901, 10974, 11035, 11085, 11125, 11155, 11175, 11187,
+    11190, 11187, 11177, 11162, 11143, 11120, 11096, 11070, 11044, 11020, 10998, 10979,
+    10965, 10957, 10956, 10962, 10977, 11001, 11036, 11082, 11140, 11210, 11293, 11389,
+    11498, 11621, 11757, 11907, 12071, 12247, 12436, 12637, 12849, 13072, 13305, 13547,
+    13797, 14053, 14316, 14582, 14852, 15124, 15396, 15667, 15936, 16201, 16461, 16715,
+    16961, 17198, 17424, 17640, 17842, 18032, 18207, 18366, 18510, 18638, 18748, 18842,
+    18918, 18977, 19018, 19043, 19051, 19043, 19020, 18982, 18931, 18868, 18793, 18708,
+    18616, 18516, 18411, 18302, 18192, 18082, 17974, 17870, 17772, 17681, 17600, 17530,
+    17474, 17432, 17407, 17400, 17413, 17447, 17503, 17582, 17685, 17813, 17967, 18146,
+    18351, 18581, 18838, 19119, 19425, 19754, 20105, 20478, 20870, 21280, 21705, 22144,
+    22595, 23054, 23519, 23988, 24457, 24923, 25383, 25834, 26272, 26695, 27097, 27477,
+    27831, 28155, 28446, 28700, 28915, 29087, 29213, 29291, 29318, 29290, 29207, 29066,
+    28864, 28601, 28275, 27885, 27431, 26911, 26325, 25674, 24958, 24177, 23332, 22426,
+    21459, 20433, 19350, 18213, 17024, 15786, 14503, 13178, 11814, 10415, 8986, 7530,
+    6051, 4554, 3044, 1524, 0, -1524, -3044, -4554, -6051, -7530, -8986, -10415,
+    -11814, -13178, -14503, -15786, -17024, -18213, -19350, -20433, -21459, -22426, -23332, -24177,
+    -24958, -25674, -26325, -26911, -27431, -27885, -28275, -28601, -28864, -29066, -29207, -29290,
+    -29318, -29291, -29213, -29087, -28915, -28700, -28446, -28155, -27831, -27477, -27097, -26695,
+    -26272, -25834, -25383, -24923, -24457, -23988, -23519, -23054, -22595, -22144, -21705, -21280,
+    -20870, -20478, -20105, -19754, -19425, -19119, -18838, -18581, -18351, -18146, -17967, -17813,
+    -17685, -17582, -17503, -17447, -17413, -17400, -17407, -17432, -17474, -17530, -17600, -17681,
+    -17772, -17870, -17974, -18082, -18192, -18302, -18411, -18516, -18616, -18708, -18793, -18868,
+    -18931, -18982, -19020, -19043, -19051, -19043, -19018, -18977, -18918, -18842, -18748, -18638,
+    -18510, -18366, -18207, -18032, -17842, -17640, -17424, -17198, -16961, -16715, -16461, -16201,
+    -15936, -15667, -15396, -15124, -14852, -14582, -14316, -14053, -13797, -13547, -13305, -13072,
+    -12849, -12637, -12436, -12247, -12071, -11907, -11757, -11621, -11498, -11389, -11293, -11210,
+    -11140, -11082, -11036, -11001, -10977, -10962, -10956, -10957, -10965, -10979, -10998, -11020,
+    -11044, -11070, -11096, -11120, -11143, -11162, -11177, -11187, -11190, -11187, -11175, -11155,
+    -11125, -11085, -11035, -10974, -10901, -10817, -10722, -10615, -10496, -10367, -10225, -10074,
+    -9912, -9740, -9558, -9369, -9171, -8966, -8756, -8539, -8319, -8095, -7869, -7641,
+    -7413, -7185, -6959, -6736, -6516, -6300, -6090, -5886, -5689, -5499, -5318, -5145,
+    -4982, -4829, -4685, -4552, -4430, -4318, -4216, -4125, -4044, -3973, -3912, -3859,
+    -3816, -3780, -3752, -3731, -3716, -3706, -3700, -3697, -3697, -3699, -3702, -3704,
+    -3705, -3703, -3699, -3691, -3678, -3660, -3635, -3603, -3564, -3516, -3460, -3395,
+    -3320, -3236, -3141, -3036, -2922, -2797, -2663, -2518, -2365, -2203, -2032, -1853,
+    -1666, -1474, -1275, -1070, -862, -649, -434, -218, 0,
+    // saw, level 6: harmonics 1..3
+    0, 218, 435, 653, 869, 1085, 1300, 1514, 1726, 1937, 2146, 2353,
+    2558, 2761, 2961, 3159, 3354, 3546, 3735, 3921, 4103, 4282, 4457, 4629,
+    4796, 4960, 5119, 5274, 5425, 5572, 5714, 5851, 5984, 6112, 6236, 6355,
+    6469, 6578, 6683, 6782, 6877, 6967, 7052, 7133, 7209, 7280, 7346, 7408,
+    7466, 7519, 7568, 7612, 7653, 7689, 7721, 7750, 7775, 7796, 7815, 7829,
+    7841, 7850, 7856, 7860, 7861, 7860, 7857, 7852, 7845, 7837, 7828, 7818,
+    7807, 7795, 7783, 7771, 7758, 7746, 7735, 7724, 7714, 7706, 7698, 7693,
+    7689, 7687, 7687, 7690, 7696, 7704, 7716, 7730, 7749, 7771, 7796, 7826,
+    7860, 7898, 7941, 7989, 8041, 8099, 8161, 8229, 8303, 8381, 8466, 8556,
+    8652, 8753, 8861, 8975, 9094, 9220, 9352, 9490, 9634, 9785, 9941, 10104,
+    10272, 10447, 10628, 10815, 11007, 11206, 11410, 11620, 11835, 12055, 12281, 12512,
+    12747, 12988, 13233, 13482, 13736, 13993, 14255, 14519, 14787, 15059, 15332, 15609,
+    15888, 16168, 16451, 16735, 17020, 17306, 17592, 17879, 18165, 18451, 18736, 19021,
+    19303, 19584, 19863, 20139, 20413, 20683, 20950, 21213, 21471, 21725, 21974, 22218,
+    22456, 22688, 22914, 23133, 23345, 23550, 23746, 23935, 24115, 24287, 24449, 24603,
+    24746, 24880, 25003, 25116, 25218, 25308, 25388, 25456, 25512, 25556, 25588, 25607,
+    25613, 25607, 25587, 25554, 25508, 25448, 25375, 25287, 25186, 25071, 24942, 24798,
+    24640, 24468, 24282, 24082, 23867, 23638, 23394, 23137, 22865, 22579, 22279, 21965,
+    21637, 21296, 20941, 20573, 20191, 19797, 19389, 18969, 18537, 18092, 17635, 17167,
+    16687, 16196, 15694, 15182, 14659, 14126, 13584, 13032, 12471, 11902, 11325, 10740,
+    10148, 9548, 8942, 8330, 7711, 7088, 6459, 5826, 5189, 4549, 3905, 3258,
+    2609, 1959, 1307, 653, 0, -653, -1307, -1959, -2609, -3258, -3905, -4549,
+    -5189, -5826, -6459, -7088, -7711, -8330, -8942, -9548, -10148, -10740, -11325, -11902,
+    -12471, -13032, -13584, -14126, -14659, -15182, -15694, -16196, -16687, -17167, -17635, -18092,
+    -18537, -18969, -19389, -19797, -20191, -20573, -20941, -21296, -21637, -21965, -22279, -22579,
+    -22865, -23137, -23394, -23638, -23867, -24082, -24282, -24468, -24640, -24798, -24942, -25071,
+    -25186, -25287, -25375, -25448, -25508, -25554, -25587, -25607, -25613, -25607, -25588, -25556,
+    -25512, -25456, -25388, -25308, -25218, -25116, -25003, -24880, -24746, -24603, -24449, -24287,
+    -24115, -23935, -23746, -23550, -23345, -23133, -22914, -22688, -22456, -22218, -21974, -21725,
+    -21471, -21213, -20950, -20683, -20413, -20139, -19863, -19584, -19303, -19021, -18736, -18451,
+    -18165, -17879, -17592, -17306, -17020, -16735, -16451, -16168, -15888, -15609, -15332, -15059,
+    -14787, -14519, -14255, -13993, -13736, -13482, -13233, -12988, -12747, -12512, -12281, -12055,
+    -11835, -11620, -11410, -11206, -11007, -10815, -10628, -10447, -10272, -10104, -9941, -9785,
+    -9634, -9490, -9352, -9220, -9094, -8975, -8861, -8753, -8652, -8556, -8466, -8381,
+    -8303, -8229, -8161, -8099, -8041, -7989, -7941, -7898, -7860, -7826, -7796, -7771,
+    -7749, -7730, -7716, -7704, -7696, -7690, -7687, -7687, -7689, -7693, -7698, -7706,
+    -7714, -7724, -7735, -7746, -7758, -7771, -7783, -7795, -7807, -7818, -7828, -7837,
+    -7845, -7852, -7857, -7860, -7861, -7860, -7856, -7850, -7841, -7829, -7815, -7796,
+    -7775, -7750, -7721, -7689, -7653, -7612, -7568, -7519, -7466, -7408, -7346, -7280,
+    -7209, -7133, -7052, -6967, -6877, -6782, -6683, -6578, -6469, -6355, -6236, -6112,
+    -5984, -5851, -5714, -5572, -5425, -5274, -5119, -4960, -4796, -4629, -4457, -4282,
+    -4103, -3921, -3735, -3546, -3354, -3159, -2961, -2761, -2558, -2353, -2146, -1937,
+    -1726, -1514, -1300, -1085, -869, -653, -435, -218, 0,
+    // saw, level 7: harmonics 1..1
+    0, 218, 436, 653, 871, 1089, 1306, 1523, 1740, 1957, 2173, 2389,
+    2605, 2820, 3035, 3249, 3463, 3677, 3890, 4102, 4313, 4524, 4735, 4944,
+    5153, 5361, 5569, 5775, 5981, 6185, 6389, 6592, 6793, 6994, 7194, 7393,
+    7590, 7786, 7982, 8176, 8368, 8560, 8750, 8939, 9126, 9313, 9497, 9681,
+    9863, 10043, 10222, 10399, 10575, 10749, 10922, 11093, 11262, 11429, 11595, 11759,
+    11922, 12082, 12241, 12398, 12553, 12706, 12857, 13006, 13154, 13299, 13442, 13583,
+    13723, 13860, 13995, 14128, 14259, 14387, 14514, 14638, 14760, 14880, 14998, 15113,
+    15227, 15337, 15446, 15552, 15656, 15758, 15857, 15953, 16048, 16140, 16229, 16316,
+    16401, 16483, 16563, 16640, 16714, 16787, 16856, 16923, 16988, 17050, 17109, 17166,
+    17220, 17272, 17321, 17367, 17411, 17452, 17491, 17527, 17560, 17591, 17619, 17644,
+    17667, 17687, 17704, 17719, 17731, 17740, 17747, 17751, 17752, 17751, 17747, 17740,
+    17731, 17719, 17704, 17687, 17667, 17644, 17619, 17591, 17560, 17527, 17491, 17452,
+    17411, 17367, 17321, 17272, 17220, 17166, 17109, 17050, 16988, 16923, 16856, 16787,
+    16714, 16640, 16563, 16483, 16401, 16316, 16229, 16140, 16048, 15953, 15857, 15758,
+    15656, 15552, 15446, 15337, 15227, 15113, 14998, 14880, 14760, 14638, 14514, 14387,
+    14259, 14128, 13995, 13860, 13723, 13583, 13442, 13299, 13154, 13006, 12857, 12706,
+    12553, 12398, 12241, 12082, 11922, 11759, 11595, 11429, 11262, 11093, 10922, 10749,
+    10575, 10399, 10222, 10043, 9863, 9681, 9497, 9313, 9126, 8939, 8750, 8560,
+    8368, 8176, 7982, 7786, 7590, 7393, 7194, 6994, 6793, 6592, 6389, 6185,
+    5981, 5775, 5569, 5361, 5153, 4944, 4735, 4524, 4313, 4102, 3890, 3677,
+    3463, 3249, 3035, 2820, 2605, 2389, 2173, 1957, 1740, 1523, 1306, 1089,
+    871, 653, 436, 218, 0, -218, -436, -653, -871, -1089, -1306, -1523,
+    -1740, -1957, -2173, -2389, -2605, -2820, -3035, -3249, -3463, -3677, -3890, -4102,
+    -4313, -4524, -4735, -4944, -5153, -5361, -5569, -5775, -5981, -6185, -6389, -6592,
+    -6793, -6994, -7194, -7393, -7590, -7786, -7982, -8176, -8368, -8560, -8750, -8939,
+    -9126, -9313, -9497, -9681, -9863, -10043, -10222, -10399, -10575, -10749, -10922, -11093,
+    -11262, -11429, -11595, -11759, -11922, -12082, -12241, -12398, -12553, -12706, -12857, -13006,
+    -13154, -13299, -13442, -13583, -13723, -13860, -13995, -14128, -14259, -14387, -14514, -14638,
+    -14760, -14880, -14998, -15113, -15227, -15337, -15446, -15552, -15656, -15758, -15857, -15953,
+    -16048, -16140, -16229, -16316, -16401, -16483, -16563, -16640, -16714, -16787, -16856, -16923,
+    -16988, -17050, -17109, -17166, -17220, -17272, -17321, -17367, -17411, -17452, -17491, -17527,
+    -17560, -17591, -17619, -17644, -17667, -17687, -17704, -17719, -17731, -17740, -17747, -17751,
+    -17752, -17751, -17747, -17740, -17731, -17719, -17704, -17687, -17667, -17644, -17619, -17591,
+    -17560, -17527, -17491, -17452, -17411, -17367, -17321, -17272, -17220, -17166, -17109, -17050,
+    -16988, -16923, -16856, -16787, -16714, -16640, -16563, -16483, -16401, -16316, -16229, -16140,
+    -16048, -15953, -15857, -15758, -15656, -15552, -15446, -15337, -15227, -15113, -14998, -14880,
+    -14760, -14638, -14514, -14387, -14259, -14128, -13995, -13860, -13723, -13583, -13442, -13299,
+    -13154, -13006, -12857, -12706, -12553, -12398, -12241, -12082, -11922, -11759, -11595, -11429,
+    -11262, -11093, -10922, -10749, -10575, -10399, -10222, -10043, -9863, -9681, -9497, -9313,
+    -9126, -8939, -8750, -8560, -8368, -8176, -7982, -7786, -7590, -7393, -7194, -6994,
+    -6793, -6592, -6389, -6185, -5981, -5775, -5569, -5361, -5153, -4944, -4735, -4524,
+    -4313, -4102, -3890, -3677, -3463, -3249, -3035, -2820, -2605, -2389, -2173, -1957,
+    -1740, -1523, -1306, -1089, -871, -653, -436, -218, 0,
+    // square, level 0: harmonics 1..255
+    0, 30341, 23234, 27439, 24446, 26771, 24870, 26478, 25084, 26314, 25213, 26210,
+    25300, 26138, 25361, 26084, 25407, 26044, 25443, 26012, 25472, 25986, 25495, 25965,
+    25515, 25947, 25531, 25932, 25545, 25919, 25557, 25907, 25568, 25898, 25577, 25889,
+    25585, 25881, 25593, 25874, 25599, 25868, 25605, 25862, 25611, 25857, 25616, 25852,
+    25620, 25848, 25624, 25844, 25628, 25841, 25631, 25838, 25634, 25835, 25637, 25832,
+    25640, 25829, 25642, 25827, 25645, 25825, 25647, 25822, 25649, 25821, 25651, 25819,
+    25652, 25817, 25654, 25816, 25655, 25814, 25657, 25813, 25658, 25811, 25659, 25810,
+    25661, 25809, 25662, 25808, 25663, 25807, 25663, 25806, 25664, 25806, 25665, 25805,
+    25666, 25804, 25667, 25803, 25667, 25803, 25668, 25802, 25668, 25802, 25669, 25801,
+    25669, 25801, 25670, 25801, 25670, 25800, 25670, 25800, 25670, 25800, 25671, 25800,
+    25671, 25799, 25671, 25799, 25671, 25799, 25671, 25799, 25671, 25799, 25671, 25799,
+    25671, 25799, 25671, 25799, 25671, 25800, 25671, 25800, 25670, 25800, 25670, 25800,
+    25670, 25801, 25670, 25801, 25669, 25801, 25669, 25802, 25668, 25802, 25668, 25803,
+    25667, 25803, 25667, 25804, 25666, 25805, 25665, 25806, 25664, 25806, 25663, 25807,
+    25663, 25808, 25662, 25809, 25661, 25810, 25659, 25811, 25658, 25813, 25657, 25814,
+    25655, 25816, 25654, 25817, 25652, 25819, 25651, 25821, 25649, 25822, 25647, 25825,
+    25645, 25827, 25642, 25829, 25640, 25832, 25637, 25835, 25634, 25838, 25631, 25841,
+    25628, 25844, 25624, 25848, 25620, 25852, 25616, 25857, 25611, 25862, 25605, 25868,
+    25599, 25874, 25593, 25881, 25585, 25889, 25577, 25898, 25568, 25907, 25557, 25919,
+    25545, 25932, 25531, 25947, 25515, 25965, 25495, 25986, 25472, 26012, 25443, 26044,
+    25407, 26084, 25361, 26138, 25300, 26210, 25213, 26314, 25084, 26478, 24870, 26771,
+    24446, 27439, 23234, 30341, 0, -30341, -23234, -27439, -24446, -26771, -24870, -26478,
+    -25084, -26314, -25213, -26210, -25300, -26138, -25361, -26084, -25407, -26044, -25443, -26012,
+    -25472, -25986, -25495, -25965, -25515, -25947, -25531, -25932, -25545, -25919, -25557, -25907,
+    -25568, -25898, -25577, -25889, -25585, -25881, -25593, -25874, -25599, -25868, -25605, -25862,
+    -25611, -25857, -25616, -25852, -25620, -25848, -25624, -25844, -25628, -25841, -25631, -25838,
+    -25634, -25835, -25637, -25832, -25640, -25829, -25642, -25827, -25645, -25825, -25647, -25822,
+    -25649, -25821, -25651, -25819, -25652, -25817, -25654, -25816, -25655, -25814, -25657, -25813,
+    -25658, -25811, -25659, -25810, -25661, -25809, -25662, -25808, -25663, -25807, -25663, -25806,
+    -25664, -25806, -25665, -25805, -25666, -25804, -25667, -25803, -25667, -25803, -25668, -25802,
+    -25668, -25802, -25669, -25801, -25669, -25801, -25670, -25801, -25670, -25800, -25670, -25800,
+    -25670, -25800, -25671, -25800, -25671, -25799, -25671, -25799, -25671, -25799, -25671, -25799,
+    -25671, -25799, -25671, -25799, -25671, -25799, -25671, -25799, -25671, -25800, -25671, -25800,
+    -25670, -25800, -25670, -25800, -25670, -25801, -25670, -25801, -25669, -25801, -25669, -25802,
+    -25668, -25802, -25668, -25803, -25667, -25803, -25667, -25804, -25666, -25805, -25665, -25806,
+    -25664, -25806, -25663, -25807, -25663, -25808, -25662, -25809, -25661, -25810, -25659, -25811,
+    -25658, -25813, -25657, -25814, -25655, -25816, -25654, -25817, -25652, -25819, -25651, -25821,
+    -25649, -25822, -25647, -25825, -25645, -25827, -25642, -25829, -25640, -25832, -25637, -25835,
+    -25634, -25838, -25631, -25841, -25628, -25844, -25624, -25848, -25620, -25852, -25616, -25857,
+    -25611, -25862, -25605, -25868, -25599, -25874, -25593, -25881, -25585, -25889, -25577, -25898,
+    -25568, -25907, -25557, -25919, -25545, -25932, -25531, -25947, -25515, -25965, -25495, -25986,
+    -25472, -26012, -25443, -26044, -25407, -26084, -25361, -26138, -25300, -26210, -25213, -26314,
+    -25084, -26478, -24870, -26771, -24446, -27439, -23234, -30341, 0,
+    // square, level 1: harmonics 1..127
+    0, 22458, 30342, 26351, 23233, 25490, 27440, 25865, 24445, 25656, 26773, 25789,
+    24868, 25697, 26481, 25764, 25081, 25713, 26318, 25753, 25209, 25720, 26214, 25747,
+    25295, 25725, 26143, 25744, 25356, 25727, 26090, 25742, 25401, 25729, 26051, 25740,
+    25436, 25730, 26020, 25739, 25464, 25731, 25995, 25739, 25486, 25732, 25974, 25738,
+    25505, 25733, 25957, 25738, 25520, 25733, 25943, 25737, 25533, 25733, 25931, 25737,
+    25545, 25734, 25921, 25737, 25554, 25734, 25912, 25736, 25562, 25734, 25904, 25736,
+    25570, 25734, 25897, 25736, 25576, 25734, 25892, 25736, 25581, 25734, 25887, 25736,
+    25586, 25734, 25882, 25736, 25590, 25735, 25878, 25736, 25594, 25735, 25875, 25736,
+    25597, 25735, 25872, 25736, 25599, 25735, 25870, 25735, 25601, 25735, 25868, 25735,
+    25603, 25735, 25866, 25735, 25605, 25735, 25865, 25735, 25606, 25735, 25864, 25735,
+    25607, 25735, 25863, 25735, 25607, 25735, 25863, 25735, 25607, 25735, 25863, 25735,
+    25607, 25735, 25863, 25735, 25607, 25735, 25864, 25735, 25606, 25735, 25865, 25735,
+    25605, 25735, 25866, 25735, 25603, 25735, 25868, 25735, 25601, 25735, 25870, 25735,
+    25599, 25736, 25872, 25735, 25597, 25736, 25875, 25735, 25594, 25736, 25878, 25735,
+    25590, 25736, 25882, 25734, 25586, 25736, 25887, 25734, 25581, 25736, 25892, 25734,
+    25576, 25736, 25897, 25734, 25570, 25736, 25904, 25734, 25562, 25736, 25912, 25734,
+    25554, 25737, 25921, 25734, 25545, 25737, 25931, 25733, 25533, 25737, 25943, 25733,
+    25520, 25738, 25957, 25733, 25505, 25738, 25974, 25732, 25486, 25739, 25995, 25731,
+    25464, 25739, 26020, 25730, 25436, 25740, 26051, 25729, 25401, 25742, 26090, 25727,
+    25356, 25744, 26143, 25725, 25295, 25747, 26214, 25720, 25209, 25753, 26318, 25713,
+    25081, 25764, 26481, 25697, 24868, 25789, 26773, 25656, 24445, 25865, 27440, 25490,
+    23233, 26351, 30342, 22458, 0, -22458, -30342, -26351, -23233, -25490, -27440, -25865,
+    -24445, -25656, -26773, -25789, -24868, -25697, -26481, -25764, -25081, -25713, -26318, -25753,
+    -25209, -25720, -26214, -25747, -25295, -25725, -26143, -25744, -25356, -25727, -26090, -25742,
+    -25401, -25729, -26051, -25740, -25436, -25730, -26020, -25739, -25464, -25731, -25995, -25739,
+    -25486, -25732, -25974, -25738, -25505, -25733, -25957, -25738, -25520, -25733, -25943, -25737,
+    -25533, -25733, -25931, -25737, -25545, -25734, -25921, -25737, -25554, -25734, -25912, -25736,
+    -25562, -25734, -25904, -25736, -25570, -25734, -25897, -25736, -25576, -25734, -25892, -25736,
+    -25581, -25734, -25887, -25736, -25586, -25734, -25882, -25736, -25590, -25735, -25878, -25736,
+    -25594, -25735, -25875, -25736, -25597, -25735, -25872, -25736, -25599, -25735, -25870, -25735,
+    -25601, -25735, -25868, -25735, -25603, -25735, -25866, -25735, -25605, -25735, -25865, -25735,
+    -25606, -25735, -25864, -25735, -25607, -25735, -25863, -25735, -25607, -25735, -25863, -25735,
+    -25607, -25735, -25863, -25735, -25607, -25735, -25863, -25735, -25607, -25735, -25864, -25735,
+    -25606, -25735, -25865, -25735, -25605, -25735, -25866, -25735, -25603, -25735, -25868, -25735,
+    -25601, -25735, -25870, -25735, -25599, -25736, -25872, -25735, -25597, -25736, -25875, -25735,
+    -25594, -25736, -25878, -25735, -25590, -25736, -25882, -25734, -25586, -25736, -25887, -25734,
+    -25581, -25736, -25892, -25734, -25576, -25736, -25897, -25734, -25570, -25736, -25904, -25734,
+    -25562, -25736, -25912, -25734, -25554, -25737, -25921, -25734, -25545, -25737, -25931, -25733,
+    -25533, -25737, -25943, -25733, -25520, -25738, -25957, -25733, -25505, -25738, -25974, -25732,
+    -25486, -25739, -25995, -25731, -25464, -25739, -26020, -25730, -25436, -25740, -26051, -25729,
+    -25401, -25742, -26090, -25727, -25356, -25744, -26143, -25725, -25295, -25747, -26214, -25720,
+    -25209, -25753, -26318, -25713, -25081, -25764, -26481, -25697, -24868, -25789, -26773, -25656,
+    -24445, -25865, -27440, -25490, -23233, -26351, -30342, -22458, 0,
+    // square, level 2: harmonics 1..63
+    0, 12435, 22459, 28505, 30343, 29028, 26350, 24064, 23230, 23938, 25491, 26904,
+    27445, 26960, 25864, 24839, 24438, 24808, 25656, 26462, 26781, 26482, 25788, 25123,
+    24858, 25110, 25697, 26264, 26492, 26274, 25764, 25268, 25068, 25260, 25713, 26154,
+    26332, 26160, 25753, 25355, 25193, 25350, 25721, 26084, 26232, 26088, 25747, 25412,
+    25275, 25408, 25725, 26037, 26164, 26040, 25743, 25451, 25332, 25449, 25728, 26003,
+    26116, 26005, 25741, 25480, 25373, 25479, 25730, 25978, 26080, 25980, 25740, 25502,
+    25404, 25501, 25731, 25960, 26054, 25961, 25739, 25518, 25427, 25517, 25732, 25946,
+    26033, 25946, 25738, 25530, 25445, 25530, 25733, 25935, 26018, 25936, 25737, 25540,
+    25458, 25539, 25733, 25927, 26007, 25928, 25737, 25546, 25468, 25546, 25734, 25922,
+    25999, 25922, 25736, 25551, 25474, 25551, 25734, 25918, 25994, 25918, 25736, 25553,
+    25478, 25553, 25735, 25916, 25991, 25916, 25735, 25554, 25479, 25554, 25735, 25916,
+    25991, 25916, 25735, 25553, 25478, 25553, 25736, 25918, 25994, 25918, 25734, 25551,
+    25474, 25551, 25736, 25922, 25999, 25922, 25734, 25546, 25468, 25546, 25737, 25928,
+    26007, 25927, 25733, 25539, 25458, 25540, 25737, 25936, 26018, 25935, 25733, 25530,
+    25445, 25530, 25738, 25946, 26033, 25946, 25732, 25517, 25427, 25518, 25739, 25961,
+    26054, 25960, 25731, 25501, 25404, 25502, 25740, 25980, 26080, 25978, 25730, 25479,
+    25373, 25480, 25741, 26005, 26116, 26003, 25728, 25449, 25332, 25451, 25743, 26040,
+    26164, 26037, 25725, 25408, 25275, 25412, 25747, 26088, 26232, 26084, 25721, 25350,
+    25193, 25355, 25753, 26160, 26332, 26154, 25713, 25260, 25068, 25268, 25764, 26274,
+    26492, 26264, 25697, 25110, 24858, 25123, 25788, 26482, 26781, 26462, 25656, 24808,
+    24438, 24839, 25864, 26960, 27445, 26904, 25491, 23938, 23230, 24064, 26350, 29028,
+    30343, 28505, 22459, 12435, 0, -12435, -22459, -28505, -30343, -29028, -26350, -24064,
+    -23230, -23938, -25491, -26904, -27445, -26960, -25864, -24839, -24438, -24808, -25656, -26462,
+    -26781, -26482, -25788, -25123, -24858, -25110, -25697, -26264, -26492, -26274, -25764, -25268,
+    -25068, -25260, -25713, -26154, -26332, -26160, -25753, -25355, -25193, -25350, -25721, -26084,
+    -26232, -26088, -25747, -25412, -25275, -25408, -25725, -26037, -26164, -26040, -25743, -25451,
+    -25332, -25449, -25728, -26003, -26116, -26005, -25741, -25480, -25373, -25479, -25730, -25978,
+    -26080, -25980, -25740, -25502, -25404, -25501, -25731, -25960, -26054, -25961, -25739, -25518,
+    -25427, -25517, -25732, -25946, -26033, -25946, -25738, -25530, -25445, -25530, -25733, -25935,
+    -26018, -25936, -25737, -25540, -25458, -25539, -25733, -25927, -26007, -25928, -25737, -25546,
+    -25468, -25546, -25734, -25922, -25999, -25922, -25736, -25551, -25474, -25551, -25734, -25918,
+    -25994, -25918, -25736, -25553, -25478, -25553, -25735, -25916, -25991, -25916, -25735, -25554,
+    -25479, -25554, -25735, -25916, -25991, -25916, -25735, -25553, -25478, -25553, -25736, -25918,
+    -25994, -25918, -25734, -25551, -25474, -25551, -25736, -25922, -25999, -25922, -25734, -25546,
+    -25468, -25546, -25737, -25928, -26007, -25927, -25733, -25539, -25458, -25540, -25737, -25936,
+    -26018, -25935, -25733, -25530, -25445, -25530, -25738, -25946, -26033, -25946, -25732, -25517,
+    -25427, -25518, -25739, -25961, -26054, -25960, -25731, -25501, -25404, -25502, -25740, -25980,
+    -26080, -25978, -25730, -25479, -25373, -25480, -25741, -26005, -26116, -26003, -25728, -25449,
+    -25332, -25451, -25743, -26040, -26164, -26037, -25725, -25408, -25275, -25412, -25747, -26088,
+    -26232, -26084, -25721, -25350, -25193, -25355, -25753, -26160, -26332, -26154, -25713, -25260,
+    -25068, -25268, -25764, -26274, -26492, -26264, -25697, -25110, -24858, -25123, -25788, -26482,
+    -26781, -26462, -25656, -24808, -24438, -24839, -25864, -26960, -27445, -26904, -25491, -23938,
+    -23230, -24064, -26350, -29028, -30343, -28505, -22459, -12435, 0,
+    // square, level 3: harmonics 1..31
+    0, 6379, 12435, 17875, 22461, 26030, 28509, 29916, 30350, 29982, 29032, 27741,
+    26348, 25064, 24055, 23426, 23217, 23409, 23929, 24666, 25493, 26280, 26918, 27326,
+    27464, 27333, 26973, 26454, 25862, 25290, 24821, 24517, 24413, 24513, 24790, 25194,
+    25658, 26111, 26485, 26729, 26813, 26732, 26504, 26171, 25786, 25409, 25095, 24889,
+    24818, 24888, 25082, 25368, 25699, 26026, 26298, 26477, 26539, 26478, 26307, 26055,
+    25761, 25471, 25229, 25069, 25013, 25068, 25222, 25450, 25716, 25979, 26199, 26345,
+    26396, 26346, 26204, 25995, 25750, 25507, 25303, 25168, 25121, 25167, 25299, 25495,
+    25724, 25952, 26143, 26270, 26315, 26271, 26146, 25961, 25743, 25527, 25345, 25224,
+    25182, 25224, 25343, 25521, 25729, 25937, 26112, 26229, 26270, 26229, 26114, 25942,
+    25739, 25538, 25367, 25253, 25214, 25253, 25366, 25534, 25733, 25931, 26098, 26210,
+    26249, 26210, 26099, 25932, 25736, 25540, 25374, 25263, 25224, 25263, 25374, 25540,
+    25736, 25932, 26099, 26210, 26249, 26210, 26098, 25931, 25733, 25534, 25366, 25253,
+    25214, 25253, 25367, 25538, 25739, 25942, 26114, 26229, 26270, 26229, 26112, 25937,
+    25729, 25521, 25343, 25224, 25182, 25224, 25345, 25527, 25743, 25961, 26146, 26271,
+    26315, 26270, 26143, 25952, 25724, 25495, 25299, 25167, 25121, 25168, 25303, 25507,
+    25750, 25995, 26204, 26346, 26396, 26345, 26199, 25979, 25716, 25450, 25222, 25068,
+    25013, 25069, 25229, 25471, 25761, 26055, 26307, 26478, 26539, 26477, 26298, 26026,
+    25699, 25368, 25082, 24888, 24818, 24889, 25095, 25409, 25786, 26171, 26504, 26732,
+    26813, 26729, 26485, 26111, 25658, 25194, 24790, 24513, 24413, 24517, 24821, 25290,
+    25862, 26454, 26973, 27333, 27464, 27326, 26918, 26280, 25493, 24666, 23929, 23409,
+    23217, 23426, 24055, 25064, 26348, 27741, 29032, 29982, 30350, 29916, 28509, 26030,
+    22461, 17875, 12435, 6379, 0, -6379, -12435, -17875, -22461, -26030, -28509, -29916,
+    -30350, -29982, -29032, -27741, -26348, -25064, -24055, -23426, -23217, -23409, -23929, -24666,
+    -25493, -26280, -26918, -27326, -27464, -27333, -26973, -26454, -25862, -25290, -24821, -24517,
+    -24413, -24513, -24790, -25194, -25658, -26111, -26485, -26729, -26813, -26732, -26504, -26171,
+    -25786, -25409, -25095, -24889, -24818, -24888, -25082, -25368, -25699, -26026, -26298, -26477,
+    -26539, -26478, -26307, -26055, -25761, -25471, -25229, -25069, -25013, -25068, -25222, -25450,
+    -25716, -25979, -26199, -26345, -26396, -26346, -26204, -25995, -25750, -25507, -25303, -25168,
+    -25121, -25167, -25299, -25495, -25724, -25952, -26143, -26270, -26315, -26271, -26146, -25961,
+    -25743, -25527, -25345, -25224, -25182, -25224, -25343, -25521, -25729, -25937, -26112, -26229,
+    -26270, -26229, -26114, -25942, -25739, -25538, -25367, -25253, -25214, -25253, -25366, -25534,
+    -25733, -25931, -26098, -26210, -26249, -26210, -26099, -25932, -25736, -25540, -25374, -25263,
+    -25224, -25263, -25374, -25540, -25736, -25932, -26099, -26210, -26249, -26210, -26098, -25931,
+    -25733, -25534, -25366, -25253, -25214, -25253, -25367, -25538, -25739, -25942, -26114, -26229,
+    -26270, -26229, -26112, -25937, -25729, -25521, -25343, -25224, -25182, -25224, -25345, -25527,
+    -25743, -25961, -26146, -26271, -26315, -26270, -26143, -25952, -25724, -25495, -25299, -25167,
+    -25121, -25168, -25303, -25507, -25750, -25995, -26204, -26346, -26396, -26345, -26199, -25979,
+    -25716, -25450, -25222, -25068, -25013, -25069, -25229, -25471, -25761, -26055, -26307, -26478,
+    -26539, -26477, -26298, -26026, -25699, -25368, -25082, -24888, -24818, -24889, -25095, -25409,
+    -25786, -26171, -26504, -26732, -26813, -26729, -26485, -26111, -25658, -25194, -24790, -24513,
+    -24413, -24517, -24821, -25290, -25862, -26454, -26973, -27333, -27464, -27326, -26918, -26280,
+    -25493, -24666, -23929, -23409, -23217, -23426, -24055, -25064, -26348, -27741, -29032, -29982,
+    -30350, -29916, -28509, -26030, -22461, -17875, -12435, -6379, 0,
+    // square, level 4: harmonics 1..15
+    0, 3210, 6379, 9467, 12436, 15251, 17879, 20292, 22469, 24390, 26044, 27423,
+    28529, 29364, 29939, 30270, 30375, 30278, 30005, 29585, 29049, 28425, 27747, 27042,
+    26340, 25665, 25041, 24487, 24018, 23646, 23378, 23219, 23166, 23217, 23362, 23592,
+    23894, 24252, 24651, 25073, 25502, 25921, 26315, 26670, 26975, 27220, 27399, 27507,
+    27543, 27508, 27406, 27243, 27028, 26769, 26479, 26170, 25852, 25540, 25243, 24974,
+    24742, 24553, 24415, 24331, 24303, 24331, 24411, 24541, 24714, 24922, 25157, 25410,
+    25669, 25927, 26171, 26395, 26589, 26747, 26863, 26934, 26958, 26934, 26865, 26754,
+    26605, 26424, 26220, 26000, 25773, 25547, 25331, 25134, 24962, 24821, 24717, 24654,
+    24632, 24654, 24716, 24817, 24953, 25117, 25304, 25506, 25715, 25924, 26123, 26307,
+    26467, 26598, 26695, 26755, 26775, 26755, 26696, 26600, 26471, 26314, 26136, 25942,
+    25741, 25541, 25348, 25171, 25015, 24888, 24793, 24735, 24715, 24735, 24793, 24888,
+    25015, 25171, 25348, 25541, 25741, 25942, 26136, 26314, 26471, 26600, 26696, 26755,
+    26775, 26755, 26695, 26598, 26467, 26307, 26123, 25924, 25715, 25506, 25304, 25117,
+    24953, 24817, 24716, 24654, 24632, 24654, 24717, 24821, 24962, 25134, 25331, 25547,
+    25773, 26000, 26220, 26424, 26605, 26754, 26865, 26934, 26958, 26934, 26863, 26747,
+    26589, 26395, 26171, 25927, 25669, 25410, 25157, 24922, 24714, 24541, 24411, 24331,
+    24303, 24331, 24415, 24553, 24742, 24974, 25243, 25540, 25852, 26170, 26479, 26769,
+    27028, 27243, 27406, 27508, 27543, 27507, 27399, 27220, 26975, 26670, 26315, 25921,
+    25502, 25073, 24651, 24252, 23894, 23592, 23362, 23217, 23166, 23219, 23378, 23646,
+    24018, 24487, 25041, 25665, 26340, 27042, 27747, 28425, 29049, 29585, 30005, 30278,
+    30375, 30270, 29939, 29364, 28529, 27423, 26044, 24390, 22469, 20292, 17879, 15251,
+    12436, 9467, 6379, 3210, 0, -3210, -6379, -9467, -12436, -15251, -17879, -20292,
+    -22469, -24390, -26044, -27423, -28529, -29364, -29939, -30270, -30375, -30278, -30005, -29585,
+    -29049, -28425, -27747, -27042, -26340, -25665, -25041, -24487, -24018, -23646, -23378, -23219,
+    -23166, -23217, -23362, -23592, -23894, -24252, -24651, -25073, -25502, -25921, -26315, -26670,
+    -26975, -27220, -27399, -27507, -27543, -27508, -27406, -27243, -27028, -26769, -26479, -26170,
+    -25852, -25540, -25243, -24974, -24742, -24553, -24415, -24331, -24303, -24331, -24411, -24541,
+    -24714, -24922, -25157, -25410, -25669, -25927, -26171, -26395, -26589, -26747, -26863, -26934,
+    -26958, -26934, -26865, -26754, -26605, -26424, -26220, -26000, -25773, -25547, -25331, -25134,
+    -24962, -24821, -24717, -24654, -24632, -24654, -24716, -24817, -24953, -25117, -25304, -25506,
+    -25715, -25924, -26123, -26307, -26467, -26598, -26695, -26755, -26775, -26755, -26696, -26600,
+    -26471, -26314, -26136, -25942, -25741, -25541, -25348, -25171, -25015, -24888, -24793, -24735,
+    -24715, -24735, -24793, -24888, -25015, -25171, -25348, -25541, -25741, -25942, -26136, -26314,
+    -26471, -26600, -26696, -26755, -26775, -26755, -26695, -26598, -26467, -26307, -26123, -25924,
+    -25715, -25506, -25304, -25117, -24953, -24817, -24716, -24654, -24632, -24654, -24717, -24821,
+    -24962, -25134, -25331, -25547, -25773, -26000, -26220, -26424, -26605, -26754, -26865, -26934,
+    -26958, -26934, -26863, -26747, -26589, -26395, -26171, -25927, -25669, -25410, -25157, -24922,
+    -24714, -24541, -24411, -24331, -24303, -24331, -24415, -24553, -24742, -24974, -25243, -25540,
+    -25852, -26170, -26479, -26769, -27028, -27243, -27406, -27508, -27543, -27507, -27399, -27220,
+    -26975, -26670, -26315, -25921, -25502, -25073, -24651, -24252, -23894, -23592, -23362, -23217,
+    -23166, -23219, -23378, -23646, -24018, -24487, -25041, -25665, -26340, -27042, -27747, -28425,
+    -29049, -29585, -30005, -30278, -30375, -30270, -29939, -29364, -28529, -27423, -26044, -24390,
+    -22469, -20292, -17879, -15251, -12436, -9467, -6379, -3210, 0,
+    // square, level 5: harmonics 1..7
+    0, 1608, 3210, 4803, 6380, 7937, 9469, 10972, 12441, 13872, 15260, 16602,
+    17894, 19133, 20315, 21439, 22501, 23499, 24432, 25299, 26097, 26827, 27489, 28081,
+    28605, 29061, 29450, 29774, 30033, 30231, 30369, 30450, 30476, 30451, 30377, 30258,
+    30098, 29900, 29667, 29404, 29115, 28802, 28471, 28125, 27768, 27404, 27036, 26668,
+    26303, 25945, 25597, 25261, 24941, 24638, 24356, 24096, 23859, 23648, 23463, 23306,
+    23177, 23077, 23006, 22963, 22949, 22963, 23004, 23071, 23163, 23278, 23415, 23572,
+    23748, 23940, 24145, 24363, 24590, 24825, 25064, 25306, 25549, 25789, 26025, 26255,
+    26477, 26688, 26887, 27072, 27241, 27393, 27528, 27643, 27739, 27813, 27867, 27899,
+    27910, 27899, 27867, 27815, 27743, 27652, 27543, 27417, 27276, 27121, 26953, 26774,
+    26587, 26392, 26192, 25988, 25783, 25579, 25377, 25179, 24988, 24804, 24631, 24468,
+    24318, 24183, 24063, 23959, 23873, 23805, 23756, 23727, 23717, 23727, 23756, 23805,
+    23873, 23959, 24063, 24183, 24318, 24468, 24631, 24804, 24988, 25179, 25377, 25579,
+    25783, 25988, 26192, 26392, 26587, 26774, 26953, 27121, 27276, 27417, 27543, 27652,
+    27743, 27815, 27867, 27899, 27910, 27899, 27867, 27813, 27739, 27643, 27528, 27393,
+    27241, 27072, 26887, 26688, 26477, 26255, 26025, 25789, 25549, 25306, 25064, 24825,
+    24590, 24363, 24145, 23940, 23748, 23572, 23415, 23278, 23163, 23071, 23004, 22963,
+    22949, 22963, 23006, 23077, 23177, 23306, 23463, 23648, 23859, 24096, 24356, 24638,
+    24941, 25261, 25597, 25945, 26303, 26668, 27036, 27404, 27768, 28125, 28471, 28802,
+    29115, 29404, 29667, 29900, 30098, 30258, 30377, 30451, 30476, 30450, 30369, 30231,
+    30033, 29774, 29450, 29061, 28605, 28081, 27489, 26827, 26097, 25299, 24432, 23499,
+    22501, 21439, 20315, 19133, 17894, 16602, 15260, 13872, 12441, 10972, 9469, 7937,
+    6380, 4803, 3210, 1608, 0, -1608, -3210, -4803, -6380, -7937, -9469, -10972,
+    -12441, -13872, -15260, -16602, -17894, -19133, -20315, -21439, -22501, -23499, -24432, -25299,
+    -26097, -26827, -27489, -28081, -28605, -29061, -29450, -29774, -30033, -30231, -30369, -30450,
+    -30476, -30451, -30377, -30258, -30098, -29900, -29667, -29404, -29115, -28802, -28471, -28125,
+    -27768, -27404, -27036, -26668, -26303, -25945, -25597, -25261, -24941, -24638, -24356, -24096,
+    -23859, -23648, -23463, -23306, -23177, -23077, -23006, -22963, -22949, -22963, -23004, -23071,
+    -23163, -23278, -23415, -23572, -23748, -23940, -24145, -24363, -24590, -24825, -25064, -25306,
+    -25549, -25789, -26025, -26255, -26477, -26688, -26887, -27072, -27241, -27393, -27528, -27643,
+    -27739, -27813, -27867, -27899, -27910, -27899, -27867, -27815, -27743, -27652, -27543, -27417,
+    -27276, -27121, -26953, -26774, -26587, -26392, -26192, -25988, -25783, -25579, -25377, -25179,
+    -24988, -24804, -24631, -24468, -24318, -24183, -24063, -23959, -23873, -23805, -23756, -23727,
+    -23717, -23727, -23756, -23805, -23873, -23959, -24063, -24183, -24318, -24468, -24631, -24804,
+    -24988, -25179, -25377, -25579, -25783, -25988, -26192, -26392, -26587, -26774, -26953, -27121,
+    -27276, -27417, -27543, -27652, -27743, -27815, -27867, -27899, -27910, -27899, -27867, -27813,
+    -27739, -27643, -27528, -27393, -27241, -27072, -26887, -26688, -26477, -26255, -26025, -25789,
+    -25549, -25306, -25064, -24825, -24590, -24363, -24145, -23940, -23748, -23572, -23415, -23278,
+    -23163, -23071, -23004, -22963, -22949, -22963, -23006, -23077, -23177, -23306, -23463, -23648,
+    -23859, -24096, -24356, -24638, -24941, -25261, -25597, -25945, -26303, -26668, -27036, -27404,
+    -27768, -28125, -28471, -28802, -29115, -29404, -29667, -29900, -30098, -30258, -30377, -30451,
+    -30476, -30450, -30369, -30231, -30033, -29774, -29450, -29061, -28605, -28081, -27489, -26827,
+    -26097, -25299, -24432, -23499, -22501, -21439, -20315, -19133, -17894, -16602, -15260, -13872,
+    -12441, -10972, -9469, -7937, -6380, -4803, -3210, -1608, 0,
+    // square, level 6: harmonics 1..3
+    0, 804, 1608, 2410, 3210, 4009, 4804, 5595, 6382, 7165, 7942, 8713,
+    9478, 10235, 10986, 11727, 12461, 13185, 13899, 14603, 15297, 15979, 16650, 17309,
+    17955, 18588, 19208, 19815, 20407, 20985, 21549, 22097, 22630, 23148, 23650, 24135,
+    24605, 25058, 25494, 25913, 26316, 26701, 27070, 27421, 27755, 28071, 28370, 28652,
+    28917, 29164, 29394, 29607, 29803, 29982, 30145, 30290, 30420, 30533, 30630, 30712,
+    30778, 30829, 30865, 30886, 30893, 30886, 30866, 30832, 30785, 30726, 30655, 30572,
+    30478, 30373, 30258, 30133, 29998, 29855, 29703, 29543, 29376, 29201, 29020, 28833,
+    28641, 28444, 28242, 28036, 27827, 27615, 27401, 27185, 26967, 26749, 26530, 26311,
+    26093, 25876, 25661, 25447, 25236, 25028, 24824, 24623, 24427, 24235, 24049, 23867,
+    23692, 23523, 23360, 23204, 23056, 22915, 22781, 22656, 22539, 22430, 22330, 22239,
+    22157, 22085, 22021, 21968, 21923, 21889, 21864, 21850, 21845, 21850, 21864, 21889,
+    21923, 21968, 22021, 22085, 22157, 22239, 22330, 22430, 22539, 22656, 22781, 22915,
+    23056, 23204, 23360, 23523, 23692, 23867, 24049, 24235, 24427, 24623, 24824, 25028,
+    25236, 25447, 25661, 25876, 26093, 26311, 26530, 26749, 26967, 27185, 27401, 27615,
+    27827, 28036, 28242, 28444, 28641, 28833, 29020, 29201, 29376, 29543, 29703, 29855,
+    29998, 30133, 30258, 30373, 30478, 30572, 30655, 30726, 30785, 30832, 30866, 30886,
+    30893, 30886, 30865, 30829, 30778, 30712, 30630, 30533, 30420, 30290, 30145, 29982,
+    29803, 29607, 29394, 29164, 28917, 28652, 28370, 28071, 27755, 27421, 27070, 26701,
+    26316, 25913, 25494, 25058, 24605, 24135, 23650, 23148, 22630, 22097, 21549, 20985,
+    20407, 19815, 19208, 18588, 17955, 17309, 16650, 15979, 15297, 14603, 13899, 13185,
+    12461, 11727, 10986, 10235, 9478, 8713, 7942, 7165, 6382, 5595, 4804, 4009,
+    3210, 2410, 1608, 804, 0, -804, -1608, -2410, -3210, -4009, -4804, -5595,
+    -6382, -7165, -7942, -8713, -9478, -10235, -10986, -11727, -12461, -13185, -13899, -14603,
+    -15297, -15979, -16650, -17309, -17955, -18588, -19208, -19815, -20407, -20985, -21549, -22097,
+    -22630, -23148, -23650, -24135, -24605, -25058, -25494, -25913, -26316, -26701, -27070, -27421,
+    -27755, -28071, -28370, -28652, -28917, -29164, -29394, -29607, -29803, -29982, -30145, -30290,
+    -30420, -30533, -30630, -30712, -30778, -30829, -30865, -30886, -30893, -30886, -30866, -30832,
+    -30785, -30726, -30655, -30572, -30478, -30373, -30258, -30133, -29998, -29855, -29703, -29543,
+    -29376, -29201, -29020, -28833, -28641, -28444, -28242, -28036, -27827, -27615, -27401, -27185,
+    -26967, -26749, -26530, -26311, -26093, -25876, -25661, -25447, -25236, -25028, -24824, -24623,
+    -24427, -24235, -24049, -23867, -23692, -23523, -23360, -23204, -23056, -22915, -22781, -22656,
+    -22539, -22430, -22330, -22239, -22157, -22085, -22021, -21968, -21923, -21889, -21864, -21850,
+    -21845, -21850, -21864, -21889, -21923, -21968, -22021, -22085, -22157, -22239, -22330, -22430,
+    -22539, -22656, -22781, -22915, -23056, -23204, -23360, -23523, -23692, -23867, -24049, -24235,
+    -24427, -24623, -24824, -25028, -25236, -25447, -25661, -25876, -26093, -26311, -26530, -26749,
+    -26967, -27185, -27401, -27615, -27827, -28036, -28242, -28444, -28641, -28833, -29020, -29201,
+    -29376, -29543, -29703, -29855, -29998, -30133, -30258, -30373, -30478, -30572, -30655, -30726,
+    -30785, -30832, -30866, -30886, -30893, -30886, -30865, -30829, -30778, -30712, -30630, -30533,
+    -30420, -30290, -30145, -29982, -29803, -29607, -29394, -29164, -28917, -28652, -28370, -28071,
+    -27755, -27421, -27070, -26701, -26316, -25913, -25494, -25058, -24605, -24135, -23650, -23148,
+    -22630, -22097, -21549, -20985, -20407, -19815, -19208, -18588, -17955, -17309, -16650, -15979,
+    -15297, -14603, -13899, -13185, -12461, -11727, -10986, -10235, -9478, -8713, -7942, -7165,
+    -6382, -5595, -4804, -4009, -3210, -2410, -1608, -804, 0,
+    // square, level 7: harmonics 1..1
+    0, 402, 804, 1206, 1608, 2009, 2410, 2811, 3212, 3612, 4011, 4410,
+    4808, 5205, 5602, 5998, 6393, 6786, 7179, 7571, 7962, 8351, 8739, 9126,
+    9512, 9896, 10278, 10659, 11039, 11417, 11793, 12167, 12539, 12910, 13279, 13645,
+    14010, 14372, 14732, 15090, 15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869,
+    18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475, 20787, 21096, 21403, 21705,
+    22005, 22301, 22594, 22884, 23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072,
+    25329, 25582, 25832, 26077, 26319, 26556, 26790, 27019, 27245, 27466, 27683, 27896,
+    28105, 28310, 28510, 28706, 28898, 29085, 29268, 29447, 29621, 29791, 29956, 30117,
+    30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237, 31356, 31470, 31580, 31685,
+    31785, 31880, 31971, 32057, 32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567,
+    32609, 32646, 32678, 32705, 32728, 32745, 32757, 32765, 32767, 32765, 32757, 32745,
+    32728, 32705, 32678, 32646, 32609, 32567, 32521, 32469, 32412, 32351, 32285, 32213,
+    32137, 32057, 31971, 31880, 31785, 31685, 31580, 31470, 31356, 31237, 31113, 30985,
+    30852, 30714, 30571, 30424, 30273, 30117, 29956, 29791, 29621, 29447, 29268, 29085,
+    28898, 28706, 28510, 28310, 28105, 27896, 27683, 27466, 27245, 27019, 26790, 26556,
+    26319, 26077, 25832, 25582, 25329, 25072, 24811, 24547, 24279, 24007, 23731, 23452,
+    23170, 22884, 22594, 22301, 22005, 21705, 21403, 21096, 20787, 20475, 20159, 19841,
+    19519, 19195, 18868, 18537, 18204, 17869, 17530, 17189, 16846, 16499, 16151, 15800,
+    15446, 15090, 14732, 14372, 14010, 13645, 13279, 12910, 12539, 12167, 11793, 11417,
+    11039, 10659, 10278, 9896, 9512, 9126, 8739, 8351, 7962, 7571, 7179, 6786,
+    6393, 5998, 5602, 5205, 4808, 4410, 4011, 3612, 3212, 2811, 2410, 2009,
+    1608, 1206, 804, 402, 0, -402, -804, -1206, -1608, -2009, -2410, -2811,
+    -3212, -3612, -4011, -4410, -4808, -5205, -5602, -5998, -6393, -6786, -7179, -7571,
+    -7962, -8351, -8739, -9126, -9512, -9896, -10278, -10659, -11039, -11417, -11793, -12167,
+    -12539, -12910, -13279, -13645, -14010, -14372, -14732, -15090, -15446, -15800, -16151, -16499,
+    -16846, -17189, -17530, -17869, -18204, -18537, -18868, -19195, -19519, -19841, -20159, -20475,
+    -20787, -21096, -21403, -21705, -22005, -22301, -22594, -22884, -23170, -23452, -23731, -24007,
+    -24279, -24547, -24811, -25072, -25329, -25582, -25832, -26077, -26319, -26556, -26790, -27019,
+    -27245, -27466, -27683, -27896, -28105, -28310, -28510, -28706, -28898, -29085, -29268, -29447,
+    -29621, -29791, -29956, -30117, -30273, -30424, -30571, -30714, -30852, -30985, -31113, -31237,
+    -31356, -31470, -31580, -31685, -31785, -31880, -31971, -32057, -32137, -32213, -32285, -32351,
+    -32412, -32469, -32521, -32567, -32609, -32646, -32678, -32705, -32728, -32745, -32757, -32765,
+    -32767, -32765, -32757, -32745, -32728, -32705, -32678, -32646, -32609, -32567, -32521, -32469,
+    -32412, -32351, -32285, -32213, -32137, -32057, -31971, -31880, -31785, -31685, -31580, -31470,
+    -31356, -31237, -31113, -30985, -30852, -30714, -30571, -30424, -30273, -30117, -29956, -29791,
+    -29621, -29447, -29268, -29085, -28898, -28706, -28510, -28310, -28105, -27896, -27683, -27466,
+    -27245, -27019, -26790, -26556, -26319, -26077, -25832, -25582, -25329, -25072, -24811, -24547,
+    -24279, -24007, -23731, -23452, -23170, -22884, -22594, -22301, -22005, -21705, -21403, -21096,
+    -20787, -20475, -20159, -19841, -19519, -19195, -18868, -18537, -18204, -17869, -17530, -17189,
+    -16846, -16499, -16151, -15800, -15446, -15090, -14732, -14372, -14010, -13645, -13279, -12910,
+    -12539, -12167, -11793, -11417, -11039, -10659, -10278, -9896, -9512, -9126, -8739, -8351,
+    -7962, -7571, -7179, -6786, -6393, -5998, -5602, -5205, -4808, -4410, -4011, -3612,
+    -3212, -2811, -2410, -2009, -1608, -1206, -804, -402, 0,
+    // triangle, level 0: harmonics 1..255
+    0, 256, 513, 769, 1026, 1282, 1538, 1795, 2051, 2308, 2564, 2820,
+    3077, 3333, 3590, 3846, 4102, 4359, 4615, 4872, 5128, 5384, 5641, 5897,
+    6154, 6410, 6666, 6923, 7179, 7436, 7692, 7948, 8205, 8461, 8718, 8974,
+    9230, 9487, 9743, 10000, 10256, 10512, 10769, 11025, 11282, 11538, 11794, 12051,
+    12307, 12564, 12820, 13076, 13333, 13589, 13845, 14102, 14358, 14615, 14871, 15127,
+    15384, 15640, 15897, 16153, 16409, 16666, 16922, 17179, 17435, 17691, 17948, 18204,
+    18461, 18717, 18973, 19230, 19486, 19743, 19999, 20255, 20512, 20768, 21025, 21281,
+    21537, 21794, 22050, 22307, 22563, 22819, 23076, 23332, 23589, 23845, 24101, 24358,
+    24614, 24871, 25127, 25383, 25640, 25896, 26153, 26409, 26665, 26922, 27178, 27435,
+    27691, 27947, 28204, 28460, 28717, 28973, 29229, 29486, 29742, 29999, 30255, 30512,
+    30768, 31024, 31280, 31537, 31793, 32051, 32304, 32569, 32767, 32569, 32304, 32051,
+    31793, 31537, 31280, 31024, 30768, 30512, 30255, 29999, 29742, 29486, 29229, 28973,
+    28717, 28460, 28204, 27947, 27691, 27435, 27178, 26922, 26665, 26409, 26153, 25896,
+    25640, 25383, 25127, 24871, 24614, 24358, 24101, 23845, 23589, 23332, 23076, 22819,
+    22563, 22307, 22050, 21794, 21537, 21281, 21025, 20768, 20512, 20255, 19999, 19743,
+    19486, 19230, 18973, 18717, 18461, 18204, 17948, 17691, 17435, 17179, 16922, 16666,
+    16409, 16153, 15897, 15640, 15384, 15127, 14871, 14615, 14358, 14102, 13845, 13589,
+    13333, 13076, 12820, 12564, 12307, 12051, 11794, 11538, 11282, 11025, 10769, 10512,
+    10256, 10000, 9743, 9487, 9230, 8974, 8718, 8461, 8205, 7948, 7692, 7436,
+    7179, 6923, 6666, 6410, 6154, 5897, 5641, 5384, 5128, 4872, 4615, 4359,
+    4102, 3846, 3590, 3333, 3077, 2820, 2564, 2308, 2051, 1795, 1538, 1282,
+    1026, 769, 513, 256, 0, -256, -513, -769, -1026, -1282, -1538, -1795,
+    -2051, -2308, -2564, -2820, -3077, -3333, -3590, -3846, -4102, -4359, -4615, -4872,
+    -5128, -5384, -5641, -5897, -6154, -6410, -6666, -6923, -7179, -7436, -7692, -7948,
+    -8205, -8461, -8718, -8974, -9230, -9487, -9743, -10000, -10256, -10512, -10769, -11025,
+    -11282, -11538, -11794, -12051, -12307, -12564, -12820, -13076, -13333, -13589, -13845, -14102,
+    -14358, -14615, -14871, -15127, -15384, -15640, -15897, -16153, -16409, -16666, -16922, -17179,
+    -17435, -17691, -17948, -18204, -18461, -18717, -18973, -19230, -19486, -19743, -19999, -20255,
+    -20512, -20768, -21025, -21281, -21537, -21794, -22050, -22307, -22563, -22819, -23076, -23332,
+    -23589, -23845, -24101, -24358, -24614, -24871, -25127, -25383, -25640, -25896, -26153, -26409,
+    -26665, -26922, -27178, -27435, -27691, -27947, -28204, -28460, -28717, -28973, -29229, -29486,
+    -29742, -29999, -30255, -30512, -30768, -31024, -31280, -31537, -31793, -32051, -32304, -32569,
+    -32767, -32569, -32304, -32051, -31793, -31537, -31280, -31024, -30768, -30512, -30255, -29999,
+    -29742, -29486, -29229, -28973, -28717, -28460, -28204, -27947, -27691, -27435, -27178, -26922,
+    -26665, -26409, -26153, -25896, -25640, -25383, -25127, -24871, -24614, -24358, -24101, -23845,
+    -23589, -23332, -23076, -22819, -22563, -22307, -22050, -21794, -21537, -21281, -21025, -20768,
+    -20512, -20255, -19999, -19743, -19486, -19230, -18973, -18717, -18461, -18204, -17948, -17691,
+    -17435, -17179, -16922, -16666, -16409, -16153, -15897, -15640, -15384, -15127, -14871, -14615,
+    -14358, -14102, -13845, -13589, -13333, -13076, -12820, -12564, -12307, -12051, -11794, -11538,
+    -11282, -11025, -10769, -10512, -10256, -10000, -9743, -9487, -9230, -8974, -8718, -8461,
+    -8205, -7948, -7692, -7436, -7179, -6923, -6666, -6410, -6154, -5897, -5641, -5384,
+    -5128, -4872, -4615, -4359, -4102, -3846, -3590, -3333, -3077, -2820, -2564, -2308,
+    -2051, -1795, -1538, -1282, -1026, -769, -513, -256, 0,
+    // triangle, level 1: harmonics 1..127
+    0, 256, 513, 770, 1026, 1281, 1538, 1796, 2051, 2307, 2564, 2821,
+    3077, 3332, 3590, 3847, 4102, 4358, 4615, 4872, 5128, 5384, 5641, 5898,
+    6154, 6409, 6666, 6924, 7179, 7435, 7692, 7949, 8205, 8460, 8718, 8975,
+    9230, 9486, 9743, 10000, 10256, 10511, 10769, 11026, 11282, 11537, 11794, 12052,
+    12307, 12563, 12820, 13077, 13333, 13588, 13846, 14103, 14358, 14614, 14871, 15129,
+    15384, 15639, 15897, 16154, 16409, 16665, 16922, 17180, 17435, 17690, 17948, 18206,
+    18461, 18716, 18973, 19231, 19486, 19741, 19999, 20257, 20512, 20767, 21025, 21283,
+    21537, 21792, 22050, 22308, 22563, 22818, 23076, 23334, 23589, 23843, 24101, 24360,
+    24614, 24868, 25127, 25386, 25640, 25894, 26153, 26412, 26665, 26919, 27178, 27438,
+    27691, 27944, 28204, 28464, 28716, 28969, 29230, 29491, 29742, 29993, 30256, 30519,
+    30767, 31015, 31283, 31549, 31789, 32031, 32318, 32595, 32715, 32595, 32318, 32031,
+    31789, 31549, 31283, 31015, 30767, 30519, 30256, 29993, 29742, 29491, 29230, 28969,
+    28716, 28464, 28204, 27944, 27691, 27438, 27178, 26919, 26665, 26412, 26153, 25894,
+    25640, 25386, 25127, 24868, 24614, 24360, 24101, 23843, 23589, 23334, 23076, 22818,
+    22563, 22308, 22050, 21792, 21537, 21283, 21025, 20767, 20512, 20257, 19999, 19741,
+    19486, 19231, 18973, 18716, 18461, 18206, 17948, 17690, 17435, 17180, 16922, 16665,
+    16409, 16154, 15897, 15639, 15384, 15129, 14871, 14614, 14358, 14103, 13846, 13588,
+    13333, 13077, 12820, 12563, 12307, 12052, 11794, 11537, 11282, 11026, 10769, 10511,
+    10256, 10000, 9743, 9486, 9230, 8975, 8718, 8460, 8205, 7949, 7692, 7435,
+    7179, 6924, 6666, 6409, 6154, 5898, 5641, 5384, 5128, 4872, 4615, 4358,
+    4102, 3847, 3590, 3332, 3077, 2821, 2564, 2307, 2051, 1796, 1538, 1281,
+    1026, 770, 513, 256, 0, -256, -513, -770, -1026, -1281, -1538, -1796,
+    -2051, -2307, -2564, -2821, -3077, -3332, -3590, -3847, -4102, -4358, -4615, -4872,
+    -5128, -5384, -5641, -5898, -6154, -6409, -6666, -6924, -7179, -7435, -7692, -7949,
+    -8205, -8460, -8718, -8975, -9230, -9486, -9743, -10000, -10256, -10511, -10769, -11026,
+    -11282, -11537, -11794, -12052, -12307, -12563, -12820, -13077, -13333, -13588, -13846, -14103,
+    -14358, -14614, -14871, -15129, -15384, -15639, -15897, -16154, -16409, -16665, -16922, -17180,
+    -17435, -17690, -17948, -18206, -18461, -18716, -18973, -19231, -19486, -19741, -19999, -20257,
+    -20512, -20767, -21025, -21283, -21537, -21792, -22050, -22308, -22563, -22818, -23076, -23334,
+    -23589, -23843, -24101, -24360, -24614, -24868, -25127, -25386, -25640, -25894, -26153, -26412,
+    -26665, -26919, -27178, -27438, -27691, -27944, -28204, -28464, -28716, -28969, -29230, -29491,
+    -29742, -29993, -30256, -30519, -30767, -31015, -31283, -31549, -31789, -32031, -32318, -32595,
+    -32715, -32595, -32318, -32031, -31789, -31549, -31283, -31015, -30767, -30519, -30256, -29993,
+    -29742, -29491, -29230, -28969, -28716, -28464, -28204, -27944, -27691, -27438, -27178, -26919,
+    -26665, -26412, -26153, -25894, -25640, -25386, -25127, -24868, -24614, -24360, -24101, -23843,
+    -23589, -23334, -23076, -22818, -22563, -22308, -22050, -21792, -21537, -21283, -21025, -20767,
+    -20512, -20257, -19999, -19741, -19486, -19231, -18973, -18716, -18461, -18206, -17948, -17690,
+    -17435, -17180, -16922, -16665, -16409, -16154, -15897, -15639, -15384, -15129, -14871, -14614,
+    -14358, -14103, -13846, -13588, -13333, -13077, -12820, -12563, -12307, -12052, -11794, -11537,
+    -11282, -11026, -10769, -10511, -10256, -10000, -9743, -9486, -9230, -8975, -8718, -8460,
+    -8205, -7949, -7692, -7435, -7179, -6924, -6666, -6409, -6154, -5898, -5641, -5384,
+    -5128, -4872, -4615, -4358, -4102, -3847, -3590, -3332, -3077, -2821, -2564, -2307,
+    -2051, -1796, -1538, -1281, -1026, -770, -513, -256, 0,
+    // triangle, level 2: harmonics 1..63
+    0, 254, 510, 767, 1026, 1284, 1542, 1797, 2051, 2305, 2561, 2818,
+    3077, 3336, 3593, 3848, 4102, 4356, 4612, 4869, 5128, 5387, 5644, 5900,
+    6154, 6408, 6663, 6920, 7179, 7438, 7695, 7951, 8205, 8459, 8714, 8971,
+    9230, 9489, 9747, 10002, 10256, 10510, 10765, 11023, 11282, 11541, 11798, 12053,
+    12307, 12561, 12816, 13074, 13333, 13592, 13850, 14105, 14358, 14612, 14867, 15125,
+    15384, 15644, 15901, 16156, 16409, 16662, 16918, 17175, 17435, 17695, 17953, 18208,
+    18460, 18713, 18968, 19226, 19486, 19747, 20005, 20259, 20512, 20764, 21019, 21277,
+    21538, 21799, 22057, 22311, 22563, 22814, 23069, 23327, 23589, 23851, 24109, 24363,
+    24614, 24864, 25118, 25377, 25641, 25904, 26163, 26416, 26664, 26913, 27166, 27427,
+    27693, 27958, 28218, 28469, 28714, 28959, 29211, 29475, 29746, 30018, 30279, 30525,
+    30759, 30993, 31244, 31520, 31818, 32114, 32371, 32548, 32611, 32548, 32371, 32114,
+    31818, 31520, 31244, 30993, 30759, 30525, 30279, 30018, 29746, 29475, 29211, 28959,
+    28714, 28469, 28218, 27958, 27693, 27427, 27166, 26913, 26664, 26416, 26163, 25904,
+    25641, 25377, 25118, 24864, 24614, 24363, 24109, 23851, 23589, 23327, 23069, 22814,
+    22563, 22311, 22057, 21799, 21538, 21277, 21019, 20764, 20512, 20259, 20005, 19747,
+    19486, 19226, 18968, 18713, 18460, 18208, 17953, 17695, 17435, 17175, 16918, 16662,
+    16409, 16156, 15901, 15644, 15384, 15125, 14867, 14612, 14358, 14105, 13850, 13592,
+    13333, 13074, 12816, 12561, 12307, 12053, 11798, 11541, 11282, 11023, 10765, 10510,
+    10256, 10002, 9747, 9489, 9230, 8971, 8714, 8459, 8205, 7951, 7695, 7438,
+    7179, 6920, 6663, 6408, 6154, 5900, 5644, 5387, 5128, 4869, 4612, 4356,
+    4102, 3848, 3593, 3336, 3077, 2818, 2561, 2305, 2051, 1797, 1542, 1284,
+    1026, 767, 510, 254, 0, -254, -510, -767, -1026, -1284, -1542, -1797,
+    -2051, -2305, -2561, -2818, -3077, -3336, -3593, -3848, -4102, -4356, -4612, -4869,
+    -5128, -5387, -5644, -5900, -6154, -6408, -6663, -6920, -7179, -7438, -7695, -7951,
+    -8205, -8459, -8714, -8971, -9230, -9489, -9747, -10002, -10256, -10510, -10765, -11023,
+    -11282, -11541, -11798, -12053, -12307, -12561, -12816, -13074, -13333, -13592, -13850, -14105,
+    -14358, -14612, -14867, -15125, -15384, -15644, -15901, -16156, -16409, -16662, -16918, -17175,
+    -17435, -17695, -17953, -18208, -18460, -18713, -18968, -19226, -19486, -19747, -20005, -20259,
+    -20512, -20764, -21019, -21277, -21538, -21799, -22057, -22311, -22563, -22814, -23069, -23327,
+    -23589, -23851, -24109, -24363, -24614, -24864, -25118, -25377, -25641, -25904, -26163, -26416,
+    -26664, -26913, -27166, -27427, -27693, -27958, -28218, -28469, -28714, -28959, -29211, -29475,
+    -29746, -30018, -30279, -30525, -30759, -30993, -31244, -31520, -31818, -32114, -32371, -32548,
+    -32611, -32548, -32371, -32114, -31818, -31520, -31244, -30993, -30759, -30525, -30279, -30018,
+    -29746, -29475, -29211, -28959, -28714, -28469, -28218, -27958, -27693, -27427, -27166, -26913,
+    -26664, -26416, -26163, -25904, -25641, -25377, -25118, -24864, -24614, -24363, -24109, -23851,
+    -23589, -23327, -23069, -22814, -22563, -22311, -22057, -21799, -21538, -21277, -21019, -20764,
+    -20512, -20259, -20005, -19747, -19486, -19226, -18968, -18713, -18460, -18208, -17953, -17695,
+    -17435, -17175, -16918, -16662, -16409, -16156, -15901, -15644, -15384, -15125, -14867, -14612,
+    -14358, -14105, -13850, -13592, -13333, -13074, -12816, -12561, -12307, -12053, -11798, -11541,
+    -11282, -11023, -10765, -10510, -10256, -10002, -9747, -9489, -9230, -8971, -8714, -8459,
+    -8205, -7951, -7695, -7438, -7179, -6920, -6663, -6408, -6154, -5900, -5644, -5387,
+    -5128, -4869, -4612, -4356, -4102, -3848, -3593, -3336, -3077, -2818, -2561, -2305,
+    -2051, -1797, -1542, -1284, -1026, -767, -510, -254, 0,
+    // triangle, level 3: harmonics 1..31
+    0, 251, 504, 757, 1013, 1270, 1529, 1790, 2051, 2313, 2573, 2832,
+    3090, 3345, 3599, 3851, 4102, 4354, 4606, 4859, 5115, 5372, 5631, 5892,
+    6154, 6415, 6676, 6936, 7193, 7448, 7702, 7953, 8204, 8455, 8707, 8961,
+    9216, 9474, 9733, 9994, 10256, 10518, 10780, 11039, 11297, 11552, 11805, 12056,
+    12306, 12557, 12808, 13061, 13317, 13574, 13834, 14096, 14359, 14622, 14884, 15144,
+    15401, 15656, 15909, 16159, 16408, 16658, 16908, 17161, 17416, 17674, 17935, 18198,
+    18462, 18726, 18989, 19250, 19508, 19762, 20013, 20262, 20510, 20757, 21006, 21258,
+    21513, 21771, 22034, 22299, 22566, 22833, 23098, 23360, 23618, 23871, 24120, 24366,
+    24609, 24853, 25099, 25348, 25603, 25864, 26130, 26400, 26674, 26947, 27217, 27482,
+    27740, 27990, 28232, 28468, 28700, 28932, 29168, 29412, 29668, 29938, 30221, 30515,
+    30816, 31117, 31409, 31682, 31924, 32126, 32277, 32372, 32403, 32372, 32277, 32126,
+    31924, 31682, 31409, 31117, 30816, 30515, 30221, 29938, 29668, 29412, 29168, 28932,
+    28700, 28468, 28232, 27990, 27740, 27482, 27217, 26947, 26674, 26400, 26130, 25864,
+    25603, 25348, 25099, 24853, 24609, 24366, 24120, 23871, 23618, 23360, 23098, 22833,
+    22566, 22299, 22034, 21771, 21513, 21258, 21006, 20757, 20510, 20262, 20013, 19762,
+    19508, 19250, 18989, 18726, 18462, 18198, 17935, 17674, 17416, 17161, 16908, 16658,
+    16408, 16159, 15909, 15656, 15401, 15144, 14884, 14622, 14359, 14096, 13834, 13574,
+    13317, 13061, 12808, 12557, 12306, 12056, 11805, 11552, 11297, 11039, 10780, 10518,
+    10256, 9994, 9733, 9474, 9216, 8961, 8707, 8455, 8204, 7953, 7702, 7448,
+    7193, 6936, 6676, 6415, 6154, 5892, 5631, 5372, 5115, 4859, 4606, 4354,
+    4102, 3851, 3599, 3345, 3090, 2832, 2573, 2313, 2051, 1790, 1529, 1270,
+    1013, 757, 504, 251, 0, -251, -504, -757, -1013, -1270, -1529, -1790,
+    -2051, -2313, -2573, -2832, -3090, -3345, -3599, -3851, -4102, -4354, -4606, -4859,
+    -5115, -5372, -5631, -5892, -6154, -6415, -6676, -6936, -7193, -7448, -7702, -7953,
+    -8204, -8455, -8707, -8961, -9216, -9474, -9733, -9994, -10256, -10518, -10780, -11039,
+    -11297, -11552, -11805, -12056, -12306, -12557, -12808, -13061, -13317, -13574, -13834, -14096,
+    -14359, -14622, -14884, -15144, -15401, -15656, -15909, -16159, -16408, -16658, -16908, -17161,
+    -17416, -17674, -17935, -18198, -18462, -18726, -18989, -19250, -19508, -19762, -20013, -20262,
+    -20510, -20757, -21006, -21258, -21513, -21771, -22034, -22299, -22566, -22833, -23098, -23360,
+    -23618, -23871, -24120, -24366, -24609, -24853, -25099, -25348, -25603, -25864, -26130, -26400,
+    -26674, -26947, -27217, -27482, -27740, -27990, -28232, -28468, -28700, -28932, -29168, -29412,
+    -29668, -29938, -30221, -30515, -30816, -31117, -31409, -31682, -31924, -32126, -32277, -32372,
+    -32403, -32372, -32277, -32126, -31924, -31682, -31409, -31117, -30816, -30515, -30221, -29938,
+    -29668, -29412, -29168, -28932, -28700, -28468, -28232, -27990, -27740, -27482, -27217, -26947,
+    -26674, -26400, -26130, -25864, -25603, -25348, -25099, -24853, -24609, -24366, -24120, -23871,
+    -23618, -23360, -23098, -22833, -22566, -22299, -22034, -21771, -21513, -21258, -21006, -20757,
+    -20510, -20262, -20013, -19762, -19508, -19250, -18989, -18726, -18462, -18198, -17935, -17674,
+    -17416, -17161, -16908, -16658, -16408, -16159, -15909, -15656, -15401, -15144, -14884, -14622,
+    -14359, -14096, -13834, -13574, -13317, -13061, -12808, -12557, -12306, -12056, -11805, -11552,
+    -11297, -11039, -10780, -10518, -10256, -9994, -9733, -9474, -9216, -8961, -8707, -8455,
+    -8204, -7953, -7702, -7448, -7193, -6936, -6676, -6415, -6154, -5892, -5631, -5372,
+    -5115, -4859, -4606, -4354, -4102, -3851, -3599, -3345, -3090, -2832, -2573, -2313,
+    -2051, -1790, -1529, -1270, -1013, -757, -504, -251, 0,
+    // triangle, level 4: harmonics 1..15
+    0, 246, 493, 740, 989, 1239, 1491, 1744, 2000, 2257, 2516, 2778,
+    3041, 3305, 3571, 3837, 4104, 4370, 4637, 4902, 5166, 5429, 5691, 5950,
+    6207, 6462, 6715, 6967, 7216, 7464, 7711, 7956, 8202, 8447, 8693, 8940,
+    9188, 9438, 9689, 9942, 10198, 10456, 10716, 10978, 11243, 11508, 11776, 12044,
+    12312, 12581, 12849, 13116, 13381, 13645, 13907, 14167, 14424, 14678, 14930, 15180,
+    15427, 15672, 15916, 16159, 16401, 16643, 16886, 17130, 17375, 17623, 17873, 18126,
+    18382, 18641, 18904, 19169, 19437, 19707, 19979, 20253, 20527, 20802, 21075, 21347,
+    21617, 21885, 22149, 22409, 22665, 22917, 23165, 23408, 23648, 23885, 24118, 24350,
+    24581, 24812, 25044, 25279, 25516, 25757, 26004, 26257, 26516, 26782, 27054, 27334,
+    27621, 27913, 28210, 28510, 28813, 29115, 29415, 29711, 29999, 30278, 30545, 30796,
+    31030, 31243, 31433, 31599, 31737, 31846, 31925, 31973, 31989, 31973, 31925, 31846,
+    31737, 31599, 31433, 31243, 31030, 30796, 30545, 30278, 29999, 29711, 29415, 29115,
+    28813, 28510, 28210, 27913, 27621, 27334, 27054, 26782, 26516, 26257, 26004, 25757,
+    25516, 25279, 25044, 24812, 24581, 24350, 24118, 23885, 23648, 23408, 23165, 22917,
+    22665, 22409, 22149, 21885, 21617, 21347, 21075, 20802, 20527, 20253, 19979, 19707,
+    19437, 19169, 18904, 18641, 18382, 18126, 17873, 17623, 17375, 17130, 16886, 16643,
+    16401, 16159, 15916, 15672, 15427, 15180, 14930, 14678, 14424, 14167, 13907, 13645,
+    13381, 13116, 12849, 12581, 12312, 12044, 11776, 11508, 11243, 10978, 10716, 10456,
+    10198, 9942, 9689, 9438, 9188, 8940, 8693, 8447, 8202, 7956, 7711, 7464,
+    7216, 6967, 6715, 6462, 6207, 5950, 5691, 5429, 5166, 4902, 4637, 4370,
+    4104, 3837, 3571, 3305, 3041, 2778, 2516, 2257, 2000, 1744, 1491, 1239,
+    989, 740, 493, 246, 0, -246, -493, -740, -989, -1239, -1491, -1744,
+    -2000, -2257, -2516, -2778, -3041, -3305, -3571, -3837, -4104, -4370, -4637, -4902,
+    -5166, -5429, -5691, -5950, -6207, -6462, -6715, -6967, -7216, -7464, -7711, -7956,
+    -8202, -8447, -8693, -8940, -9188, -9438, -9689, -9942, -10198, -10456, -10716, -10978,
+    -11243, -11508, -11776, -12044, -12312, -12581, -12849, -13116, -13381, -13645, -13907, -14167,
+    -14424, -14678, -14930, -15180, -15427, -15672, -15916, -16159, -16401, -16643, -16886, -17130,
+    -17375, -17623, -17873, -18126, -18382, -18641, -18904, -19169, -19437, -19707, -19979, -20253,
+    -20527, -20802, -21075, -21347, -21617, -21885, -22149, -22409, -22665, -22917, -23165, -23408,
+    -23648, -23885, -24118, -24350, -24581, -24812, -25044, -25279, -25516, -25757, -26004, -26257,
+    -26516, -26782, -27054, -27334, -27621, -27913, -28210, -28510, -28813, -29115, -29415, -29711,
+    -29999, -30278, -30545, -30796, -31030, -31243, -31433, -31599, -31737, -31846, -31925, -31973,
+    -31989, -31973, -31925, -31846, -31737, -31599, -31433, -31243, -31030, -30796, -30545, -30278,
+    -29999, -29711, -29415, -29115, -28813, -28510, -28210, -27913, -27621, -27334, -27054, -26782,
+    -26516, -26257, -26004, -25757, -25516, -25279, -25044, -24812, -24581, -24350, -24118, -23885,
+    -23648, -23408, -23165, -22917, -22665, -22409, -22149, -21885, -21617, -21347, -21075, -20802,
+    -20527, -20253, -19979, -19707, -19437, -19169, -18904, -18641, -18382, -18126, -17873, -17623,
+    -17375, -17130, -16886, -16643, -16401, -16159, -15916, -15672, -15427, -15180, -14930, -14678,
+    -14424, -14167, -13907, -13645, -13381, -13116, -12849, -12581, -12312, -12044, -11776, -11508,
+    -11243, -10978, -10716, -10456, -10198, -9942, -9689, -9438, -9188, -8940, -8693, -8447,
+    -8202, -7956, -7711, -7464, -7216, -6967, -6715, -6462, -6207, -5950, -5691, -5429,
+    -5166, -4902, -4637, -4370, -4104, -3837, -3571, -3305, -3041, -2778, -2516, -2257,
+    -2000, -1744, -1491, -1239, -989, -740, -493, -246, 0,
+    // triangle, level 5: harmonics 1..7
+    0, 236, 473, 710, 947, 1186, 1425, 1665, 1907, 2150, 2394, 2640,
+    2889, 3138, 3390, 3644, 3900, 4158, 4418, 4680, 4944, 5209, 5477, 5746,
+    6017, 6290, 6564, 6839, 7115, 7391, 7669, 7947, 8225, 8503, 8781, 9058,
+    9335, 9611, 9885, 10159, 10431, 10702, 10971, 11237, 11502, 11765, 12025, 12284,
+    12539, 12793, 13044, 13292, 13538, 13782, 14024, 14263, 14501, 14737, 14971, 15203,
+    15434, 15665, 15894, 16123, 16352, 16581, 16810, 17039, 17269, 17501, 17734, 17969,
+    18205, 18444, 18685, 18930, 19176, 19427, 19680, 19937, 20197, 20461, 20728, 20999,
+    21274, 21553, 21835, 22120, 22409, 22700, 22994, 23291, 23590, 23891, 24193, 24496,
+    24799, 25103, 25406, 25708, 26008, 26306, 26601, 26893, 27180, 27463, 27739, 28010,
+    28274, 28530, 28778, 29016, 29246, 29465, 29673, 29869, 30054, 30226, 30384, 30529,
+    30661, 30777, 30879, 30966, 31037, 31093, 31133, 31157, 31165, 31157, 31133, 31093,
+    31037, 30966, 30879, 30777, 30661, 30529, 30384, 30226, 30054, 29869, 29673, 29465,
+    29246, 29016, 28778, 28530, 28274, 28010, 27739, 27463, 27180, 26893, 26601, 26306,
+    26008, 25708, 25406, 25103, 24799, 24496, 24193, 23891, 23590, 23291, 22994, 22700,
+    22409, 22120, 21835, 21553, 21274, 20999, 20728, 20461, 20197, 19937, 19680, 19427,
+    19176, 18930, 18685, 18444, 18205, 17969, 17734, 17501, 17269, 17039, 16810, 16581,
+    16352, 16123, 15894, 15665, 15434, 15203, 14971, 14737, 14501, 14263, 14024, 13782,
+    13538, 13292, 13044, 12793, 12539, 12284, 12025, 11765, 11502, 11237, 10971, 10702,
+    10431, 10159, 9885, 9611, 9335, 9058, 8781, 8503, 8225, 7947, 7669, 7391,
+    7115, 6839, 6564, 6290, 6017, 5746, 5477, 5209, 4944, 4680, 4418, 4158,
+    3900, 3644, 3390, 3138, 2889, 2640, 2394, 2150, 1907, 1665, 1425, 1186,
+    947, 710, 473, 236, 0, -236, -473, -710, -947, -1186, -1425, -1665,
+    -1907, -2150, -2394, -2640, -2889, -3138, -3390, -3644, -3900, -4158, -4418, -4680,
+    -4944, -5209, -5477, -5746, -6017, -6290, -6564, -6839, -7115, -7391, -7669, -7947,
+    -8225, -8503, -8781, -9058, -9335, -9611, -9885, -10159, -10431, -10702, -10971, -11237,
+    -11502, -11765, -12025, -12284, -12539, -12793, -13044, -13292, -13538, -13782, -14024, -14263,
+    -14501, -14737, -14971, -15203, -15434, -15665, -15894, -16123, -16352, -16581, -16810, -17039,
+    -17269, -17501, -17734, -17969, -18205, -18444, -18685, -18930, -19176, -19427, -19680, -19937,
+    -20197, -20461, -20728, -20999, -21274, -21553, -21835, -22120, -22409, -22700, -22994, -23291,
+    -23590, -23891, -24193, -24496, -24799, -25103, -25406, -25708, -26008, -26306, -26601, -26893,
+    -27180, -27463, -27739, -28010, -28274, -28530, -28778, -29016, -29246, -29465, -29673, -29869,
+    -30054, -30226, -30384, -30529, -30661, -30777, -30879, -30966, -31037, -31093, -31133, -31157,
+    -31165, -31157, -31133, -31093, -31037, -30966, -30879, -30777, -30661, -30529, -30384, -30226,
+    -30054, -29869, -29673, -29465, -29246, -29016, -28778, -28530, -28274, -28010, -27739, -27463,
+    -27180, -26893, -26601, -26306, -26008, -25708, -25406, -25103, -24799, -24496, -24193, -23891,
+    -23590, -23291, -22994, -22700, -22409, -22120, -21835, -21553, -21274, -20999, -20728, -20461,
+    -20197, -19937, -19680, -19427, -19176, -18930, -18685, -18444, -18205, -17969, -17734, -17501,
+    -17269, -17039, -16810, -16581, -16352, -16123, -15894, -15665, -15434, -15203, -14971, -14737,
+    -14501, -14263, -14024, -13782, -13538, -13292, -13044, -12793, -12539, -12284, -12025, -11765,
+    -11502, -11237, -10971, -10702, -10431, -10159, -9885, -9611, -9335, -9058, -8781, -8503,
+    -8225, -7947, -7669, -7391, -7115, -6839, -6564, -6290, -6017, -5746, -5477, -5209,
+    -4944, -4680, -4418, -4158, -3900, -3644, -3390, -3138, -2889, -2640, -2394, -2150,
+    -1907, -1665, -1425, -1186, -947, -710, -473, -236, 0,
+    // triangle, level 6: harmonics 1..3
+    0, 218, 435, 653, 872, 1090, 1309, 1529, 1749, 1971, 2193, 2416,
+    2640, 2865, 3091, 3319, 3548, 3778, 4010, 4244, 4479, 4716, 4954, 5195,
+    5437, 5682, 5928, 6176, 6427, 6679, 6934, 7190, 7449, 7710, 7974, 8239,
+    8507, 8776, 9048, 9322, 9599, 9877, 10157, 10440, 10724, 11010, 11298, 11589,
+    11880, 12174, 12469, 12766, 13064, 13363, 13664, 13966, 14269, 14574, 14879, 15184,
+    15491, 15798, 16105, 16413, 16720, 17028, 17336, 17643, 17950, 18256, 18562, 18867,
+    19170, 19473, 19774, 20073, 20371, 20667, 20961, 21253, 21542, 21829, 22113, 22394,
+    22672, 22947, 23219, 23487, 23751, 24011, 24267, 24519, 24766, 25009, 25247, 25480,
+    25708, 25931, 26148, 26360, 26567, 26767, 26961, 27150, 27332, 27507, 27677, 27839,
+    27995, 28144, 28286, 28421, 28549, 28669, 28782, 28888, 28986, 29077, 29160, 29235,
+    29302, 29362, 29414, 29458, 29494, 29522, 29542, 29554, 29558, 29554, 29542, 29522,
+    29494, 29458, 29414, 29362, 29302, 29235, 29160, 29077, 28986, 28888, 28782, 28669,
+    28549, 28421, 28286, 28144, 27995, 27839, 27677, 27507, 27332, 27150, 26961, 26767,
+    26567, 26360, 26148, 25931, 25708, 25480, 25247, 25009, 24766, 24519, 24267, 24011,
+    23751, 23487, 23219, 22947, 22672, 22394, 22113, 21829, 21542, 21253, 20961, 20667,
+    20371, 20073, 19774, 19473, 19170, 18867, 18562, 18256, 17950, 17643, 17336, 17028,
+    16720, 16413, 16105, 15798, 15491, 15184, 14879, 14574, 14269, 13966, 13664, 13363,
+    13064, 12766, 12469, 12174, 11880, 11589, 11298, 11010, 10724, 10440, 10157, 9877,
+    9599, 9322, 9048, 8776, 8507, 8239, 7974, 7710, 7449, 7190, 6934, 6679,
+    6427, 6176, 5928, 5682, 5437, 5195, 4954, 4716, 4479, 4244, 4010, 3778,
+    3548, 3319, 3091, 2865, 2640, 2416, 2193, 1971, 1749, 1529, 1309, 1090,
+    872, 653, 435, 218, 0, -218, -435, -653, -872, -1090, -1309, -1529,
+    -1749, -1971, -2193, -2416, -2640, -2865, -3091, -3319, -3548, -3778, -4010, -4244,
+    -4479, -4716, -4954, -5195, -5437, -5682, -5928, -6176, -6427, -6679, -6934, -7190,
+    -7449, -7710, -7974, -8239, -8507, -8776, -9048, -9322, -9599, -9877, -10157, -10440,
+    -10724, -11010, -11298, -11589, -11880, -12174, -12469, -12766, -13064, -13363, -13664, -13966,
+    -14269, -14574, -14879, -15184, -15491, -15798, -16105, -16413, -16720, -17028, -17336, -17643,
+    -17950, -18256, -18562, -18867, -19170, -19473, -19774, -20073, -20371, -20667, -20961, -21253,
+    -21542, -21829, -22113, -22394, -22672, -22947, -23219, -23487, -23751, -24011, -24267, -24519,
+    -24766, -25009, -25247, -25480, -25708, -25931, -26148, -26360, -26567, -26767, -26961, -27150,
+    -27332, -27507, -27677, -27839, -27995, -28144, -28286, -28421, -28549, -28669, -28782, -28888,
+    -28986, -29077, -29160, -29235, -29302, -29362, -29414, -29458, -29494, -29522, -29542, -29554,
+    -29558, -29554, -29542, -29522, -29494, -29458, -29414, -29362, -29302, -29235, -29160, -29077,
+    -28986, -28888, -28782, -28669, -28549, -28421, -28286, -28144, -27995, -27839, -27677, -27507,
+    -27332, -27150, -26961, -26767, -26567, -26360, -26148, -25931, -25708, -25480, -25247, -25009,
+    -24766, -24519, -24267, -24011, -23751, -23487, -23219, -22947, -22672, -22394, -22113, -21829,
+    -21542, -21253, -20961, -20667, -20371, -20073, -19774, -19473, -19170, -18867, -18562, -18256,
+    -17950, -17643, -17336, -17028, -16720, -16413, -16105, -15798, -15491, -15184, -14879, -14574,
+    -14269, -13966, -13664, -13363, -13064, -12766, -12469, -12174, -11880, -11589, -11298, -11010,
+    -10724, -10440, -10157, -9877, -9599, -9322, -9048, -8776, -8507, -8239, -7974, -7710,
+    -7449, -7190, -6934, -6679, -6427, -6176, -5928, -5682, -5437, -5195, -4954, -4716,
+    -4479, -4244, -4010, -3778, -3548, -3319, -3091, -2865, -2640, -2416, -2193, -1971,
+    -1749, -1529, -1309, -1090, -872, -653, -435, -218, 0,
+    // triangle, level 7: harmonics 1..1
+    0, 326, 653, 979, 1305, 1631, 1957, 2282, 2607, 2932, 3256, 3580,
+    3903, 4226, 4548, 4869, 5190, 5510, 5829, 6147, 6464, 6780, 7095, 7409,
+    7722, 8034, 8345, 8654, 8962, 9269, 9574, 9878, 10180, 10481, 10780, 11078,
+    11374, 11668, 11961, 12251, 12540, 12827, 13112, 13395, 13676, 13955, 14232, 14507,
+    14779, 15050, 15318, 15583, 15847, 16108, 16366, 16623, 16876, 17127, 17376, 17622,
+    17865, 18105, 18343, 18578, 18810, 19040, 19266, 19490, 19711, 19929, 20143, 20355,
+    20564, 20769, 20972, 21171, 21367, 21560, 21749, 21936, 22119, 22298, 22475, 22648,
+    22817, 22983, 23146, 23305, 23461, 23613, 23762, 23907, 24048, 24186, 24320, 24450,
+    24577, 24700, 24820, 24935, 25047, 25155, 25259, 25360, 25457, 25549, 25638, 25724,
+    25805, 25882, 25956, 26025, 26091, 26153, 26210, 26264, 26314, 26360, 26402, 26440,
+    26474, 26504, 26530, 26552, 26570, 26584, 26594, 26600, 26602, 26600, 26594, 26584,
+    26570, 26552, 26530, 26504, 26474, 26440, 26402, 26360, 26314, 26264, 26210, 26153,
+    26091, 26025, 25956, 25882, 25805, 25724, 25638, 25549, 25457, 25360, 25259, 25155,
+    25047, 24935, 24820, 24700, 24577, 24450, 24320, 24186, 24048, 23907, 23762, 23613,
+    23461, 23305, 23146, 22983, 22817, 22648, 22475, 22298, 22119, 21936, 21749, 21560,
+    21367, 21171, 20972, 20769, 20564, 20355, 20143, 19929, 19711, 19490, 19266, 19040,
+    18810, 18578, 18343, 18105, 17865, 17622, 17376, 17127, 16876, 16623, 16366, 16108,
+    15847, 15583, 15318, 15050, 14779, 14507, 14232, 13955, 13676, 13395, 13112, 12827,
+    12540, 12251, 11961, 11668, 11374, 11078, 10780, 10481, 10180, 9878, 9574, 9269,
+    8962, 8654, 8345, 8034, 7722, 7409, 7095, 6780, 6464, 6147, 5829, 5510,
+    5190, 4869, 4548, 4226, 3903, 3580, 3256, 2932, 2607, 2282, 1957, 1631,
+    1305, 979, 653, 326, 0, -326, -653, -979, -1305, -1631, -1957, -2282,
+    -2607, -2932, -3256, -3580, -3903, -4226, -4548, -4869, -5190, -5510, -5829, -6147,
+    -6464, -6780, -7095, -7409, -7722, -8034, -8345, -8654, -8962, -9269, -9574, -9878,
+    -10180, -10481, -10780, -11078, -11374, -11668, -11961, -12251, -12540, -12827, -13112, -13395,
+    -13676, -13955, -14232, -14507, -14779, -15050, -15318, -15583, -15847, -16108, -16366, -16623,
+    -16876, -17127, -17376, -17622, -17865, -18105, -18343, -18578, -18810, -19040, -19266, -19490,
+    -19711, -19929, -20143, -20355, -20564, -20769, -20972, -21171, -21367, -21560, -21749, -21936,
+    -22119, -22298, -22475, -22648, -22817, -22983, -23146, -23305, -23461, -23613, -23762, -23907,
+    -24048, -24186, -24320, -24450, -24577, -24700, -24820, -24935, -25047, -25155, -25259, -25360,
+    -25457, -25549, -25638, -25724, -25805, -25882, -25956, -26025, -26091, -26153, -26210, -26264,
+    -26314, -26360, -26402, -26440, -26474, -26504, -26530, -26552, -26570, -26584, -26594, -26600,
+    -26602, -26600, -26594, -26584, -26570, -26552, -26530, -26504, -26474, -26440, -26402, -26360,
+    -26314, -26264, -26210, -26153, -26091, -26025, -25956, -25882, -25805, -25724, -25638, -25549,
+    -25457, -25360, -25259, -25155, -25047, -24935, -24820, -24700, -24577, -24450, -24320, -24186,
+    -24048, -23907, -23762, -23613, -23461, -23305, -23146, -22983, -22817, -22648, -22475, -22298,
+    -22119, -21936, -21749, -21560, -21367, -21171, -20972, -20769, -20564, -20355, -20143, -19929,
+    -19711, -19490, -19266, -19040, -18810, -18578, -18343, -18105, -17865, -17622, -17376, -17127,
+    -16876, -16623, -16366, -16108, -15847, -15583, -15318, -15050, -14779, -14507, -14232, -13955,
+    -13676, -13395, -13112, -12827, -12540, -12251, -11961, -11668, -11374, -11078, -10780, -10481,
+    -10180, -9878, -9574, -9269, -8962, -8654, -8345, -8034, -7722, -7409, -7095, -6780,
+    -6464, -6147, -5829, -5510, -5190, -4869, -4548, -4226, -3903, -3580, -3256, -2932,
+    -2607, -2282, -1957, -1631, -1305, -979, -653, -326, 0,
+    // sine, level 0: harmonics 1..1
+    0, 402, 804, 1206, 1608, 2009, 2410, 2811, 3212, 3612, 4011, 4410,
+    4808, 5205, 5602, 5998, 6393, 6786, 7179, 7571, 7962, 8351, 8739, 9126,
+    9512, 9896, 10278, 10659, 11039, 11417, 11793, 12167, 12539, 12910, 13279, 13645,
+    14010, 14372, 14732, 15090, 15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869,
+    18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475, 20787, 21096, 21403, 21705,
+    22005, 22301, 22594, 22884, 23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072,
+    25329, 25582, 25832, 26077, 26319, 26556, 26790, 27019, 27245, 27466, 27683, 27896,
+    28105, 28310, 28510, 28706, 28898, 29085, 29268, 29447, 29621, 29791, 29956, 30117,
+    30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237, 31356, 31470, 31580, 31685,
+    31785, 31880, 31971, 32057, 32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567,
+    32609, 32646, 32678, 32705, 32728, 32745, 32757, 32765, 32767, 32765, 32757, 32745,
+    32728, 32705, 32678, 32646, 32609, 32567, 32521, 32469, 32412, 32351, 32285, 32213,
+    32137, 32057, 31971, 31880, 31785, 31685, 31580, 31470, 31356, 31237, 31113, 30985,
+    30852, 30714, 30571, 30424, 30273, 30117, 29956, 29791, 29621, 29447, 29268, 29085,
+    28898, 28706, 28510, 28310, 28105, 27896, 27683, 27466, 27245, 27019, 26790, 26556,
+    26319, 26077, 25832, 25582, 25329, 25072, 24811, 24547, 24279, 24007, 23731, 23452,
+    23170, 22884, 22594, 22301, 22005, 21705, 21403, 21096, 20787, 20475, 20159, 19841,
+    19519, 19195, 18868, 18537, 18204, 17869, 17530, 17189, 16846, 16499, 16151, 15800,
+    15446, 15090, 14732, 14372, 14010, 13645, 13279, 12910, 12539, 12167, 11793, 11417,
+    11039, 10659, 10278, 9896, 9512, 9126, 8739, 8351, 7962, 7571, 7179, 6786,
+    6393, 5998, 5602, 5205, 4808, 4410, 4011, 3612, 3212, 2811, 2410, 2009,
+    1608, 1206, 804, 402, 0, -402, -804, -1206, -1608, -2009, -2410, -2811,
+    -3212, -3612, -4011, -4410, -4808, -5205, -5602, -5998, -6393, -6786, -7179, -7571,
+    -7962, -8351, -8739, -9126, -9512, -9896, -10278, -10659, -11039, -11417, -11793, -12167,
+    -12539, -12910, -13279, -13645, -14010, -14372, -14732, -15090, -15446, -15800, -16151, -16499,
+    -16846, -17189, -17530, -17869, -18204, -18537, -18868, -19195, -19519, -19841, -20159, -20475,
+    -20787, -21096, -21403, -21705, -22005, -22301, -22594, -22884, -23170, -23452, -23731, -24007,
+    -24279, -24547, -24811, -25072, -25329, -25582, -25832, -26077, -26319, -26556, -26790, -27019,
+    -27245, -27466, -27683, -27896, -28105, -28310, -28510, -28706, -28898, -29085, -29268, -29447,
+    -29621, -29791, -29956, -30117, -30273, -30424, -30571, -30714, -30852, -30985, -31113, -31237,
+    -31356, -31470, -31580, -31685, -31785, -31880, -31971, -32057, -32137, -32213, -32285, -32351,
+    -32412, -32469, -32521, -32567, -32609, -32646, -32678, -32705, -32728, -32745, -32757, -32765,
+    -32767, -32765, -32757, -32745, -32728, -32705, -32678, -32646, -32609, -32567, -32521, -32469,
+    -32412, -32351, -32285, -32213, -32137, -32057, -31971, -31880, -31785, -31685, -31580, -31470,
+    -31356, -31237, -31113, -30985, -30852, -30714, -30571, -30424, -30273, -30117, -29956, -29791,
+    -29621, -29447, -29268, -29085, -28898, -28706, -28510, -28310, -28105, -27896, -27683, -27466,
+    -27245, -27019, -26790, -26556, -26319, -26077, -25832, -25582, -25329, -25072, -24811, -24547,
+    -24279, -24007, -23731, -23452, -23170, -22884, -22594, -22301, -22005, -21705, -21403, -21096,
+    -20787, -20475, -20159, -19841, -19519, -19195, -18868, -18537, -18204, -17869, -17530, -17189,
+    -16846, -16499, -16151, -15800, -15446, -15090, -14732, -14372, -14010, -13645, -13279, -12910,
+    -12539, -12167, -11793, -11417, -11039, -10659, -10278, -9896, -9512, -9126, -8739, -8351,
+    -7962, -7571, -7179, -6786, -6393, -5998, -5602, -5205, -4808, -4410, -4011, -3612,
+    -3212, -2811, -2410, -2009, -1608, -1206, -804, -402, 0,
+};
+
+} // namespace daisybed
@@ -0,0 +1,147 @@
+#pragma once
+#ifndef DAISYBED_WAVETABLE_OSC_H
+#define DAISYBED_WAVETABLE_OSC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace daisybed
+{
+// Where one waveform's mip levels sit in kWavetableData: `levels` tables of
+// WavetableOsc::kTableSize + 1 samples each (the last repeats the first, so
+// the interpolating read never wraps), from `offset`.
+struct WavetableShape
+{
+    uint32_t offset;
+    uint32_t levels;
+};
+
+// Generated by host/src/wavetable-gen.cpp into shared/WavetableData.cpp,
+// which every build using WavetableOsc compiles in (see README).
+extern const int16_t        kWavetableData[];
+extern const WavetableShape kWavetableShapes[];
+
+// Band-limited wavetable oscillator over mip-mapped int16 tables in flash.
+//
+// Each waveform is stored as up to kMipLevels tables of kTableSize samples.
+// Level 0 holds the first kMaxHarmonics harmonics and every level above it
+// half as many as the one below, down to the fundamental alone. SetFreq()
+// picks the fullest level whose top harmonic, folded back at Nyquist, still
+// lands above kAudibleLimit, so aliasing stays inaudible without any
+// per-sample BLEP correction. Process() is a phase step and one linearly
+// interpolated table read, the same for any spectrum the generator is given.
+//
+// The level is chosen when the frequency is set, so once per block for a
+// caller that sets it at control rate; nothing crossfades between levels.
+//
+// The interface follows daisysp::Oscillator (Init, SetFreq, SetAmp,
+// SetWaveform, Process), including its default amplitude of 0.5, so it drops
+// into Voice and VoiceBank unchanged.
+class WavetableOsc
+{
+  public:
+    enum
+    {
+        WAVE_SAW,
+        WAVE_SQUARE,
+        WAVE_TRI,
+        WAVE_SIN,
+        WAVE_LAST,
+    };
+
+    static constexpr size_t kTableSize    = 512;
+    static constexpr int    kMipLevels    = 8;
+    static constexpr int    kMaxHarmonics = kTableSize / 2 - 1;
+    static constexpr float  kAudibleLimit = 20000.f;
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        phase_       = 0;
+        amp_         = 0.5f;
+        waveform_    = WAVE_SAW;
+        SetFreq(100.f);
+    }
+
+    inline void SetAmp(float amp) { amp_ = amp; }
+
+    void SetFreq(float freq)
+    {
+        // Below Nyquist, which also keeps the increment inside 32 bits.
+        float nyquist = 0.5f * sample_rate_;
+        freq_         = freq < 0.f ? 0.f : (freq > nyquist ? nyquist : freq);
+        increment_    = (uint32_t)(freq_ / sample_rate_ * 4294967296.f);
+        SelectTable();
+    }
+
+    void SetWaveform(uint8_t waveform)
+    {
+        waveform_ = waveform < WAVE_LAST ? waveform : (uint8_t)WAVE_SAW;
+        SelectTable();
+    }
+
+    inline void Reset() { phase_ = 0; }
+
+    // The mip level in use, 0 for the fullest.
+    inline int GetMipLevel() const { return level_; }
+
+    inline float Process()
+    {
+        uint32_t index = phase_ >> kFractionBits;
+        float    frac  = (float)(phase_ & kFractionMask) * kFractionScale;
+        float    a     = table_[index];
+        float    b     = table_[index + 1];
+        phase_ += increment_;
+        return (a + (b - a) * frac) * amp_ * kSampleScale;
+    }
+
+    // `size` samples of Process() into `out`.
+    void Process(float *out, size_t size)
+    {
+        for(size_t i = 0; i < size; i++)
+            out[i] = Process();
+    }
+
+  private:
+    // Phase is a 32-bit fraction of a cycle: the top bits index the table,
+    // the rest interpolate.
+    static constexpr int      kIndexBits     = 9;
+    static constexpr int      kFractionBits  = 32 - kIndexBits;
+    static constexpr uint32_t kFractionMask  = (1u << kFractionBits) - 1;
+    static constexpr float    kFractionScale = 1.f / (float)(1u << kFractionBits);
+    static constexpr float    kSampleScale   = 1.f / 32767.f;
+
+    static_assert((size_t)1 << kIndexBits == kTableSize,
+                  "WavetableOsc index bits must match the table size");
+
+    // An alias of harmonic h lands at sample_rate - h * freq, so every level
+    // whose top harmonic stays below sample_rate - kAudibleLimit is clean
+    // to the ear. Never lower than Nyquist.
+    void SelectTable()
+    {
+        const WavetableShape &shape = kWavetableShapes[waveform_];
+        float limit = sample_rate_ - kAudibleLimit;
+        if(limit < 0.5f * sample_rate_)
+            limit = 0.5f * sample_rate_;
+
+        int level = 0;
+        while(level < (int)shape.levels - 1
+              && (float)(kMaxHarmonics >> level) * freq_ > limit)
+            level++;
+        level_ = level;
+        table_ = kWavetableData + shape.offset + level * (kTableSize + 1);
+    }
+
+    float          sample_rate_;
+    float          freq_;
+    float          amp_;
+    uint32_t       phase_;
+    uint32_t       increment_;
+    uint8_t        waveform_;
+    int            level_;
+    const int16_t *table_;
+};
+
+} // namespace daisybed
+
+#endif // DAISYBED_WAVETABLE_OSC_H
@@ -28,3 +28,29 @@ set(DAISYSP_LIB DaisySP)
 # owns the target). Projects that need a .cpp from shared/ list it in their own
 # FIRMWARE_SOURCES.
 include_directories(${_DAISYBED_ROOT}/shared)
+
+# Per-region totals from the linker on every build, next to the compile-time
+# plan each firmware keeps in src/memory-plan.h (see shared/MemoryPlan.h).
+add_link_options(-Wl,--print-memory-usage)
+
+# Stream everything the audio callback consumes over USB for host replay
+# (see shared/TraceStream.h and host/src/replay.cpp):
+#   cmake -S projects/<name> -B build/<name> -DDAISYBED_TRACE=ON
+option(DAISYBED_TRACE "Capture a control trace over USB for host replay" OFF)
+if(DAISYBED_TRACE)
+    add_compile_definitions(DAISYBED_TRACE=1)
+endif()
+
+# Swap cinematic-verb's two pitch-shifters for a GrainCloud (see
+# shared/ShimmerVerb.h). Configure host/ the same way to replay its traces.
+option(DAISYBED_GRAIN_SHIMMER "Granular shimmer instead of two pitch-shifters" OFF)
+if(DAISYBED_GRAIN_SHIMMER)
+    add_compile_definitions(DAISYBED_GRAIN_SHIMMER=1)
+endif()
+
+# midi-test measures its own note-on to sound latency over a MIDI OUT -> IN
+# loopback cable and prints the statistics over USB (see shared/LatencyProbe.h).
+option(DAISYBED_LATENCY_TEST "Build midi-test's MIDI latency test mode" OFF)
+if(DAISYBED_LATENCY_TEST)
+    add_compile_definitions(DAISYBED_LATENCY_TEST=1)
+endif()
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <math.h>
+
 class Knob {
 public:
     Knob() = default;
@@ -24,6 +26,11 @@ public:
         return false;
     }
     float GetValue() const { return value; }
+    // Stored value from elsewhere (e.g. a preset); the knob has to catch it.
+    void SetValue(float newValue) {
+        value = newValue;
+        caught = false;
+    }
     void Reset() {
         caught = false;
     }
@@ -31,13 +38,11 @@ public:
 private:
     bool hasKnobCaught(float knobValue, float storedValue) {
         const float threshold = 0.02f;
-        return fabs(knobValue - storedValue) < threshold;
+        return fabsf(knobValue - storedValue) < threshold;
     }
     
     float value;
     float min;
     float max;
     bool caught;
-    float defaultValue;
-    float currentValue;
 };